@@ -0,0 +1,74 @@
+/*
+ * Copyright (c) 2020-2023 Gustavo Valiente gustavo.valiente@protonmail.com
+ * zlib License, see LICENSE file.
+ */
+
+#ifndef BN_HW_ADPCM_H
+#define BN_HW_ADPCM_H
+
+#include "bn_common.h"
+
+// 4-bit IMA ADPCM mono stream layout:
+//
+// Header: sample rate in Hz, samples count and samples per block (32 bits each).
+// Blocks: initial predictor (16 bits), initial step index (8 bits), padding (8 bits)
+// and one nibble per sample (low nibble first).
+
+namespace bn::hw::adpcm
+{
+    constexpr int header_size = 12;
+    constexpr int block_header_size = 4;
+
+    class stream
+    {
+
+    public:
+        const uint8_t* data;
+        const uint8_t* source;
+        int samples_per_block;
+        int block_samples_left;
+        int samples_left;
+        int predictor;
+        int step_index;
+        int output;
+        int volume;
+        unsigned position;
+        unsigned step;
+        uint8_t byte;
+        bool loop;
+    };
+
+    [[nodiscard]] inline int sample_rate(const uint8_t* data)
+    {
+        return int(reinterpret_cast<const unsigned*>(data)[0]);
+    }
+
+    [[nodiscard]] inline int samples_count(const uint8_t* data)
+    {
+        return int(reinterpret_cast<const unsigned*>(data)[1]);
+    }
+
+    [[nodiscard]] inline int samples_per_block(const uint8_t* data)
+    {
+        return int(reinterpret_cast<const unsigned*>(data)[2]);
+    }
+
+    inline void restart(stream& stream)
+    {
+        const uint8_t* data = stream.data;
+        stream.source = data + header_size;
+        stream.samples_per_block = samples_per_block(data);
+        stream.block_samples_left = 0;
+        stream.samples_left = samples_count(data);
+        stream.predictor = 0;
+        stream.step_index = 0;
+        stream.output = 0;
+        stream.position = 0;
+        stream.byte = 0;
+    }
+
+    // Returns false if the stream has finished:
+    BN_CODE_IWRAM bool mix(stream& stream, int8_t* left_output, int8_t* right_output, int samples);
+}
+
+#endif
@@ -93,6 +93,18 @@ namespace bn::hw::audio
         REG_SNDDSCNT = snddscnt;
     }
 
+    [[nodiscard]] bool adpcm_music_playing();
+
+    void play_adpcm_music(const uint8_t* data, int volume, bool loop);
+
+    void stop_adpcm_music();
+
+    void pause_adpcm_music();
+
+    void resume_adpcm_music();
+
+    void set_adpcm_music_volume(int volume);
+
     [[nodiscard]] inline bool sound_active(mm_sfxhand handle)
     {
         return mmEffectActive(handle);
@@ -129,6 +141,16 @@ namespace bn::hw::audio
         mmSetEffectsVolume(mm_word(volume));
     }
 
+    [[nodiscard]] int mixing_rate();
+
+    void set_mixing_rate(int mixing_rate);
+
+    [[nodiscard]] int max_channels();
+
+    void set_max_channels(int max_channels);
+
+    [[nodiscard]] int last_mixing_ticks();
+
     [[nodiscard]] bool update_on_vblank();
 
     void set_update_on_vblank(bool update_on_vblank);
@@ -149,6 +171,7 @@ namespace bn::hw::audio
         }
 
         stop_dmg_music();
+        stop_adpcm_music();
         stop_all_sounds();
     }
 }
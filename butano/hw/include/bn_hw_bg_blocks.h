@@ -6,19 +6,24 @@
 #ifndef BN_HW_BG_BLOCKS_H
 #define BN_HW_BG_BLOCKS_H
 
+#include "bn_hw_dma.h"
 #include "bn_hw_tonc.h"
 #include "bn_hw_bg_blocks_constants.h"
 
 extern "C"
 {
-    BN_CODE_IWRAM void bn_hw_bg_blocks_commit_half_words(
-            const uint16_t* source_data_ptr, unsigned half_words, uint16_t offset, uint16_t* destination_vram_ptr);
-
     BN_CODE_IWRAM void bn_hw_bg_blocks_commit_words(
             const unsigned* source_data_ptr, unsigned words, unsigned word_offset, unsigned* destination_vram_ptr);
 
     BN_CODE_IWRAM void bn_hw_bg_blocks_commit_blocks(
             const unsigned* source_data_ptr, unsigned blocks, unsigned word_offset, unsigned* destination_vram_ptr);
+
+    BN_CODE_IWRAM void bn_hw_bg_blocks_commit_unaligned_words(
+            const uint16_t* source_data_ptr, unsigned words, unsigned word_offset, unsigned* destination_vram_ptr);
+
+    BN_CODE_IWRAM void bn_hw_bg_blocks_commit_column(
+            const uint16_t* source_data_ptr, unsigned source_stride, unsigned half_words, uint16_t offset,
+            uint16_t* destination_vram_ptr);
 }
 
 namespace bn::hw::bg_blocks
@@ -58,6 +63,19 @@ namespace bn::hw::bg_blocks
         return reinterpret_cast<uint16_t*>(MEM_VRAM) + (block_index * half_words_per_block());
     }
 
+    inline void move_with_cpu(int source_block_index, int blocks_count, int destination_block_index)
+    {
+        __aeabi_memmove4(vram(destination_block_index), vram(source_block_index),
+                         size_t(blocks_count * half_words_per_block()) * 2);
+    }
+
+    inline void move_with_dma(int source_block_index, int blocks_count, int destination_block_index)
+    {
+        // Blocks are always moved to a lower address, so they can be copied in ascending order:
+        hw::dma::copy_words(vram(source_block_index), (blocks_count * half_words_per_block()) / 2,
+                            vram(destination_block_index));
+    }
+
     [[nodiscard]] inline uint16_t regular_map_cells_offset(unsigned tiles_offset, unsigned palette_offset)
     {
         return uint16_t((palette_offset << 12) + tiles_offset);
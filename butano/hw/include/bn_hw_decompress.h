@@ -7,28 +7,73 @@
 #define BN_HW_DECOMPRESS_H
 
 #include "bn_common.h"
-#include "../3rd_party/cult-of-gba-bios/include/cult-of-gba-bios.h"
+#include "bn_config_decompression.h"
 
-namespace bn::hw::decompress
+extern "C"
 {
-    inline void lz77(const void* src, void* dst)
-    {
-        swi_LZ77UnCompWrite16bit(src, dst);
-    }
+    BN_CODE_IWRAM void bn_hw_decompress_fast_lz(const void* source_ptr, void* destination_ptr);
+}
 
-    inline void rl_wram(const void* src, void* dst)
-    {
-        swi_RLUnCompReadNormalWrite8bit(src, dst);
-    }
+#if BN_CFG_DECOMPRESSION_BIOS_ENABLED
+    #include "bn_hw_tonc.h"
+#else
+    #include "../3rd_party/cult-of-gba-bios/include/cult-of-gba-bios.h"
 
-    inline void rl_vram(const void* src, void* dst)
+    extern "C"
     {
-        swi_RLUnCompReadNormalWrite16bit(src, dst);
+        BN_CODE_IWRAM void bn_hw_decompress_rl_wram(const void* source_ptr, void* destination_ptr);
+
+        BN_CODE_IWRAM void bn_hw_decompress_rl_vram(const void* source_ptr, void* destination_ptr);
     }
+#endif
+
+namespace bn::hw::decompress
+{
+    #if BN_CFG_DECOMPRESSION_BIOS_ENABLED
+        inline void lz77(const void* src, void* dst)
+        {
+            LZ77UnCompVram(src, dst);
+        }
+
+        inline void rl_wram(const void* src, void* dst)
+        {
+            RLUnCompWram(src, dst);
+        }
+
+        inline void rl_vram(const void* src, void* dst)
+        {
+            RLUnCompVram(src, dst);
+        }
+
+        inline void huff(const void* src, void* dst)
+        {
+            HuffUnComp(src, dst);
+        }
+    #else
+        inline void lz77(const void* src, void* dst)
+        {
+            swi_LZ77UnCompWrite16bit(src, dst);
+        }
+
+        inline void rl_wram(const void* src, void* dst)
+        {
+            bn_hw_decompress_rl_wram(src, dst);
+        }
+
+        inline void rl_vram(const void* src, void* dst)
+        {
+            bn_hw_decompress_rl_vram(src, dst);
+        }
+
+        inline void huff(const void* src, void* dst)
+        {
+            swi_HuffUnCompReadNormal(src, dst);
+        }
+    #endif
 
-    inline void huff(const void* src, void* dst)
+    inline void fast_lz(const void* src, void* dst)
     {
-        swi_HuffUnCompReadNormal(src, dst);
+        bn_hw_decompress_fast_lz(src, dst);
     }
 }
 
@@ -8,6 +8,7 @@
 
 #include "bn_point.h"
 #include "bn_hw_bgs.h"
+#include "bn_config_sprites.h"
 
 #define REG_DISPCNT_U16     *(u16*)(REG_BASE+0x0000)
 #define REG_DISPCNT_U16_2   *(u16*)(REG_BASE+0x0002)
@@ -46,6 +47,10 @@ namespace bn::hw::display
     {
         unsigned dispcnt = unsigned(mode) | DCNT_OBJ_1D;
 
+        #if BN_CFG_SPRITES_MULTIPLEXER_HANDLES
+            dispcnt |= unsigned(DCNT_OAM_HBL);
+        #endif
+
         if(show_sprites)
         {
             dispcnt |= unsigned(DCNT_OBJ);
@@ -48,6 +48,17 @@ namespace bn::hw::sprite_tiles
         hw::dma::copy_words(source_tiles_ptr, count * int(sizeof(tile) / 4), tile_vram(index));
     }
 
+    inline void move_with_cpu(int source_index, int count, int destination_index)
+    {
+        __aeabi_memmove4(tile_vram(destination_index), tile_vram(source_index), size_t(count) * sizeof(tile));
+    }
+
+    inline void move_with_dma(int source_index, int count, int destination_index)
+    {
+        // Tiles are always moved to a lower address, so they can be copied in ascending order:
+        hw::dma::copy_words(tile_vram(source_index), count * int(sizeof(tile) / 4), tile_vram(destination_index));
+    }
+
     BN_CODE_IWRAM void _plot_hideous_tiles(int width, const unsigned* srcD, int dstX0, unsigned* dstD);
 
     inline void plot_tiles(int width, const tile* source_tiles_ptr, int source_y, int destination_y,
@@ -188,6 +188,11 @@ namespace bn::hw::sprites
         BN_BFN_SET(sprite.attr1, int(shape_size.size()), ATTR1_SIZE);
     }
 
+    [[nodiscard]] inline int tiles_id(const handle_type& sprite)
+    {
+        return BN_BFN_GET(sprite.attr2, ATTR2_ID);
+    }
+
     inline void set_tiles(int tiles_id, handle_type& sprite)
     {
         BN_BFN_SET(sprite.attr2, tiles_id, ATTR2_ID);
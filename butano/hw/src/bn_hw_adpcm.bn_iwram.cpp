@@ -0,0 +1,155 @@
+/*
+ * Copyright (c) 2020-2023 Gustavo Valiente gustavo.valiente@protonmail.com
+ * zlib License, see LICENSE file.
+ */
+
+#include "../include/bn_hw_adpcm.h"
+
+#include "bn_array.h"
+#include "bn_algorithm.h"
+
+namespace bn::hw::adpcm
+{
+
+namespace
+{
+    constexpr int _steps_count = 89;
+
+    constexpr array<int, _steps_count> _steps = {
+        7, 8, 9, 10, 11, 12, 13, 14, 16, 17, 19, 21, 23, 25, 28, 31, 34, 37, 41, 45, 50, 55, 60, 66, 73, 80, 88, 97,
+        107, 118, 130, 143, 157, 173, 190, 209, 230, 253, 279, 307, 337, 371, 408, 449, 494, 544, 598, 658, 724, 796,
+        876, 963, 1060, 1166, 1282, 1411, 1552, 1707, 1878, 2066, 2272, 2499, 2749, 3024, 3327, 3660, 4026, 4428,
+        4871, 5358, 5894, 6484, 7132, 7845, 8630, 9493, 10442, 11487, 12635, 13899, 15289, 16818, 18500, 20350,
+        22385, 24623, 27086, 29794, 32767
+    };
+
+    // Each entry is the predictor difference (bits 11-31) and the next step index multiplied by 16 (bits 0-10)
+    // of a step index and nibble pair, so each sample is decoded with a single table lookup:
+    constexpr array<int, _steps_count * 16> _decode_table = []{
+        constexpr int index_adjusts[8] = { -1, -1, -1, -1, 2, 4, 6, 8 };
+        array<int, _steps_count * 16> result;
+
+        for(int step_index = 0; step_index < _steps_count; ++step_index)
+        {
+            int step = _steps[step_index];
+
+            for(int nibble = 0; nibble < 16; ++nibble)
+            {
+                int difference = step >> 3;
+
+                if(nibble & 4)
+                {
+                    difference += step;
+                }
+
+                if(nibble & 2)
+                {
+                    difference += step >> 1;
+                }
+
+                if(nibble & 1)
+                {
+                    difference += step >> 2;
+                }
+
+                if(nibble & 8)
+                {
+                    difference = -difference;
+                }
+
+                int next_step_index = bn::clamp(step_index + index_adjusts[nibble & 7], 0, _steps_count - 1);
+                result[(step_index * 16) + nibble] = (difference * 2048) + (next_step_index * 16);
+            }
+        }
+
+        return result;
+    }();
+}
+
+bool mix(stream& stream, int8_t* left_output, int8_t* right_output, int samples)
+{
+    const int* decode_table = _decode_table.data();
+    const uint8_t* source = stream.source;
+    int samples_per_block = stream.samples_per_block;
+    int block_samples_left = stream.block_samples_left;
+    int samples_left = stream.samples_left;
+    int predictor = stream.predictor;
+    int step_index = stream.step_index;
+    int output = stream.output;
+    int volume = stream.volume;
+    unsigned position = stream.position;
+    unsigned step = stream.step;
+    unsigned byte = stream.byte;
+    bool finished = false;
+
+    for(int index = 0; index < samples; ++index)
+    {
+        position += step;
+
+        // Streams sampled at the mixing rate or below decode at most one sample per output sample:
+        while(position >= 65536)
+        {
+            position -= 65536;
+
+            if(! samples_left)
+            {
+                if(! stream.loop)
+                {
+                    finished = true;
+                    break;
+                }
+
+                source = stream.data + header_size;
+                block_samples_left = 0;
+                samples_left = samples_count(stream.data);
+            }
+
+            if(! block_samples_left)
+            {
+                predictor = *reinterpret_cast<const int16_t*>(source);
+                step_index = source[2] * 16;
+                source += block_header_size;
+                block_samples_left = samples_per_block;
+            }
+
+            unsigned nibble;
+
+            if(block_samples_left & 1)
+            {
+                nibble = byte >> 4;
+            }
+            else
+            {
+                byte = *source++;
+                nibble = byte & 15;
+            }
+
+            int entry = decode_table[step_index + int(nibble)];
+            predictor = bn::clamp(predictor + (entry >> 11), -32768, 32767);
+            step_index = entry & 2047;
+            output = (predictor * volume) >> 16;
+            --block_samples_left;
+            --samples_left;
+        }
+
+        if(finished)
+        {
+            break;
+        }
+
+        left_output[index] = int8_t(bn::clamp(left_output[index] + output, -128, 127));
+        right_output[index] = int8_t(bn::clamp(right_output[index] + output, -128, 127));
+    }
+
+    stream.source = source;
+    stream.block_samples_left = block_samples_left;
+    stream.samples_left = samples_left;
+    stream.predictor = predictor;
+    stream.step_index = step_index;
+    stream.output = output;
+    stream.position = position;
+    stream.byte = uint8_t(byte);
+    return ! finished;
+}
+
+}
@@ -9,6 +9,8 @@
 #include "bn_config_audio.h"
 #include "../include/bn_hw_irq.h"
 #include "../include/bn_hw_link.h"
+#include "../include/bn_hw_adpcm.h"
+#include "../include/bn_hw_timer.h"
 #include "../3rd_party/vgm-player/include/vgm.h"
 
 extern "C"
@@ -18,6 +20,15 @@ extern "C"
 
 extern const uint8_t _bn_audio_soundbank_bin[];
 
+extern "C"
+{
+    // Maxmod active channels which can be allocated to new notes and sound effects:
+    extern mm_word mm_ch_mask;
+
+    // Maxmod output buffer length (right channel output is mm_mixlen * 2 bytes after the left one):
+    extern mm_word mm_mixlen;
+}
+
 namespace bn::core
 {
     void on_vblank();
@@ -38,6 +49,7 @@ namespace
     public:
         mm_sfxhand handle;
         int16_t priority;
+        uint8_t volume;
     };
 
 
@@ -46,14 +58,20 @@ namespace
 
     public:
         forward_list<sound_type, BN_CFG_AUDIO_MAX_SOUND_CHANNELS> sounds_queue;
+        adpcm::stream adpcm_music;
         #if BN_CFG_ASSERT_ENABLED
             unsigned vgm_offset_play = 0;
         #endif
+        int mixing_rate = BN_CFG_AUDIO_MIXING_RATE;
+        int max_channels = 0;
+        int last_mixing_ticks = 0;
         uint16_t direct_sound_control_value = 0;
         uint16_t dmg_control_value = 0;
         bn::dmg_music_type dmg_music_type = dmg_music_type::GBT_PLAYER;
         bool music_paused = false;
         bool dmg_music_paused = false;
+        bool adpcm_music_active = false;
+        bool adpcm_music_paused = false;
         bool update_on_vblank = false;
         bool delay_commit = true;
         #if BN_CFG_ASSERT_ENABLED
@@ -64,9 +82,9 @@ namespace
     BN_DATA_EWRAM_BSS static_data data;
 
 
-    constexpr int _mix_length()
+    constexpr int _mix_length(int mixing_rate)
     {
-        switch(BN_CFG_AUDIO_MIXING_RATE)
+        switch(mixing_rate)
         {
 
         case BN_AUDIO_MIXING_RATE_8_KHZ:
@@ -94,28 +112,96 @@ namespace
             return MM_MIXLEN_31KHZ;
 
         default:
-            BN_ERROR("Invalid maxing rate: ", BN_CFG_AUDIO_MIXING_RATE);
+            BN_ERROR("Invalid mixing rate: ", mixing_rate);
+            return 0;
+        }
+    }
+
+    constexpr int _mixing_frequency(int mixing_rate)
+    {
+        switch(mixing_rate)
+        {
+
+        case BN_AUDIO_MIXING_RATE_8_KHZ:
+            return BN_AUDIO_MIXING_RATE_8_KHZ_FREQUENCY;
+
+        case BN_AUDIO_MIXING_RATE_10_KHZ:
+            return BN_AUDIO_MIXING_RATE_10_KHZ_FREQUENCY;
+
+        case BN_AUDIO_MIXING_RATE_13_KHZ:
+            return BN_AUDIO_MIXING_RATE_13_KHZ_FREQUENCY;
+
+        case BN_AUDIO_MIXING_RATE_16_KHZ:
+            return BN_AUDIO_MIXING_RATE_16_KHZ_FREQUENCY;
+
+        case BN_AUDIO_MIXING_RATE_18_KHZ:
+            return BN_AUDIO_MIXING_RATE_18_KHZ_FREQUENCY;
+
+        case BN_AUDIO_MIXING_RATE_21_KHZ:
+            return BN_AUDIO_MIXING_RATE_21_KHZ_FREQUENCY;
+
+        case BN_AUDIO_MIXING_RATE_27_KHZ:
+            return BN_AUDIO_MIXING_RATE_27_KHZ_FREQUENCY;
+
+        case BN_AUDIO_MIXING_RATE_31_KHZ:
+            return BN_AUDIO_MIXING_RATE_31_KHZ_FREQUENCY;
+
+        default:
+            BN_ERROR("Invalid mixing rate: ", mixing_rate);
+            return 0;
         }
     }
 
     constexpr int _max_channels = BN_CFG_AUDIO_MAX_MUSIC_CHANNELS + BN_CFG_AUDIO_MAX_SOUND_CHANNELS;
 
+    // Buffers are allocated for the highest mixing rate, so lower ones can be set at runtime:
     alignas(int) BN_DATA_EWRAM_BSS uint8_t maxmod_engine_buffer[
-            _max_channels * (MM_SIZEOF_MODCH + MM_SIZEOF_ACTCH + MM_SIZEOF_MIXCH) + _mix_length()];
+            _max_channels * (MM_SIZEOF_MODCH + MM_SIZEOF_ACTCH + MM_SIZEOF_MIXCH) +
+            _mix_length(BN_CFG_AUDIO_MIXING_RATE)];
 
-    alignas(int) uint8_t maxmod_mixing_buffer[_mix_length()];
+    alignas(int) uint8_t maxmod_mixing_buffer[_mix_length(BN_CFG_AUDIO_MIXING_RATE)];
 
 
-    void _check_sounds_queue()
+    [[nodiscard]] bool _check_sounds_queue(int priority, int volume)
     {
-        if(data.sounds_queue.full())
+        if(! data.sounds_queue.full())
+        {
+            return true;
+        }
+
+        // Sounds queue is sorted by priority, so the stolen sound is the quietest of the first ones:
+        auto before_it = data.sounds_queue.before_begin();
+        auto it = data.sounds_queue.begin();
+        auto end = data.sounds_queue.end();
+        auto stolen_before_it = before_it;
+        int lowest_priority = it->priority;
+        int lowest_volume = it->volume;
+
+        while(it != end && it->priority == lowest_priority)
         {
-            mmEffectRelease(data.sounds_queue.front().handle);
-            data.sounds_queue.pop_front();
+            if(it->volume < lowest_volume)
+            {
+                stolen_before_it = before_it;
+                lowest_volume = it->volume;
+            }
+
+            before_it = it;
+            ++it;
         }
+
+        if(priority < lowest_priority || (priority == lowest_priority && volume < lowest_volume))
+        {
+            return false;
+        }
+
+        auto stolen_it = stolen_before_it;
+        ++stolen_it;
+        mmEffectRelease(stolen_it->handle);
+        data.sounds_queue.erase_after(stolen_before_it);
+        return true;
     }
 
-    void _add_sound_to_queue(int priority, mm_sfxhand handle)
+    void _add_sound_to_queue(int priority, int volume, mm_sfxhand handle)
     {
         auto before_it = data.sounds_queue.before_begin();
         auto it = data.sounds_queue.begin();
@@ -136,7 +222,7 @@ namespace
             }
         }
 
-        data.sounds_queue.insert_after(before_it, sound_type{ handle, int16_t(priority) });
+        data.sounds_queue.insert_after(before_it, sound_type{ handle, int16_t(priority), uint8_t(volume) });
     }
 
     void _erase_sound_from_queue(mm_sfxhand handle)
@@ -148,22 +234,51 @@ namespace
         while(it != end)
         {
             if(it->handle == handle)
-            {
-                before_it = it;
-                ++it;
-            }
-            else
             {
                 data.sounds_queue.erase_after(before_it);
                 return;
             }
+
+            before_it = it;
+            ++it;
+        }
+    }
+
+    [[nodiscard]] unsigned _adpcm_music_step()
+    {
+        int sample_rate = adpcm::sample_rate(data.adpcm_music.data);
+        return (unsigned(sample_rate) << 16) / unsigned(_mixing_frequency(data.mixing_rate));
+    }
+
+    void _mix_adpcm_music(int8_t* left_output)
+    {
+        // Maxmod owns both Direct Sound channels, so the stream is mixed into its output buffer:
+        int samples = int(reinterpret_cast<int8_t*>(mp_writepos) - left_output);
+
+        if(samples > 0)
+        {
+            int8_t* right_output = left_output + (mm_mixlen * 2);
+
+            if(! adpcm::mix(data.adpcm_music, left_output, right_output, samples))
+            {
+                data.adpcm_music_active = false;
+            }
         }
     }
 
     void _commit()
     {
+        unsigned mixing_start_ticks = timer::ticks();
+        auto left_output = reinterpret_cast<int8_t*>(mp_writepos);
         mmFrame();
 
+        if(data.adpcm_music_active && ! data.adpcm_music_paused)
+        {
+            _mix_adpcm_music(left_output);
+        }
+
+        data.last_mixing_ticks = int(timer::ticks() - mixing_start_ticks);
+
         if(data.dmg_music_type == dmg_music_type::GBT_PLAYER)
         {
             gbt_update();
@@ -193,6 +308,26 @@ namespace
 
         hw::link::commit();
     }
+
+    void _init_maxmod()
+    {
+        mm_gba_system maxmod_info;
+        maxmod_info.mixing_mode = mm_mixmode(data.mixing_rate);
+        maxmod_info.mod_channel_count = _max_channels;
+        maxmod_info.mix_channel_count = _max_channels;
+        maxmod_info.module_channels = mm_addr(maxmod_engine_buffer);
+        maxmod_info.active_channels = mm_addr(maxmod_engine_buffer + (_max_channels * MM_SIZEOF_MODCH));
+        maxmod_info.mixing_channels = mm_addr(maxmod_engine_buffer +
+                (_max_channels * (MM_SIZEOF_MODCH + MM_SIZEOF_ACTCH)));
+        maxmod_info.mixing_memory = mm_addr(maxmod_mixing_buffer);
+        maxmod_info.wave_memory = mm_addr(maxmod_engine_buffer +
+                (_max_channels * (MM_SIZEOF_MODCH + MM_SIZEOF_ACTCH + MM_SIZEOF_MIXCH)));
+        maxmod_info.soundbank = mm_addr(_bn_audio_soundbank_bin);
+        mmInit(&maxmod_info);
+
+        mmSetVBlankHandler(reinterpret_cast<void*>(_vblank_handler));
+        set_max_channels(data.max_channels);
+    }
 }
 
 void init()
@@ -202,21 +337,8 @@ void init()
     irq::set_isr(irq::id::VBLANK, mmVBlank);
     irq::enable(irq::id::VBLANK);
 
-    mm_gba_system maxmod_info;
-    maxmod_info.mixing_mode = mm_mixmode(BN_CFG_AUDIO_MIXING_RATE);
-    maxmod_info.mod_channel_count = _max_channels;
-    maxmod_info.mix_channel_count = _max_channels;
-    maxmod_info.module_channels = mm_addr(maxmod_engine_buffer);
-    maxmod_info.active_channels = mm_addr(maxmod_engine_buffer + (_max_channels * MM_SIZEOF_MODCH));
-    maxmod_info.mixing_channels = mm_addr(maxmod_engine_buffer +
-            (_max_channels * (MM_SIZEOF_MODCH + MM_SIZEOF_ACTCH)));
-    maxmod_info.mixing_memory = mm_addr(maxmod_mixing_buffer);
-    maxmod_info.wave_memory = mm_addr(maxmod_engine_buffer +
-            (_max_channels * (MM_SIZEOF_MODCH + MM_SIZEOF_ACTCH + MM_SIZEOF_MIXCH)));
-    maxmod_info.soundbank = mm_addr(_bn_audio_soundbank_bin);
-    mmInit(&maxmod_info);
-
-    mmSetVBlankHandler(reinterpret_cast<void*>(_vblank_handler));
+    data.max_channels = _max_channels;
+    _init_maxmod();
 }
 
 void enable()
@@ -390,10 +512,15 @@ void set_dmg_music_volume(int left_volume, int right_volume)
 
 mm_sfxhand play_sound(int priority, int id)
 {
-    _check_sounds_queue();
+    constexpr int volume = 255;
+
+    if(! _check_sounds_queue(priority, volume))
+    {
+        return 0;
+    }
 
     mm_sfxhand handle = mmEffect(mm_word(id));
-    _add_sound_to_queue(priority, handle);
+    _add_sound_to_queue(priority, volume, handle);
     return handle;
 }
 
@@ -405,10 +532,14 @@ mm_sfxhand play_sound(int priority, int id, int volume, int speed, int panning)
     sound_effect.handle = 0;
     sound_effect.volume = mm_byte(volume);
     sound_effect.panning = mm_byte(panning);
-    _check_sounds_queue();
+
+    if(! _check_sounds_queue(priority, volume))
+    {
+        return 0;
+    }
 
     mm_sfxhand handle = mmEffectEx(&sound_effect);
-    _add_sound_to_queue(priority, handle);
+    _add_sound_to_queue(priority, volume, handle);
     return handle;
 }
 
@@ -436,6 +567,88 @@ void stop_all_sounds()
     data.sounds_queue.clear();
 }
 
+bool adpcm_music_playing()
+{
+    return data.adpcm_music_active;
+}
+
+void play_adpcm_music(const uint8_t* data_ptr, int volume, bool loop)
+{
+    // The stream is not mixed while it is being set up:
+    data.adpcm_music_active = false;
+    BN_BARRIER;
+
+    adpcm::stream& adpcm_music = data.adpcm_music;
+    adpcm_music.data = data_ptr;
+    adpcm_music.volume = volume;
+    adpcm_music.loop = loop;
+    adpcm::restart(adpcm_music);
+    adpcm_music.step = _adpcm_music_step();
+    data.adpcm_music_paused = false;
+
+    BN_BARRIER;
+    data.adpcm_music_active = true;
+}
+
+void stop_adpcm_music()
+{
+    data.adpcm_music_active = false;
+    data.adpcm_music_paused = false;
+}
+
+void pause_adpcm_music()
+{
+    data.adpcm_music_paused = true;
+}
+
+void resume_adpcm_music()
+{
+    data.adpcm_music_paused = false;
+}
+
+void set_adpcm_music_volume(int volume)
+{
+    data.adpcm_music.volume = volume;
+}
+
+int mixing_rate()
+{
+    return data.mixing_rate;
+}
+
+void set_mixing_rate(int mixing_rate)
+{
+    // V-Blank interrupt is disabled until maxmod is ready again:
+    irq::disable(irq::id::VBLANK);
+    mmEffectCancelAll();
+    data.sounds_queue.clear();
+    data.mixing_rate = mixing_rate;
+    _init_maxmod();
+
+    if(data.adpcm_music_active)
+    {
+        data.adpcm_music.step = _adpcm_music_step();
+    }
+
+    irq::enable(irq::id::VBLANK);
+}
+
+int max_channels()
+{
+    return data.max_channels;
+}
+
+void set_max_channels(int max_channels)
+{
+    data.max_channels = max_channels;
+    mm_ch_mask = max_channels >= 32 ? mm_word(-1) : (mm_word(1) << max_channels) - 1;
+}
+
+int last_mixing_ticks()
+{
+    return data.last_mixing_ticks;
+}
+
 bool update_on_vblank()
 {
     return data.update_on_vblank;
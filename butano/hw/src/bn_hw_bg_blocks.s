@@ -3,33 +3,6 @@
  * zlib License, see LICENSE file.
  */
 
-/*
-    void bn_hw_bg_blocks_commit_half_words(
-            const uint16_t* source_data_ptr, unsigned half_words, uint16_t offset, uint16_t* destination_vram_ptr)
-    {
-        for(unsigned index = 0; index < half_words; ++index)
-        {
-            destination_vram_ptr[index] = source_data_ptr[index] + offset;
-        }
-    }
-*/
-    .section .iwram, "ax", %progbits
-    .align 2
-    .arm
-    .global bn_hw_bg_blocks_commit_half_words
-    .type bn_hw_bg_blocks_commit_half_words, STT_FUNC
-bn_hw_bg_blocks_commit_half_words:
-
-.half_words_loop:
-    ldrh    r12, [r0], #2
-    add     r12, r2, r12
-    strh    r12, [r3], #2
-    subs    r1, #1
-    bne     .half_words_loop
-
-    bx      lr
-
-
 /*
     void bn_hw_bg_blocks_commit_words(
             const unsigned* source_data_ptr, unsigned words, unsigned word_offset, unsigned* destination_vram_ptr)
@@ -99,3 +72,106 @@ bn_hw_bg_blocks_commit_blocks:
 
     pop     {r4-r10}
     bx      lr
+
+
+/*
+    void bn_hw_bg_blocks_commit_unaligned_words(
+            const uint16_t* source_data_ptr, unsigned words, unsigned word_offset, unsigned* destination_vram_ptr)
+    {
+        // source_data_ptr is not word aligned:
+        for(unsigned index = 0; index < words; ++index)
+        {
+            unsigned low = source_data_ptr[index * 2];
+            unsigned high = source_data_ptr[(index * 2) + 1];
+            destination_vram_ptr[index] = (low | (high << 16)) + word_offset;
+        }
+    }
+*/
+    .section .iwram, "ax", %progbits
+    .align 2
+    .arm
+    .global bn_hw_bg_blocks_commit_unaligned_words
+    .type bn_hw_bg_blocks_commit_unaligned_words, STT_FUNC
+bn_hw_bg_blocks_commit_unaligned_words:
+    push    {r4-r11}
+
+    @ r12 stores the pending low half word, r0 is word aligned after loading it:
+    ldrh    r12, [r0], #2
+
+    @ Last word is committed apart to avoid reading past the end of the source data:
+    subs    r1, #1
+    beq     .unaligned_last_word
+
+.unaligned_blocks_loop:
+    cmp     r1, #4
+    blo     .unaligned_words_loop
+
+    ldmia   r0!, {r4-r7}
+    orr     r8, r12, r4, lsl #16
+    mov     r4, r4, lsr #16
+    orr     r9, r4, r5, lsl #16
+    mov     r5, r5, lsr #16
+    orr     r10, r5, r6, lsl #16
+    mov     r6, r6, lsr #16
+    orr     r11, r6, r7, lsl #16
+    mov     r12, r7, lsr #16
+    add     r8, r8, r2
+    add     r9, r9, r2
+    add     r10, r10, r2
+    add     r11, r11, r2
+    stmia   r3!, {r8-r11}
+
+    subs    r1, #4
+    bne     .unaligned_blocks_loop
+    b       .unaligned_last_word
+
+.unaligned_words_loop:
+    ldr     r4, [r0], #4
+    orr     r8, r12, r4, lsl #16
+    mov     r12, r4, lsr #16
+    add     r8, r8, r2
+    str     r8, [r3], #4
+    subs    r1, #1
+    bne     .unaligned_words_loop
+
+.unaligned_last_word:
+    ldrh    r4, [r0]
+    orr     r8, r12, r4, lsl #16
+    add     r8, r8, r2
+    str     r8, [r3]
+
+    pop     {r4-r11}
+    bx      lr
+
+
+/*
+    void bn_hw_bg_blocks_commit_column(
+            const uint16_t* source_data_ptr, unsigned source_stride, unsigned half_words, uint16_t offset,
+            uint16_t* destination_vram_ptr)
+    {
+        // source_stride is in bytes, destination rows are 32 half words wide:
+        for(unsigned index = 0; index < half_words; ++index)
+        {
+            destination_vram_ptr[index * 32] = *source_data_ptr + offset;
+            source_data_ptr += source_stride / 2;
+        }
+    }
+*/
+    .section .iwram, "ax", %progbits
+    .align 2
+    .arm
+    .global bn_hw_bg_blocks_commit_column
+    .type bn_hw_bg_blocks_commit_column, STT_FUNC
+bn_hw_bg_blocks_commit_column:
+    ldr     r12, [sp]
+    push    {r4}
+
+.column_loop:
+    ldrh    r4, [r0], r1
+    add     r4, r4, r3
+    strh    r4, [r12], #64
+    subs    r2, #1
+    bne     .column_loop
+
+    pop     {r4}
+    bx      lr
@@ -0,0 +1,379 @@
+/*
+ * Copyright (c) 2020-2023 Gustavo Valiente gustavo.valiente@protonmail.com
+ * zlib License, see LICENSE file.
+ */
+
+/*
+    void bn_hw_decompress_rl_wram(const void* source_ptr, void* destination_ptr)
+    {
+        const uint8_t* source = static_cast<const uint8_t*>(source_ptr) + 4;
+        uint8_t* destination = static_cast<uint8_t*>(destination_ptr);
+        int remaining_bytes = *static_cast<const unsigned*>(source_ptr) >> 8;
+
+        while(remaining_bytes > 0)
+        {
+            unsigned flag = *source++;
+
+            if(flag & 0x80)
+            {
+                // Runs are written with word stores once the destination is word aligned:
+                int count = (flag & 0x7F) + 3;
+                remaining_bytes -= count;
+                memset(destination, *source++, count);
+                destination += count;
+            }
+            else
+            {
+                int count = (flag & 0x7F) + 1;
+                remaining_bytes -= count;
+                memcpy(destination, source, count);
+                source += count;
+                destination += count;
+            }
+        }
+    }
+*/
+    .section .iwram, "ax", %progbits
+    .align 2
+    .arm
+    .global bn_hw_decompress_rl_wram
+    .type bn_hw_decompress_rl_wram, STT_FUNC
+bn_hw_decompress_rl_wram:
+    push    {r4}
+
+    ldr     r2, [r0], #4
+    lsrs    r2, r2, #8
+    beq     .rl_wram_done
+
+.rl_wram_block:
+    @ Both block types have at least one data byte:
+    ldrb    r3, [r0], #1
+    tst     r3, #0x80
+    and     r3, r3, #0x7F
+    ldrb    r4, [r0], #1
+    bne     .rl_wram_run
+
+    add     r3, r3, #1
+    sub     r2, r2, r3
+
+.rl_wram_literal_loop:
+    strb    r4, [r1], #1
+    subs    r3, r3, #1
+    ldrneb  r4, [r0], #1
+    bne     .rl_wram_literal_loop
+
+    b       .rl_wram_next
+
+.rl_wram_run:
+    add     r3, r3, #3
+    sub     r2, r2, r3
+    orr     r4, r4, r4, lsl #8
+    orr     r4, r4, r4, lsl #16
+
+.rl_wram_run_align_loop:
+    tst     r1, #3
+    beq     .rl_wram_run_aligned
+    strb    r4, [r1], #1
+    subs    r3, r3, #1
+    bne     .rl_wram_run_align_loop
+
+    b       .rl_wram_next
+
+.rl_wram_run_aligned:
+    subs    r3, r3, #4
+    blt     .rl_wram_run_tail
+
+.rl_wram_run_words_loop:
+    str     r4, [r1], #4
+    subs    r3, r3, #4
+    bge     .rl_wram_run_words_loop
+
+.rl_wram_run_tail:
+    adds    r3, r3, #4
+    beq     .rl_wram_next
+
+.rl_wram_run_tail_loop:
+    strb    r4, [r1], #1
+    subs    r3, r3, #1
+    bne     .rl_wram_run_tail_loop
+
+.rl_wram_next:
+    cmp     r2, #0
+    bgt     .rl_wram_block
+
+.rl_wram_done:
+    pop     {r4}
+    bx      lr
+
+
+/*
+    Same as bn_hw_decompress_rl_wram, but destination is written with 16-bit and 32-bit stores only,
+    so it can be used to decompress to VRAM. Destination must be 16-bit aligned.
+
+    As with the BIOS routine, the last byte is not written if the decompressed size is odd.
+*/
+    .section .iwram, "ax", %progbits
+    .align 2
+    .arm
+    .global bn_hw_decompress_rl_vram
+    .type bn_hw_decompress_rl_vram, STT_FUNC
+bn_hw_decompress_rl_vram:
+    push    {r4-r6}
+
+    ldr     r2, [r0], #4
+    lsrs    r2, r2, #8
+    beq     .rl_vram_done
+
+    @ r5: 1 if there's a pending byte in r6, otherwise 0.
+    mov     r5, #0
+
+.rl_vram_block:
+    @ Both block types have at least one data byte:
+    ldrb    r3, [r0], #1
+    tst     r3, #0x80
+    and     r3, r3, #0x7F
+    ldrb    r4, [r0], #1
+    bne     .rl_vram_run
+
+    add     r3, r3, #1
+    sub     r2, r2, r3
+    cmp     r5, #0
+    beq     .rl_vram_literal_pairs
+
+    orr     r6, r6, r4, lsl #8
+    strh    r6, [r1], #2
+    mov     r5, #0
+    subs    r3, r3, #1
+    beq     .rl_vram_next
+    ldrb    r4, [r0], #1
+
+.rl_vram_literal_pairs:
+    @ r4: next byte, r3: remaining bytes including r4.
+    subs    r3, r3, #2
+    blt     .rl_vram_pending_byte
+
+.rl_vram_literal_loop:
+    ldrb    r12, [r0], #1
+    orr     r12, r4, r12, lsl #8
+    strh    r12, [r1], #2
+    beq     .rl_vram_next
+    ldrb    r4, [r0], #1
+    subs    r3, r3, #2
+    bge     .rl_vram_literal_loop
+
+    b       .rl_vram_pending_byte
+
+.rl_vram_run:
+    add     r3, r3, #3
+    sub     r2, r2, r3
+    cmp     r5, #0
+    beq     .rl_vram_run_fill
+
+    orr     r6, r6, r4, lsl #8
+    strh    r6, [r1], #2
+    mov     r5, #0
+    sub     r3, r3, #1
+
+.rl_vram_run_fill:
+    orr     r4, r4, r4, lsl #8
+    orr     r4, r4, r4, lsl #16
+    tst     r1, #2
+    beq     .rl_vram_run_aligned
+    strh    r4, [r1], #2
+    sub     r3, r3, #2
+
+.rl_vram_run_aligned:
+    subs    r3, r3, #4
+    blt     .rl_vram_run_tail
+
+.rl_vram_run_words_loop:
+    str     r4, [r1], #4
+    subs    r3, r3, #4
+    bge     .rl_vram_run_words_loop
+
+.rl_vram_run_tail:
+    tst     r3, #2
+    strneh  r4, [r1], #2
+    tst     r3, #1
+    beq     .rl_vram_next
+
+.rl_vram_pending_byte:
+    and     r6, r4, #0xFF
+    mov     r5, #1
+
+.rl_vram_next:
+    cmp     r2, #0
+    bgt     .rl_vram_block
+
+.rl_vram_done:
+    pop     {r4-r6}
+    bx      lr
+
+
+/*
+    void bn_hw_decompress_fast_lz(const void* source_ptr, void* destination_ptr)
+    {
+        const uint16_t* source = static_cast<const uint16_t*>(source_ptr) + 2;
+        uint16_t* destination = static_cast<uint16_t*>(destination_ptr);
+        uint16_t* destination_end = destination + (*static_cast<const unsigned*>(source_ptr) >> 9);
+
+        while(destination < destination_end)
+        {
+            unsigned token = *source++;
+            unsigned literals_count = token & 0xFF;
+
+            if(literals_count == 0xFF)
+            {
+                literals_count += *source++;
+            }
+
+            // Literals and matches are copied with word loads and stores when possible:
+            memcpy(destination, source, literals_count * 2);
+            source += literals_count;
+            destination += literals_count;
+
+            if(destination >= destination_end)
+            {
+                break;
+            }
+
+            const uint16_t* match = destination - *source++;
+            unsigned match_length = token >> 8;
+
+            if(match_length == 0xFF)
+            {
+                match_length += *source++;
+            }
+
+            match_length += 3;
+
+            while(match_length--)
+            {
+                *destination++ = *match++;
+            }
+        }
+    }
+*/
+    .section .iwram, "ax", %progbits
+    .align 2
+    .arm
+    .global bn_hw_decompress_fast_lz
+    .type bn_hw_decompress_fast_lz, STT_FUNC
+bn_hw_decompress_fast_lz:
+    push    {r4-r7}
+
+    ldr     r2, [r0], #4
+    lsrs    r2, r2, #8
+    beq     .fast_lz_done
+
+    @ r2: destination end.
+    add     r2, r1, r2
+
+.fast_lz_sequence:
+    ldrh    r3, [r0], #2
+    ands    r12, r3, #0xFF
+    beq     .fast_lz_match
+    cmp     r12, #0xFF
+    ldreqh  r4, [r0], #2
+    addeq   r12, r12, r4
+
+    @ Words can be copied only if source and destination have the same alignment:
+    eor     r4, r0, r1
+    tst     r4, #2
+    bne     .fast_lz_literals_half_words_loop
+
+    tst     r1, #2
+    beq     .fast_lz_literals_aligned
+    ldrh    r4, [r0], #2
+    strh    r4, [r1], #2
+    subs    r12, r12, #1
+    beq     .fast_lz_literals_end
+
+.fast_lz_literals_aligned:
+    subs    r12, r12, #8
+    blt     .fast_lz_literals_words
+
+.fast_lz_literals_blocks_loop:
+    ldmia   r0!, {r4-r7}
+    stmia   r1!, {r4-r7}
+    subs    r12, r12, #8
+    bge     .fast_lz_literals_blocks_loop
+
+.fast_lz_literals_words:
+    adds    r12, r12, #6
+    blt     .fast_lz_literals_last
+
+.fast_lz_literals_words_loop:
+    ldr     r4, [r0], #4
+    str     r4, [r1], #4
+    subs    r12, r12, #2
+    bge     .fast_lz_literals_words_loop
+
+.fast_lz_literals_last:
+    tst     r12, #1
+    ldrneh  r4, [r0], #2
+    strneh  r4, [r1], #2
+    b       .fast_lz_literals_end
+
+.fast_lz_literals_half_words_loop:
+    ldrh    r4, [r0], #2
+    strh    r4, [r1], #2
+    subs    r12, r12, #1
+    bne     .fast_lz_literals_half_words_loop
+
+.fast_lz_literals_end:
+    cmp     r1, r2
+    bhs     .fast_lz_done
+
+.fast_lz_match:
+    ldrh    r4, [r0], #2
+    lsr     r12, r3, #8
+    cmp     r12, #0xFF
+    ldreqh  r5, [r0], #2
+    addeq   r12, r12, r5
+    add     r12, r12, #3
+    sub     r4, r1, r4, lsl #1
+
+    @ Words can be copied only if source and destination have the same alignment
+    @ and they are at least one word apart:
+    sub     r5, r1, r4
+    cmp     r5, #4
+    blt     .fast_lz_match_half_words_loop
+    tst     r5, #2
+    bne     .fast_lz_match_half_words_loop
+
+    tst     r1, #2
+    beq     .fast_lz_match_aligned
+    ldrh    r5, [r4], #2
+    strh    r5, [r1], #2
+    sub     r12, r12, #1
+
+.fast_lz_match_aligned:
+    subs    r12, r12, #2
+    blt     .fast_lz_match_last
+
+.fast_lz_match_words_loop:
+    ldr     r5, [r4], #4
+    str     r5, [r1], #4
+    subs    r12, r12, #2
+    bge     .fast_lz_match_words_loop
+
+.fast_lz_match_last:
+    tst     r12, #1
+    ldrneh  r5, [r4], #2
+    strneh  r5, [r1], #2
+    b       .fast_lz_match_end
+
+.fast_lz_match_half_words_loop:
+    ldrh    r5, [r4], #2
+    strh    r5, [r1], #2
+    subs    r12, r12, #1
+    bne     .fast_lz_match_half_words_loop
+
+.fast_lz_match_end:
+    cmp     r1, r2
+    blo     .fast_lz_sequence
+
+.fast_lz_done:
+    pop     {r4-r7}
+    bx      lr
@@ -0,0 +1,101 @@
+/*
+ * Copyright (c) 2020-2023 Gustavo Valiente gustavo.valiente@protonmail.com
+ * zlib License, see LICENSE file.
+ */
+
+#ifndef BN_ADPCM_MUSIC_H
+#define BN_ADPCM_MUSIC_H
+
+/**
+ * @file
+ * bn::adpcm_music header file.
+ *
+ * @ingroup adpcm_music
+ */
+
+#include "bn_fixed.h"
+#include "bn_optional.h"
+
+namespace bn
+{
+    class adpcm_music_item;
+}
+
+/**
+ * @brief ADPCM music related functions.
+ *
+ * ADPCM music is streamed from ROM and mixed with the output of the Direct Sound mixer,
+ * so it can be played at the same time as module music, jingles and sound effects.
+ *
+ * Its CPU usage doesn't depend on the number of instruments, and it's reported with the rest of the mixing cost
+ * by bn::audio::last_mixing_ticks.
+ *
+ * @ingroup adpcm_music
+ */
+namespace bn::adpcm_music
+{
+    /**
+     * @brief Indicates if currently there's any ADPCM music playing or not.
+     */
+    [[nodiscard]] bool playing();
+
+    /**
+     * @brief Returns the active adpcm_music_item if there's any ADPCM music playing; bn::nullopt otherwise.
+     */
+    [[nodiscard]] optional<adpcm_music_item> playing_item();
+
+    /**
+     * @brief Plays the ADPCM music specified by the given adpcm_music_item with default settings.
+     *
+     * Default settings are volume = 1 and loop enabled.
+     */
+    void play(const adpcm_music_item& item);
+
+    /**
+     * @brief Plays the ADPCM music specified by the given adpcm_music_item.
+     * @param item Specifies the ADPCM music to play.
+     * @param volume Volume level, in the range [0..1].
+     */
+    void play(const adpcm_music_item& item, fixed volume);
+
+    /**
+     * @brief Plays the ADPCM music specified by the given adpcm_music_item.
+     * @param item Specifies the ADPCM music to play.
+     * @param volume Volume level, in the range [0..1].
+     * @param loop Indicates if it must be played until it is stopped manually or until end.
+     */
+    void play(const adpcm_music_item& item, fixed volume, bool loop);
+
+    /**
+     * @brief Stops playback of the active ADPCM music.
+     */
+    void stop();
+
+    /**
+     * @brief Indicates if the active ADPCM music has been paused or not.
+     */
+    [[nodiscard]] bool paused();
+
+    /**
+     * @brief Pauses playback of the active ADPCM music.
+     */
+    void pause();
+
+    /**
+     * @brief Resumes playback of the paused ADPCM music.
+     */
+    void resume();
+
+    /**
+     * @brief Returns the volume of the active ADPCM music.
+     */
+    [[nodiscard]] fixed volume();
+
+    /**
+     * @brief Sets the volume of the active ADPCM music.
+     * @param volume Volume level, in the range [0..1].
+     */
+    void set_volume(fixed volume);
+}
+
+#endif
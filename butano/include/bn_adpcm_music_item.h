@@ -0,0 +1,130 @@
+/*
+ * Copyright (c) 2020-2023 Gustavo Valiente gustavo.valiente@protonmail.com
+ * zlib License, see LICENSE file.
+ */
+
+#ifndef BN_ADPCM_MUSIC_ITEM_H
+#define BN_ADPCM_MUSIC_ITEM_H
+
+/**
+ * @file
+ * bn::adpcm_music_item header file.
+ *
+ * @ingroup adpcm_music
+ * @ingroup tool
+ */
+
+#include "bn_fixed.h"
+#include "bn_functional.h"
+
+namespace bn
+{
+
+/**
+ * @brief Contains the required information to play ADPCM music.
+ *
+ * The assets conversion tools generate an object of this type in the build folder for each `*.wav` file
+ * with `adpcm_music` type.
+ *
+ * @ingroup adpcm_music
+ * @ingroup tool
+ */
+class adpcm_music_item
+{
+
+public:
+    /**
+     * @brief Constructor.
+     * @param data_ref Reference to the 4-bit IMA ADPCM stream data.
+     *
+     * Stream data is not copied but referenced, so it should outlive the adpcm_music_item
+     * to avoid dangling references.
+     */
+    constexpr explicit adpcm_music_item(const uint8_t& data_ref) :
+        _data_ptr(&data_ref)
+    {
+    }
+
+    /**
+     * @brief Returns a pointer to the referenced stream data.
+     */
+    [[nodiscard]] constexpr const uint8_t* data_ptr() const
+    {
+        return _data_ptr;
+    }
+
+    /**
+     * @brief Returns the referenced stream data.
+     */
+    [[nodiscard]] constexpr const uint8_t& data_ref() const
+    {
+        return *_data_ptr;
+    }
+
+    /**
+     * @brief Returns the sample rate of the referenced stream in Hz.
+     */
+    [[nodiscard]] int sample_rate() const
+    {
+        return int(reinterpret_cast<const unsigned*>(_data_ptr)[0]);
+    }
+
+    /**
+     * @brief Returns the number of samples of the referenced stream.
+     */
+    [[nodiscard]] int samples_count() const
+    {
+        return int(reinterpret_cast<const unsigned*>(_data_ptr)[1]);
+    }
+
+    /**
+     * @brief Plays the ADPCM music specified by this item with default settings.
+     *
+     * Default settings are volume = 1 and loop enabled.
+     */
+    void play() const;
+
+    /**
+     * @brief Plays the ADPCM music specified by this item.
+     * @param volume Volume level, in the range [0..1].
+     */
+    void play(fixed volume) const;
+
+    /**
+     * @brief Plays the ADPCM music specified by this item.
+     * @param volume Volume level, in the range [0..1].
+     * @param loop Indicates if it must be played until it is stopped manually or until end.
+     */
+    void play(fixed volume, bool loop) const;
+
+    /**
+     * @brief Default equal operator.
+     */
+    [[nodiscard]] constexpr friend bool operator==(const adpcm_music_item& a, const adpcm_music_item& b) = default;
+
+private:
+    const uint8_t* _data_ptr;
+};
+
+
+/**
+ * @brief Hash support for adpcm_music_item.
+ *
+ * @ingroup adpcm_music
+ * @ingroup functional
+ */
+template<>
+struct hash<adpcm_music_item>
+{
+    /**
+     * @brief Returns the hash of the given adpcm_music_item.
+     */
+    [[nodiscard]] constexpr unsigned operator()(const adpcm_music_item& value) const
+    {
+        return make_hash(value.data_ptr());
+    }
+};
+
+}
+
+#endif
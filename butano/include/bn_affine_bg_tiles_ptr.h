@@ -170,6 +170,14 @@ public:
      */
     [[nodiscard]] compression_type compression() const;
 
+    /**
+     * @brief Indicates if the referenced tiles have been committed to VRAM.
+     *
+     * Compressed tiles can be decompressed progressively across several frames
+     * (see BN_CFG_BG_BLOCKS_DECOMPRESSION_BYTES_PER_FRAME), so they are not ready until the last chunk is written.
+     */
+    [[nodiscard]] bool ready() const;
+
     /**
      * @brief Returns the referenced tiles unless it was created with allocate or allocate_optional.
      * In that case, it returns bn::nullopt.
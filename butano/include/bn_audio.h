@@ -13,7 +13,7 @@
  * @ingroup audio
  */
 
-#include "bn_common.h"
+#include "bn_fixed.h"
 
 /**
  * @brief Audio related functions.
@@ -22,6 +22,81 @@
  */
 namespace bn::audio
 {
+    /**
+     * @brief Returns the current Direct Sound mixing rate.
+     *
+     * Values are specified in BN_AUDIO_MIXING_RATE_* macros.
+     */
+    [[nodiscard]] int mixing_rate();
+
+    /**
+     * @brief Sets the Direct Sound mixing rate.
+     *
+     * Lower mixing rates reduce the CPU usage of the Direct Sound mixer at the cost of audio quality.
+     *
+     * Keep in mind that changing the mixing rate stalls the CPU up to two frames
+     * and stops all sound effects and the active jingle, so it should be done when it is not noticeable
+     * (for example, when a scene is loaded).
+     *
+     * The active music is restarted in its current position.
+     *
+     * @param mixing_rate Value specified in BN_AUDIO_MIXING_RATE_* macros.
+     * It can't be greater than BN_CFG_AUDIO_MIXING_RATE.
+     */
+    void set_mixing_rate(int mixing_rate);
+
+    /**
+     * @brief Returns the maximum number of Direct Sound channels which can be mixed at the same time.
+     */
+    [[nodiscard]] int max_channels();
+
+    /**
+     * @brief Sets the maximum number of Direct Sound channels which can be mixed at the same time.
+     *
+     * Mixing fewer channels reduces the CPU usage of the Direct Sound mixer.
+     *
+     * This is a budget shared by music notes and sound effects (Maxmod allocates both from the same channels),
+     * so music can't be limited without limiting sound effects too.
+     *
+     * When all channels are in use, new notes and sound effects replace the quietest ones.
+     *
+     * @param max_channels Maximum number of Direct Sound channels
+     * in the range [1..BN_CFG_AUDIO_MAX_MUSIC_CHANNELS + BN_CFG_AUDIO_MAX_SOUND_CHANNELS].
+     */
+    void set_max_channels(int max_channels);
+
+    /**
+     * @brief Returns the CPU timer ticks spent by the Direct Sound mixer in the last audio update.
+     */
+    [[nodiscard]] int last_mixing_ticks();
+
+    /**
+     * @brief Returns the CPU usage of the Direct Sound mixer in the last audio update.
+     *
+     * It is relative to a full frame, like core::last_cpu_usage.
+     */
+    [[nodiscard]] fixed last_mixing_usage();
+
+    /**
+     * @brief Returns the number of audio commands which have been merged with pending ones
+     * since the last audio::reset_commands_counters call.
+     *
+     * For example, setting the music volume twice in the same frame merges both commands.
+     */
+    [[nodiscard]] int coalesced_commands_count();
+
+    /**
+     * @brief Returns the number of sound effects play, speed and panning commands which have been dropped
+     * since the last audio::reset_commands_counters call, because there was no room for them
+     * in the audio commands list (see @ref BN_CFG_AUDIO_MAX_COMMANDS) or there were too many active sound handles.
+     */
+    [[nodiscard]] int dropped_commands_count();
+
+    /**
+     * @brief Resets audio::coalesced_commands_count and audio::dropped_commands_count.
+     */
+    void reset_commands_counters();
+
     /**
      * @brief Indicates if audio is updated on the V-Blank interrupt or not.
      *
@@ -87,4 +87,76 @@
  */
 #define BN_AUDIO_MIXING_RATE_31_KHZ    7
 
+/**
+ * @def BN_AUDIO_MIXING_RATE_8_KHZ_FREQUENCY
+ *
+ * Frequency in Hz of BN_AUDIO_MIXING_RATE_8_KHZ.
+ *
+ * @ingroup audio
+ */
+#define BN_AUDIO_MIXING_RATE_8_KHZ_FREQUENCY     8121
+
+/**
+ * @def BN_AUDIO_MIXING_RATE_10_KHZ_FREQUENCY
+ *
+ * Frequency in Hz of BN_AUDIO_MIXING_RATE_10_KHZ.
+ *
+ * @ingroup audio
+ */
+#define BN_AUDIO_MIXING_RATE_10_KHZ_FREQUENCY    10512
+
+/**
+ * @def BN_AUDIO_MIXING_RATE_13_KHZ_FREQUENCY
+ *
+ * Frequency in Hz of BN_AUDIO_MIXING_RATE_13_KHZ.
+ *
+ * @ingroup audio
+ */
+#define BN_AUDIO_MIXING_RATE_13_KHZ_FREQUENCY    13379
+
+/**
+ * @def BN_AUDIO_MIXING_RATE_16_KHZ_FREQUENCY
+ *
+ * Frequency in Hz of BN_AUDIO_MIXING_RATE_16_KHZ.
+ *
+ * @ingroup audio
+ */
+#define BN_AUDIO_MIXING_RATE_16_KHZ_FREQUENCY    15768
+
+/**
+ * @def BN_AUDIO_MIXING_RATE_18_KHZ_FREQUENCY
+ *
+ * Frequency in Hz of BN_AUDIO_MIXING_RATE_18_KHZ.
+ *
+ * @ingroup audio
+ */
+#define BN_AUDIO_MIXING_RATE_18_KHZ_FREQUENCY    18157
+
+/**
+ * @def BN_AUDIO_MIXING_RATE_21_KHZ_FREQUENCY
+ *
+ * Frequency in Hz of BN_AUDIO_MIXING_RATE_21_KHZ.
+ *
+ * @ingroup audio
+ */
+#define BN_AUDIO_MIXING_RATE_21_KHZ_FREQUENCY    21024
+
+/**
+ * @def BN_AUDIO_MIXING_RATE_27_KHZ_FREQUENCY
+ *
+ * Frequency in Hz of BN_AUDIO_MIXING_RATE_27_KHZ.
+ *
+ * @ingroup audio
+ */
+#define BN_AUDIO_MIXING_RATE_27_KHZ_FREQUENCY    26758
+
+/**
+ * @def BN_AUDIO_MIXING_RATE_31_KHZ_FREQUENCY
+ *
+ * Frequency in Hz of BN_AUDIO_MIXING_RATE_31_KHZ.
+ *
+ * @ingroup audio
+ */
+#define BN_AUDIO_MIXING_RATE_31_KHZ_FREQUENCY    31536
+
 #endif
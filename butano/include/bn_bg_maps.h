@@ -13,7 +13,7 @@
  * @ingroup bg_map
  */
 
-#include "bn_common.h"
+#include "bn_fixed.h"
 
 namespace bn
 {
@@ -47,6 +47,21 @@ namespace bn::bg_maps
      */
     [[nodiscard]] int available_blocks_count();
 
+    /**
+     * @brief Returns how much the available background blocks are fragmented in VRAM, in the range [0..1].
+     *
+     * Zero means that all available background blocks are contiguous,
+     * and values close to one mean that only small tile sets and maps can be created.
+     */
+    [[nodiscard]] fixed fragmentation();
+
+    /**
+     * @brief Returns the number of background map bytes committed to VRAM in the last frame.
+     *
+     * It includes full map reloads, partial map reloads and big map updates.
+     */
+    [[nodiscard]] int last_committed_bytes();
+
     /**
      * @brief Returns the size of the canvas used to create big affine background maps.
      */
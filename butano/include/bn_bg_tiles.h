@@ -14,7 +14,7 @@
  * @ingroup tile
  */
 
-#include "bn_common.h"
+#include "bn_fixed.h"
 
 /**
  * @brief Background tiles related functions.
@@ -48,6 +48,14 @@ namespace bn::bg_tiles
      */
     [[nodiscard]] int available_blocks_count();
 
+    /**
+     * @brief Returns how much the available background blocks are fragmented in VRAM, in the range [0..1].
+     *
+     * Zero means that all available background blocks are contiguous,
+     * and values close to one mean that only small tile sets and maps can be created.
+     */
+    [[nodiscard]] fixed fragmentation();
+
     /**
      * @brief Specifies if tile offsets are allowed to improve VRAM usage when creating
      * regular_bg_tiles_ptr and affine_bg_tiles_ptr objects.
@@ -28,7 +28,8 @@ enum class compression_type : uint8_t
     NONE, //!< Uncompressed data.
     LZ77, //!< LZ77 compressed data.
     RUN_LENGTH, //!< Run-length compressed data.
-    HUFFMAN //!< Huffman compressed data.
+    HUFFMAN, //!< Huffman compressed data.
+    FAST_LZ //!< Fast LZ compressed data (LZ4 like format with 16-bit units, faster to decompress than LZ77).
 };
 
 }
@@ -22,6 +22,8 @@
  *
  * Values not specified in BN_AUDIO_MIXING_RATE_* macros are not allowed.
  *
+ * It is also the highest mixing rate which can be set with bn::audio::set_mixing_rate.
+ *
  * @ingroup audio
  */
 #ifndef BN_CFG_AUDIO_MIXING_RATE
@@ -33,6 +35,9 @@
  *
  * Specifies the maximum number of active Direct Sound music channels.
  *
+ * The maximum number of mixed channels (music and sound effects) can be reduced at runtime
+ * with bn::audio::set_max_channels.
+ *
  * @ingroup music
  */
 #ifndef BN_CFG_AUDIO_MAX_MUSIC_CHANNELS
@@ -57,10 +62,18 @@
  *
  * This list is processed and cleared when bn::core::update() is called.
  *
+ * It must be a power of two.
+ *
+ * Sound effects play, speed and panning commands can't use the last quarter of this list:
+ * when there's no room for them, they are dropped (see bn::audio::dropped_commands_count).
+ *
+ * The last quarter is reserved for the other commands (music, jingles, sound effects stop, etc),
+ * which still raise an error if this list is full.
+ *
  * @ingroup audio
  */
 #ifndef BN_CFG_AUDIO_MAX_COMMANDS
-    #define BN_CFG_AUDIO_MAX_COMMANDS (((BN_CFG_AUDIO_MAX_SOUND_CHANNELS) * 2) + 1)
+    #define BN_CFG_AUDIO_MAX_COMMANDS 64
 #endif
 
 #endif
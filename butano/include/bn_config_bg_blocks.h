@@ -26,6 +26,57 @@
     #define BN_CFG_BG_BLOCKS_MAX_ITEMS 16
 #endif
 
+/**
+ * @def BN_CFG_BG_BLOCKS_BIG_MAP_CHUNKS
+ *
+ * Specifies the maximum number of decompressed 8x8 cells chunks of big regular background maps
+ * that can be cached at the same time.
+ *
+ * If it is zero, compressed big maps are not supported.
+ *
+ * Each visible compressed big map needs up to 25 chunks to avoid decompressing chunks every frame.
+ *
+ * @ingroup bg
+ */
+#ifndef BN_CFG_BG_BLOCKS_BIG_MAP_CHUNKS
+    #define BN_CFG_BG_BLOCKS_BIG_MAP_CHUNKS 0
+#endif
+
+/**
+ * @def BN_CFG_BG_BLOCKS_DEFRAG_MAX_BLOCKS
+ *
+ * Specifies the maximum number of background blocks that can be moved in VRAM per frame
+ * to reduce its fragmentation.
+ *
+ * Tile sets and maps are moved in VBlank and the backgrounds which reference them are updated.
+ *
+ * Tile sets and maps created with allocate methods, big maps and bigger items than this value are never moved.
+ *
+ * If it is zero, background blocks are never moved.
+ *
+ * @ingroup bg
+ */
+#ifndef BN_CFG_BG_BLOCKS_DEFRAG_MAX_BLOCKS
+    #define BN_CFG_BG_BLOCKS_DEFRAG_MAX_BLOCKS 0
+#endif
+
+/**
+ * @def BN_CFG_BG_BLOCKS_DECOMPRESSION_BYTES_PER_FRAME
+ *
+ * Specifies the maximum number of bytes of compressed background tiles and maps
+ * that can be decompressed to VRAM per frame.
+ *
+ * If it is not zero, compressed items are decompressed progressively in multiple frames
+ * instead of when they are created, so their tiles or map cells are not valid until they are ready.
+ *
+ * If it is zero, compressed items are decompressed at once.
+ *
+ * @ingroup bg
+ */
+#ifndef BN_CFG_BG_BLOCKS_DECOMPRESSION_BYTES_PER_FRAME
+    #define BN_CFG_BG_BLOCKS_DECOMPRESSION_BYTES_PER_FRAME 0
+#endif
+
 /**
  * @def BN_CFG_BG_BLOCKS_LOG_ENABLED
  *
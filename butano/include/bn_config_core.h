@@ -0,0 +1,29 @@
+/*
+ * Copyright (c) 2020-2023 Gustavo Valiente gustavo.valiente@protonmail.com
+ * zlib License, see LICENSE file.
+ */
+
+#ifndef BN_CONFIG_CORE_H
+#define BN_CONFIG_CORE_H
+
+/**
+ * @file
+ * Core configuration header file.
+ *
+ * @ingroup core
+ */
+
+#include "bn_common.h"
+
+/**
+ * @def BN_CFG_CORE_MAX_FRAME_STATS
+ *
+ * Specifies the maximum number of frame_stats objects stored by bn::core.
+ *
+ * @ingroup core
+ */
+#ifndef BN_CFG_CORE_MAX_FRAME_STATS
+    #define BN_CFG_CORE_MAX_FRAME_STATS 8
+#endif
+
+#endif
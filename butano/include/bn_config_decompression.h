@@ -0,0 +1,31 @@
+/*
+ * Copyright (c) 2020-2023 Gustavo Valiente gustavo.valiente@protonmail.com
+ * zlib License, see LICENSE file.
+ */
+
+#ifndef BN_CONFIG_DECOMPRESSION_H
+#define BN_CONFIG_DECOMPRESSION_H
+
+/**
+ * @file
+ * Decompression configuration header file.
+ *
+ * @ingroup memory
+ */
+
+/**
+ * @def BN_CFG_DECOMPRESSION_BIOS_ENABLED
+ *
+ * Specifies if data must be decompressed with the GBA BIOS routines instead of the IWRAM ones.
+ *
+ * IWRAM routines are much faster, but BIOS routines don't take IWRAM space.
+ *
+ * Keep in mind that BIOS LZ77 routine doesn't support one byte displacements when decompressing to VRAM.
+ *
+ * @ingroup memory
+ */
+#ifndef BN_CFG_DECOMPRESSION_BIOS_ENABLED
+    #define BN_CFG_DECOMPRESSION_BIOS_ENABLED false
+#endif
+
+#endif
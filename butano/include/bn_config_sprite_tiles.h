@@ -27,6 +27,70 @@
     #define BN_CFG_SPRITE_TILES_MAX_ITEMS 128
 #endif
 
+/**
+ * @def BN_CFG_SPRITE_TILES_CACHE_ENABLED
+ *
+ * Specifies if sprite tile sets must be kept in VRAM after all of their sprite_tiles_ptr objects are destroyed,
+ * until their space is needed by other tile sets.
+ *
+ * The least recently released tile sets are removed first.
+ *
+ * It avoids uploading the same tiles again and again in animations which cycle between a few tile sets.
+ *
+ * @ingroup sprite
+ */
+#ifndef BN_CFG_SPRITE_TILES_CACHE_ENABLED
+    #define BN_CFG_SPRITE_TILES_CACHE_ENABLED false
+#endif
+
+/**
+ * @def BN_CFG_SPRITE_TILES_DEFRAG_MAX_TILES
+ *
+ * Specifies the maximum number of sprite tiles that can be moved in VRAM per frame to reduce its fragmentation.
+ *
+ * Tile sets are moved in VBlank and the tile indexes of the sprite handles which reference them are updated.
+ *
+ * Tile sets created with sprite_tiles_ptr::allocate or bigger than this value are never moved.
+ *
+ * If it is zero, sprite tiles are never moved.
+ *
+ * @ingroup sprite
+ */
+#ifndef BN_CFG_SPRITE_TILES_DEFRAG_MAX_TILES
+    #define BN_CFG_SPRITE_TILES_DEFRAG_MAX_TILES 0
+#endif
+
+/**
+ * @def BN_CFG_SPRITE_TILES_DECOMPRESSION_BYTES_PER_FRAME
+ *
+ * Specifies the maximum number of bytes of compressed sprite tiles that can be decompressed to VRAM per frame.
+ *
+ * If it is not zero, compressed tiles are decompressed progressively in multiple frames
+ * instead of when they are created, so they are not valid until they are ready.
+ *
+ * If it is zero, compressed tiles are decompressed at once.
+ *
+ * @ingroup sprite
+ */
+#ifndef BN_CFG_SPRITE_TILES_DECOMPRESSION_BYTES_PER_FRAME
+    #define BN_CFG_SPRITE_TILES_DECOMPRESSION_BYTES_PER_FRAME 0
+#endif
+
+/**
+ * @def BN_CFG_SPRITE_TILES_MAX_DELTA_RUNS
+ *
+ * Specifies the maximum number of changed tiles runs of bn::sprite_tiles_delta_item objects
+ * that can be committed to VRAM in the next vertical blank.
+ *
+ * If more runs are applied in the same frame, the pending ones are copied to VRAM immediately,
+ * so the affected sprites can show torn tiles for one frame.
+ *
+ * @ingroup sprite
+ */
+#ifndef BN_CFG_SPRITE_TILES_MAX_DELTA_RUNS
+    #define BN_CFG_SPRITE_TILES_MAX_DELTA_RUNS 32
+#endif
+
 /**
  * @def BN_CFG_SPRITE_TILES_LOG_ENABLED
  *
@@ -13,7 +13,7 @@
  * @ingroup sprite
  */
 
-#include "bn_common.h"
+#include "bn_sprites_sorter.h"
 
 /**
  * @def BN_CFG_SPRITES_MAX_ITEMS
@@ -37,10 +37,80 @@
  * Sprites are grouped in layers depending of their background priority and z order,
  * so to reduce memory usage and improve performance, please use as less unique z orders as possible.
  *
+ * It is ignored if BN_CFG_SPRITES_SORTER is not BN_SPRITES_SORTER_LAYERS.
+ *
  * @ingroup sprite
  */
 #ifndef BN_CFG_SPRITES_MAX_SORT_LAYERS
     #define BN_CFG_SPRITES_MAX_SORT_LAYERS 16
 #endif
 
+/**
+ * @def BN_CFG_SPRITES_SORTER
+ *
+ * Specifies the algorithm used to sort sprites by background priority and z order.
+ *
+ * Values not specified in BN_SPRITES_SORTER_* macros are not allowed.
+ *
+ * @ingroup sprite
+ */
+#ifndef BN_CFG_SPRITES_SORTER
+    #define BN_CFG_SPRITES_SORTER BN_SPRITES_SORTER_LAYERS
+#endif
+
+/**
+ * @def BN_CFG_SPRITES_MULTIPLEXER_HANDLES
+ *
+ * Specifies the number of hardware sprite handles reserved to show more than 128 sprites at the same time.
+ *
+ * On screen sprites which don't fit in the other handles are assigned to these handles
+ * in each vertical band of the screen, and they are reloaded with HDMA while the screen is being drawn.
+ *
+ * Each reserved handle requires 2560 bytes of EWRAM for the HDMA tables.
+ *
+ * Keep in mind that low priority HDMA can't be used while sprites are being multiplexed,
+ * and that OAM access during H-Blank is enabled, so less sprite pixels can be displayed per scanline.
+ *
+ * If it is zero, sprite multiplexing is disabled.
+ *
+ * @ingroup sprite
+ */
+#ifndef BN_CFG_SPRITES_MULTIPLEXER_HANDLES
+    #define BN_CFG_SPRITES_MULTIPLEXER_HANDLES 0
+#endif
+
+/**
+ * @def BN_CFG_SPRITES_MULTIPLEXER_BANDS
+ *
+ * Specifies the number of vertical bands in which the screen is divided to multiplex sprites.
+ *
+ * A multiplexed sprite takes a reserved handle in each band it overlaps,
+ * so more bands allow to display more sprites, but the screen height must be divisible by it.
+ *
+ * It is ignored if BN_CFG_SPRITES_MULTIPLEXER_HANDLES is zero.
+ *
+ * @ingroup sprite
+ */
+#ifndef BN_CFG_SPRITES_MULTIPLEXER_BANDS
+    #define BN_CFG_SPRITES_MULTIPLEXER_BANDS 8
+#endif
+
+/**
+ * @def BN_CFG_SPRITES_CULLING_GRID_ENABLED
+ *
+ * Specifies if sprites attached to a camera must be indexed by a coarse spatial grid.
+ *
+ * When a camera is moved, only the sprites close to its old and new viewports are updated,
+ * so it improves performance in big levels with lots of sprites attached to a camera.
+ * The other sprites are updated when they are needed.
+ *
+ * It requires 1KB of EWRAM and a few more bytes per sprite.
+ *
+ * @ingroup sprite
+ * @ingroup camera
+ */
+#ifndef BN_CFG_SPRITES_CULLING_GRID_ENABLED
+    #define BN_CFG_SPRITES_CULLING_GRID_ENABLED false
+#endif
+
 #endif
@@ -22,6 +22,7 @@
 namespace bn
 {
     class color;
+    class frame_stats;
     class system_font;
 }
 
@@ -174,6 +175,28 @@ namespace bn::core
      */
     [[nodiscard]] int last_missed_frames();
 
+    /**
+     * @brief Returns the timer ticks spent by the engine in each phase of the last elapsed frame.
+     *
+     * It is stored for every screen refresh, even when frames are skipped (see core::skip_frames).
+     */
+    [[nodiscard]] const frame_stats& last_frame_stats();
+
+    /**
+     * @brief Returns the timer ticks spent by the engine in each phase of a previous frame.
+     * @param frames_ago Number of frames elapsed since the requested one,
+     * in the range [0..core::last_frame_stats_count() - 1].
+     * @return frame_stats of the requested frame.
+     */
+    [[nodiscard]] const frame_stats& last_frame_stats(int frames_ago);
+
+    /**
+     * @brief Returns the number of stored frame_stats objects.
+     *
+     * The maximum number of stored frame_stats objects is specified by @ref BN_CFG_CORE_MAX_FRAME_STATS.
+     */
+    [[nodiscard]] int last_frame_stats_count();
+
     /**
      * @brief Returns the user function called in V-Blank.
      */
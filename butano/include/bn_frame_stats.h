@@ -0,0 +1,167 @@
+/*
+ * Copyright (c) 2020-2023 Gustavo Valiente gustavo.valiente@protonmail.com
+ * zlib License, see LICENSE file.
+ */
+
+#ifndef BN_FRAME_STATS_H
+#define BN_FRAME_STATS_H
+
+/**
+ * @file
+ * bn::frame_stats header file.
+ *
+ * @ingroup core
+ */
+
+#include "bn_assert.h"
+#include "bn_frame_stats_phase.h"
+
+namespace bn
+{
+
+/**
+ * @brief Timer ticks spent by the engine in each phase of a bn::core::update call.
+ *
+ * @ingroup core
+ */
+class frame_stats
+{
+
+public:
+    /**
+     * @brief Number of measured engine phases.
+     */
+    static constexpr int phases_count = int(frame_stats_phase::AUDIO) + 1;
+
+    /**
+     * @brief Default constructor.
+     */
+    constexpr frame_stats() = default;
+
+    /**
+     * @brief Returns the timer ticks spent in the given engine phase.
+     */
+    [[nodiscard]] constexpr int ticks(frame_stats_phase phase) const
+    {
+        return _ticks[_phase_index(phase)];
+    }
+
+    /**
+     * @brief Sets the timer ticks spent in the given engine phase.
+     */
+    constexpr void set_ticks(frame_stats_phase phase, int ticks)
+    {
+        BN_ASSERT(ticks >= 0, "Invalid ticks: ", ticks);
+
+        _ticks[_phase_index(phase)] = ticks;
+    }
+
+    /**
+     * @brief Returns the timer ticks spent in all engine phases before V-Blank.
+     */
+    [[nodiscard]] constexpr int update_ticks() const
+    {
+        return _sum_ticks(0, int(frame_stats_phase::HBLANK_EFFECTS_UPDATE) + 1);
+    }
+
+    /**
+     * @brief Returns the timer ticks spent in all engine phases after V-Blank.
+     */
+    [[nodiscard]] constexpr int commit_ticks() const
+    {
+        return _sum_ticks(int(frame_stats_phase::DISPLAY_COMMIT), phases_count);
+    }
+
+    /**
+     * @brief Returns the CPU timer ticks of the frame (game logic and engine update phases).
+     */
+    [[nodiscard]] constexpr int cpu_ticks() const
+    {
+        return _cpu_ticks;
+    }
+
+    /**
+     * @brief Sets the CPU timer ticks of the frame (game logic and engine update phases).
+     */
+    constexpr void set_cpu_ticks(int cpu_ticks)
+    {
+        BN_ASSERT(cpu_ticks >= 0, "Invalid CPU ticks: ", cpu_ticks);
+
+        _cpu_ticks = cpu_ticks;
+    }
+
+    /**
+     * @brief Returns the CPU timer ticks spent outside of the engine update phases.
+     */
+    [[nodiscard]] constexpr int game_ticks() const
+    {
+        int result = _cpu_ticks - update_ticks();
+        return result > 0 ? result : 0;
+    }
+
+    /**
+     * @brief Returns the timer ticks elapsed since the start of V-Blank until all engine phases finished.
+     */
+    [[nodiscard]] constexpr int vblank_ticks() const
+    {
+        return _vblank_ticks;
+    }
+
+    /**
+     * @brief Sets the timer ticks elapsed since the start of V-Blank until all engine phases finished.
+     */
+    constexpr void set_vblank_ticks(int vblank_ticks)
+    {
+        BN_ASSERT(vblank_ticks >= 0, "Invalid V-Blank ticks: ", vblank_ticks);
+
+        _vblank_ticks = vblank_ticks;
+    }
+
+    /**
+     * @brief Returns the number of screen refreshes that were missed before the V-Blank of the frame.
+     */
+    [[nodiscard]] constexpr int missed_frames() const
+    {
+        return _missed_frames;
+    }
+
+    /**
+     * @brief Sets the number of screen refreshes that were missed before the V-Blank of the frame.
+     */
+    constexpr void set_missed_frames(int missed_frames)
+    {
+        BN_ASSERT(missed_frames >= 0, "Invalid missed frames: ", missed_frames);
+
+        _missed_frames = missed_frames;
+    }
+
+private:
+    int _ticks[phases_count] = {};
+    int _cpu_ticks = 0;
+    int _vblank_ticks = 0;
+    int _missed_frames = 0;
+
+    [[nodiscard]] static constexpr int _phase_index(frame_stats_phase phase)
+    {
+        int result = int(phase);
+        BN_ASSERT(result >= 0 && result < phases_count, "Invalid phase: ", result);
+
+        return result;
+    }
+
+    [[nodiscard]] constexpr int _sum_ticks(int first_phase_index, int last_phase_index) const
+    {
+        int result = 0;
+
+        for(int index = first_phase_index; index < last_phase_index; ++index)
+        {
+            result += _ticks[index];
+        }
+
+        return result;
+    }
+};
+
+}
+
+#endif
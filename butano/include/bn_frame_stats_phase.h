@@ -0,0 +1,53 @@
+/*
+ * Copyright (c) 2020-2023 Gustavo Valiente gustavo.valiente@protonmail.com
+ * zlib License, see LICENSE file.
+ */
+
+#ifndef BN_FRAME_STATS_PHASE_H
+#define BN_FRAME_STATS_PHASE_H
+
+/**
+ * @file
+ * bn::frame_stats_phase header file.
+ *
+ * @ingroup core
+ */
+
+#include "bn_common.h"
+
+namespace bn
+{
+
+/**
+ * @brief Engine phases measured in each bn::core::update call.
+ *
+ * @ingroup core
+ */
+enum class frame_stats_phase : uint8_t
+{
+    CAMERAS_UPDATE, //!< Cameras update.
+    SPRITES_UPDATE, //!< Sprites update.
+    SPRITE_TILES_UPDATE, //!< Sprite tiles update.
+    BGS_UPDATE, //!< Backgrounds update.
+    BG_BLOCKS_UPDATE, //!< Background tiles and maps update.
+    PALETTES_UPDATE, //!< Color palettes update.
+    DISPLAY_UPDATE, //!< Display update.
+    HBLANK_EFFECTS_UPDATE, //!< H-Blank effects update.
+    DISPLAY_COMMIT, //!< Display registers commit.
+    SPRITES_COMMIT, //!< Sprite handles commit.
+    BGS_COMMIT, //!< Backgrounds registers commit.
+    PALETTES_COMMIT, //!< Color palettes commit.
+    SPRITE_TILES_UNCOMPRESSED_COMMIT, //!< Uncompressed sprite tiles commit.
+    HDMA_COMMIT, //!< HDMA update and commit.
+    HBLANK_EFFECTS_COMMIT, //!< H-Blank effects commit.
+    BIG_MAPS_COMMIT, //!< Big maps commit.
+    BG_BLOCKS_UNCOMPRESSED_COMMIT, //!< Uncompressed background tiles and maps commit.
+    SPRITE_TILES_COMPRESSED_COMMIT, //!< Compressed sprite tiles commit.
+    BG_BLOCKS_COMPRESSED_COMMIT, //!< Compressed background tiles and maps commit.
+    VBLANK_CALLBACK, //!< User function called in V-Blank.
+    AUDIO //!< Audio commands and mixing.
+};
+
+}
+
+#endif
@@ -0,0 +1,247 @@
+/*
+ * Copyright (c) 2020-2023 Gustavo Valiente gustavo.valiente@protonmail.com
+ * zlib License, see LICENSE file.
+ */
+
+#ifndef BN_PARTICLE_SYSTEM_H
+#define BN_PARTICLE_SYSTEM_H
+
+/**
+ * @file
+ * bn::iparticle_system and bn::particle_system implementation header file.
+ *
+ * @ingroup sprite
+ */
+
+#include "bn_vector.h"
+#include "bn_fixed_point.h"
+#include "bn_sprite_shape_size.h"
+#include "bn_sprite_tiles_ptr.h"
+#include "bn_sprite_palette_ptr.h"
+
+namespace bn
+{
+
+class sprite_item;
+
+/**
+ * @brief Base class of bn::particle_system.
+ *
+ * Can be used as a reference type for all bn::particle_system containers.
+ *
+ * @ingroup sprite
+ */
+class iparticle_system
+{
+
+public:
+    /**
+     * @brief Maximum number of tile sets that can be referenced by a particle system.
+     */
+    static constexpr int max_graphics_count = 8;
+
+    iparticle_system(const iparticle_system& other) = delete;
+
+    iparticle_system& operator=(const iparticle_system& other) = delete;
+
+    /**
+     * @brief Destructor.
+     */
+    ~iparticle_system();
+
+    /**
+     * @brief Returns the number of alive particles.
+     */
+    [[nodiscard]] int size() const
+    {
+        return _size;
+    }
+
+    /**
+     * @brief Returns the maximum number of particles that can be alive at the same time.
+     */
+    [[nodiscard]] int max_size() const
+    {
+        return _max_size;
+    }
+
+    /**
+     * @brief Indicates if there's no alive particles.
+     */
+    [[nodiscard]] bool empty() const
+    {
+        return _size == 0;
+    }
+
+    /**
+     * @brief Indicates if no more particles can be emitted.
+     */
+    [[nodiscard]] bool full() const
+    {
+        return _size == _max_size;
+    }
+
+    /**
+     * @brief Returns the index of the first hardware sprite handle used to display the particles.
+     */
+    [[nodiscard]] int first_handle_index() const
+    {
+        return _first_handle_index;
+    }
+
+    /**
+     * @brief Returns the shape and size of the particles.
+     */
+    [[nodiscard]] const sprite_shape_size& shape_size() const
+    {
+        return _shape_size;
+    }
+
+    /**
+     * @brief Returns the number of tile sets referenced by this particle system.
+     */
+    [[nodiscard]] int graphics_count() const
+    {
+        return _tiles.size();
+    }
+
+    /**
+     * @brief Returns the sprite color palette used by the particles.
+     */
+    [[nodiscard]] const sprite_palette_ptr& palette() const
+    {
+        return _palette;
+    }
+
+    /**
+     * @brief Returns the priority of the particles relative to the layers.
+     */
+    [[nodiscard]] int bg_priority() const
+    {
+        return _bg_priority;
+    }
+
+    /**
+     * @brief Sets the priority of the particles relative to the layers.
+     *
+     * Particles are drawn above the sprites which have the same priority.
+     *
+     * @param bg_priority Priority relative to the layers in the range [0..3].
+     */
+    void set_bg_priority(int bg_priority);
+
+    /**
+     * @brief Returns the number of times update must be called before changing the tile set of each particle.
+     *
+     * If it is zero, particles don't change their tile set.
+     */
+    [[nodiscard]] int wait_updates() const
+    {
+        return _wait_updates;
+    }
+
+    /**
+     * @brief Sets the number of times update must be called before changing the tile set of each particle.
+     *
+     * If it is zero, particles don't change their tile set.
+     */
+    void set_wait_updates(int wait_updates);
+
+    /**
+     * @brief Returns the velocity added to all particles in each update call.
+     */
+    [[nodiscard]] const fixed_point& gravity() const
+    {
+        return _gravity;
+    }
+
+    /**
+     * @brief Sets the velocity added to all particles in each update call.
+     */
+    void set_gravity(const fixed_point& gravity)
+    {
+        _gravity = gravity;
+    }
+
+    /**
+     * @brief Emits a new particle.
+     * @param position Position of the particle (center, in screen coordinates).
+     * @param velocity Velocity of the particle.
+     * @param lifetime Number of update calls before the particle is destroyed.
+     */
+    void emit(const fixed_point& position, const fixed_point& velocity, int lifetime);
+
+    /**
+     * @brief Destroys all alive particles.
+     */
+    void clear();
+
+    /**
+     * @brief Moves, animates and destroys the alive particles, writing them to the reserved hardware sprite handles.
+     *
+     * It must be called once per frame for the particles to be displayed.
+     */
+    void update();
+
+protected:
+    /// @cond DO_NOT_DOCUMENT
+
+    static constexpr int particle_bytes = (sizeof(fixed) * 4) + sizeof(uint16_t) + (sizeof(uint8_t) * 2);
+
+    iparticle_system(const sprite_item& item, int max_size, void* buffer);
+
+    /// @endcond
+
+private:
+    vector<sprite_tiles_ptr, max_graphics_count> _tiles;
+    sprite_palette_ptr _palette;
+    fixed* _xs;
+    fixed* _ys;
+    fixed* _x_velocities;
+    fixed* _y_velocities;
+    uint16_t* _lifetimes;
+    uint8_t* _graphics_indexes;
+    uint8_t* _wait_counters;
+    fixed_point _gravity;
+    sprite_shape_size _shape_size;
+    int _max_size;
+    int _size = 0;
+    int _written_size = 0;
+    int _first_handle_index;
+    uint16_t _wait_updates = 0;
+    uint8_t _bg_priority = 3;
+};
+
+
+/**
+ * @brief Structure-of-arrays particle system which writes its particles directly to hardware sprite handles.
+ *
+ * It reserves MaxSize hardware sprite handles while it is alive, so it's much lighter than a sprite_ptr per particle.
+ * All particles share the same shape, size, color palette and tile sets.
+ *
+ * @tparam MaxSize Maximum number of particles that can be alive at the same time.
+ *
+ * @ingroup sprite
+ */
+template<int MaxSize>
+class particle_system : public iparticle_system
+{
+    static_assert(MaxSize > 0);
+
+public:
+    /**
+     * @brief Constructor.
+     * @param item sprite_item containing the required information to generate the particles.
+     */
+    explicit particle_system(const sprite_item& item) :
+        iparticle_system(item, MaxSize, _buffer)
+    {
+    }
+
+private:
+    alignas(int) uint8_t _buffer[MaxSize * particle_bytes];
+};
+
+}
+
+#endif
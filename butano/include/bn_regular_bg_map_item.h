@@ -21,6 +21,7 @@
 #include "bn_span_fwd.h"
 #include "bn_compression_type.h"
 #include "bn_regular_bg_map_cell.h"
+#include "bn_regular_bg_streaming_tiles_item.h"
 
 namespace bn
 {
@@ -158,6 +159,43 @@ public:
         BN_ASSERT(maps_count > 0 && maps_count < 65536, "Invalid maps count: ", maps_count);
     }
 
+    /**
+     * @brief Constructor.
+     * @param cells_ref Reference to a big regular background map cells.
+     *
+     * The map cells are not copied but referenced, so they should outlive the regular_bg_map_item
+     * to avoid dangling references.
+     *
+     * @param dimensions Size in map cells of the referenced map.
+     * @param compression Compression type.
+     * @param streaming_tiles Required information to stream the tiles of each map region.
+     *
+     * It is not copied but referenced, so it should outlive the regular_bg_map_item
+     * to avoid dangling references.
+     */
+    constexpr regular_bg_map_item(
+            const regular_bg_map_cell& cells_ref, const size& dimensions, compression_type compression,
+            const regular_bg_streaming_tiles_item& streaming_tiles) :
+        regular_bg_map_item(cells_ref, dimensions, compression, 1, true)
+    {
+        const size& region_dimensions = streaming_tiles.region_dimensions();
+        BN_ASSERT(dimensions.width() % region_dimensions.width() == 0,
+                  "Map width is not divisible by region width: ", dimensions.width(), " - ",
+                  region_dimensions.width());
+        BN_ASSERT(dimensions.height() % region_dimensions.height() == 0,
+                  "Map height is not divisible by region height: ", dimensions.height(), " - ",
+                  region_dimensions.height());
+
+        int regions_columns = dimensions.width() / region_dimensions.width();
+        int regions_rows = dimensions.height() / region_dimensions.height();
+        BN_ASSERT(regions_columns == 1 || regions_columns % 2 == 0, "Invalid regions columns: ", regions_columns);
+        BN_ASSERT(regions_rows == 1 || regions_rows % 2 == 0, "Invalid regions rows: ", regions_rows);
+        BN_ASSERT(regions_columns * regions_rows == streaming_tiles.regions_count(),
+                  "Invalid regions count: ", regions_columns * regions_rows, " - ", streaming_tiles.regions_count());
+
+        _streaming_tiles_ptr = &streaming_tiles;
+    }
+
     /**
      * @brief Returns a pointer to the referenced map cells of the first map.
      */
@@ -212,6 +250,15 @@ public:
         return _big;
     }
 
+    /**
+     * @brief Returns the required information to stream the tiles of each map region,
+     * or nullptr if the tiles of this map are not streamed.
+     */
+    [[nodiscard]] constexpr const regular_bg_streaming_tiles_item* streaming_tiles_ptr() const
+    {
+        return _streaming_tiles_ptr;
+    }
+
     /**
      * @brief Returns the number of referenced maps.
      */
@@ -531,6 +578,7 @@ public:
 
 private:
     const regular_bg_map_cell* _cells_ptr;
+    const regular_bg_streaming_tiles_item* _streaming_tiles_ptr = nullptr;
     size _dimensions;
     uint16_t _maps_count;
     compression_type _compression;
@@ -452,6 +452,14 @@ public:
      */
     [[nodiscard]] compression_type compression() const;
 
+    /**
+     * @brief Indicates if the referenced map cells have been committed to VRAM.
+     *
+     * Compressed map cells can be decompressed progressively across several frames
+     * (see BN_CFG_BG_BLOCKS_DECOMPRESSION_BYTES_PER_FRAME), so they are not ready until the last chunk is written.
+     */
+    [[nodiscard]] bool ready() const;
+
     /**
      * @brief Returns the referenced map cells unless it was created with allocate or allocate_optional.
      * In that case, it returns bn::nullopt.
@@ -488,6 +496,22 @@ public:
      */
     void reload_cells_ref();
 
+    /**
+     * @brief Uploads the referenced map cells of the specified area to VRAM again
+     * to make visible the possible changes in them.
+     *
+     * Only the specified area is uploaded, so it is much faster than reloading all map cells
+     * when only a few of them have been modified.
+     *
+     * Big and compressed maps are always uploaded entirely.
+     *
+     * @param x Horizontal position of the top-left map cell of the area [0..dimensions().width()).
+     * @param y Vertical position of the top-left map cell of the area [0..dimensions().height()).
+     * @param width Width in map cells of the area.
+     * @param height Height in map cells of the area.
+     */
+    void reload_cells_ref(int x, int y, int width, int height);
+
     /**
      * @brief Returns the referenced tiles.
      */
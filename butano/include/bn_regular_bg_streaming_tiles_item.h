@@ -0,0 +1,190 @@
+/*
+ * Copyright (c) 2020-2023 Gustavo Valiente gustavo.valiente@protonmail.com
+ * zlib License, see LICENSE file.
+ */
+
+#ifndef BN_REGULAR_BG_STREAMING_TILES_ITEM_H
+#define BN_REGULAR_BG_STREAMING_TILES_ITEM_H
+
+/**
+ * @file
+ * bn::regular_bg_streaming_tiles_item header file.
+ *
+ * @ingroup regular_bg
+ * @ingroup tile
+ * @ingroup tool
+ */
+
+#include "bn_span.h"
+#include "bn_tile.h"
+#include "bn_size.h"
+#include "bn_assert.h"
+
+namespace bn
+{
+
+/**
+ * @brief Contains the required information to stream the tiles of a big regular background map.
+ *
+ * The map is split in regions, each one with its own tiles subset.
+ * The cells of each region reference the tiles of its region only.
+ *
+ * Since at most 2x2 regions can be displayed at the same time, VRAM is split in four banks of bank_tiles_count()
+ * tiles, and the tiles of each region are loaded on demand in the bank selected by its region coordinates parity.
+ *
+ * The assets conversion tools generate an object of this type in the build folder for each *.bmp file
+ * with `regular_bg` type and `streaming_region_size` field.
+ *
+ * The tiles are not copied but referenced, so they should outlive the regular_bg_streaming_tiles_item
+ * to avoid dangling references.
+ *
+ * @ingroup regular_bg
+ * @ingroup tile
+ * @ingroup tool
+ */
+class regular_bg_streaming_tiles_item
+{
+
+public:
+    /**
+     * @brief Number of VRAM tile banks used to stream the tiles of the map regions.
+     */
+    static constexpr int banks_count = 4;
+
+    /**
+     * @brief Constructor.
+     * @param tiles_ref Reference to the tiles of all regions.
+     *
+     * The tiles are not copied but referenced, so they should outlive the regular_bg_streaming_tiles_item
+     * to avoid dangling references.
+     *
+     * @param regions_first_tile_ref Reference to the index of the first tile of each region in tiles_ref,
+     * followed by the total tiles count.
+     *
+     * The indexes are not copied but referenced, so they should outlive the regular_bg_streaming_tiles_item
+     * to avoid dangling references.
+     *
+     * @param region_dimensions Size in map cells of each region.
+     * @param bank_tiles_count Number of tiles of each VRAM bank.
+     */
+    constexpr regular_bg_streaming_tiles_item(
+            const span<const tile>& tiles_ref, const span<const uint32_t>& regions_first_tile_ref,
+            const size& region_dimensions, int bank_tiles_count) :
+        _tiles_ref(tiles_ref),
+        _regions_first_tile_ref(regions_first_tile_ref),
+        _region_dimensions(region_dimensions),
+        _bank_tiles_count(bank_tiles_count)
+    {
+        BN_ASSERT(tiles_ref.size() >= bank_tiles_count * banks_count,
+                  "Invalid tiles count: ", tiles_ref.size(), " - ", bank_tiles_count * banks_count);
+        BN_ASSERT(regions_first_tile_ref.size() > 1,
+                  "Invalid regions first tile count: ", regions_first_tile_ref.size());
+        BN_ASSERT(region_dimensions.width() >= 32 && region_dimensions.width() % 32 == 0,
+                  "Invalid region width: ", region_dimensions.width());
+        BN_ASSERT(region_dimensions.height() >= 32 && region_dimensions.height() % 32 == 0,
+                  "Invalid region height: ", region_dimensions.height());
+        BN_ASSERT(bank_tiles_count > 0 && bank_tiles_count * banks_count <= 2048,
+                  "Invalid bank tiles count: ", bank_tiles_count);
+    }
+
+    /**
+     * @brief Returns the reference to the tiles of all regions.
+     *
+     * The tiles are not copied but referenced, so they should outlive the regular_bg_streaming_tiles_item
+     * to avoid dangling references.
+     */
+    [[nodiscard]] constexpr const span<const tile>& tiles_ref() const
+    {
+        return _tiles_ref;
+    }
+
+    /**
+     * @brief Returns the reference to the index of the first tile of each region in tiles_ref(),
+     * followed by the total tiles count.
+     */
+    [[nodiscard]] constexpr const span<const uint32_t>& regions_first_tile_ref() const
+    {
+        return _regions_first_tile_ref;
+    }
+
+    /**
+     * @brief Returns the number of regions.
+     */
+    [[nodiscard]] constexpr int regions_count() const
+    {
+        return _regions_first_tile_ref.size() - 1;
+    }
+
+    /**
+     * @brief Returns the size in map cells of each region.
+     */
+    [[nodiscard]] constexpr const size& region_dimensions() const
+    {
+        return _region_dimensions;
+    }
+
+    /**
+     * @brief Returns the number of tiles of each VRAM bank.
+     */
+    [[nodiscard]] constexpr int bank_tiles_count() const
+    {
+        return _bank_tiles_count;
+    }
+
+    /**
+     * @brief Returns the number of tiles required in VRAM to stream the tiles of all regions.
+     */
+    [[nodiscard]] constexpr int vram_tiles_count() const
+    {
+        return _bank_tiles_count * banks_count;
+    }
+
+    /**
+     * @brief Returns the tiles of the specified region.
+     */
+    [[nodiscard]] constexpr span<const tile> region_tiles_ref(int region_index) const
+    {
+        BN_ASSERT(region_index >= 0 && region_index < regions_count(), "Invalid region index: ", region_index);
+
+        auto first_tile = int(_regions_first_tile_ref[region_index]);
+        auto last_tile = int(_regions_first_tile_ref[region_index + 1]);
+        return _tiles_ref.subspan(first_tile, last_tile - first_tile);
+    }
+
+    /**
+     * @brief Equal operator.
+     * @param a First regular_bg_streaming_tiles_item to compare.
+     * @param b Second regular_bg_streaming_tiles_item to compare.
+     * @return `true` if the first regular_bg_streaming_tiles_item is equal to the second one, otherwise `false`.
+     */
+    [[nodiscard]] constexpr friend bool operator==(
+            const regular_bg_streaming_tiles_item& a, const regular_bg_streaming_tiles_item& b)
+    {
+        return a._tiles_ref.data() == b._tiles_ref.data() && a._tiles_ref.size() == b._tiles_ref.size() &&
+                a._regions_first_tile_ref.data() == b._regions_first_tile_ref.data() &&
+                a._region_dimensions == b._region_dimensions && a._bank_tiles_count == b._bank_tiles_count;
+    }
+
+    /**
+     * @brief Not equal operator.
+     * @param a First regular_bg_streaming_tiles_item to compare.
+     * @param b Second regular_bg_streaming_tiles_item to compare.
+     * @return `true` if the first regular_bg_streaming_tiles_item is not equal to the second one,
+     * otherwise `false`.
+     */
+    [[nodiscard]] constexpr friend bool operator!=(
+            const regular_bg_streaming_tiles_item& a, const regular_bg_streaming_tiles_item& b)
+    {
+        return ! (a == b);
+    }
+
+private:
+    span<const tile> _tiles_ref;
+    span<const uint32_t> _regions_first_tile_ref;
+    size _region_dimensions;
+    int _bank_tiles_count;
+};
+
+}
+
+#endif
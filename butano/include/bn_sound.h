@@ -14,9 +14,11 @@
  */
 
 #include "bn_sound_handle.h"
+#include "bn_fixed_point_fwd.h"
 
 namespace bn
 {
+    class camera_ptr;
     class sound_item;
 }
 
@@ -54,6 +56,23 @@ namespace bn::sound
      */
     sound_handle play(sound_item item, fixed volume, fixed speed, fixed panning);
 
+    /**
+     * @brief Plays the sound effect specified by the given sound_item
+     * with its volume and panning derived from its position relative to the given camera.
+     *
+     * Volume is attenuated with the distance to the camera (see sound::attenuation_distance),
+     * and panning goes from -1 to 1 from the left edge of the screen to the right one.
+     *
+     * Sound effects too far away from the camera are not played.
+     *
+     * @param item Specifies the sound effect to play.
+     * @param volume Volume level when the sound effect is at the camera position, in the range [0..1].
+     * @param position Position of the sound effect.
+     * @param camera Camera which hears the sound effect.
+     * @return Sound effect handle.
+     */
+    sound_handle play(sound_item item, fixed volume, const fixed_point& position, const camera_ptr& camera);
+
     /**
      * @brief Plays the sound effect specified by the given sound_item with default settings and the given priority.
      *
@@ -96,6 +115,67 @@ namespace bn::sound
      */
     sound_handle play_with_priority(int priority, sound_item item, fixed volume, fixed speed, fixed panning);
 
+    /**
+     * @brief Plays the sound effect specified by the given sound_item with the given priority
+     * and with its volume and panning derived from its position relative to the given camera.
+     *
+     * If there's playing too many sound effects at the same time,
+     * sound effects with higher priority are discarded later.
+     *
+     * Volume is attenuated with the distance to the camera (see sound::attenuation_distance),
+     * and panning goes from -1 to 1 from the left edge of the screen to the right one.
+     *
+     * Sound effects too far away from the camera are not played.
+     *
+     * @param priority Priority relative to backgrounds in the range [-32767..32767].
+     * @param item Specifies the sound effect to play.
+     * @param volume Volume level when the sound effect is at the camera position, in the range [0..1].
+     * @param position Position of the sound effect.
+     * @param camera Camera which hears the sound effect.
+     * @return Sound effect handle.
+     */
+    sound_handle play_with_priority(int priority, sound_item item, fixed volume, const fixed_point& position,
+                                    const camera_ptr& camera);
+
+    /**
+     * @brief Returns the number of sound effects which are being played currently.
+     */
+    [[nodiscard]] int active_count();
+
+    /**
+     * @brief Returns the number of frames in which the same sound effect is not played again.
+     *
+     * If a sound effect is played again before this number of frames have elapsed,
+     * it is not played and the handle of the already playing one is returned.
+     *
+     * A value of 0 means that sound effects are never deduplicated.
+     */
+    [[nodiscard]] int deduplication_frames();
+
+    /**
+     * @brief Sets the number of frames in which the same sound effect is not played again.
+     *
+     * If a sound effect is played again before this number of frames have elapsed,
+     * it is not played and the handle of the already playing one is returned.
+     *
+     * @param frames Number of frames in the range [0..65535]. A value of 0 means that sound effects
+     * are never deduplicated.
+     */
+    void set_deduplication_frames(int frames);
+
+    /**
+     * @brief Returns the distance to the camera at which sound effects played with a position can't be heard.
+     *
+     * By default, it is the screen width.
+     */
+    [[nodiscard]] fixed attenuation_distance();
+
+    /**
+     * @brief Sets the distance to the camera at which sound effects played with a position can't be heard.
+     * @param distance Attenuation distance in the range [1..4096].
+     */
+    void set_attenuation_distance(fixed distance);
+
     /**
      * @brief Stops all sound effects that are being played currently.
      */
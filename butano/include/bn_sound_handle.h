@@ -23,6 +23,8 @@ class sound_item;
 /**
  * @brief Sound effect handle.
  *
+ * Handles of sound effects which could not be played (see bn::audio::dropped_commands_count) are not active.
+ *
  * @ingroup sound
  */
 class sound_handle
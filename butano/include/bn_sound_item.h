@@ -15,10 +15,13 @@
  */
 
 #include "bn_sound_handle.h"
+#include "bn_fixed_point_fwd.h"
 
 namespace bn
 {
 
+class camera_ptr;
+
 /**
  * @brief Contains the required information to play sound effects.
  *
@@ -72,6 +75,22 @@ public:
      */
     sound_handle play(fixed volume, fixed speed, fixed panning) const;
 
+    /**
+     * @brief Plays the sound effect specified by this item
+     * with its volume and panning derived from its position relative to the given camera.
+     *
+     * Volume is attenuated with the distance to the camera (see sound::attenuation_distance),
+     * and panning goes from -1 to 1 from the left edge of the screen to the right one.
+     *
+     * Sound effects too far away from the camera are not played.
+     *
+     * @param volume Volume level when the sound effect is at the camera position, in the range [0..1].
+     * @param position Position of the sound effect.
+     * @param camera Camera which hears the sound effect.
+     * @return Sound effect handle.
+     */
+    sound_handle play(fixed volume, const fixed_point& position, const camera_ptr& camera) const;
+
     /**
      * @brief Plays the sound effect specified by this item with default settings and the given priority.
      *
@@ -111,6 +130,27 @@ public:
      */
     sound_handle play_with_priority(int priority, fixed volume, fixed speed, fixed panning) const;
 
+    /**
+     * @brief Plays the sound effect specified by this item with the given priority
+     * and with its volume and panning derived from its position relative to the given camera.
+     *
+     * If there's playing too many sound effects at the same time,
+     * sound effects with higher priority are discarded later.
+     *
+     * Volume is attenuated with the distance to the camera (see sound::attenuation_distance),
+     * and panning goes from -1 to 1 from the left edge of the screen to the right one.
+     *
+     * Sound effects too far away from the camera are not played.
+     *
+     * @param priority Priority relative to backgrounds in the range [-32767..32767].
+     * @param volume Volume level when the sound effect is at the camera position, in the range [0..1].
+     * @param position Position of the sound effect.
+     * @param camera Camera which hears the sound effect.
+     * @return Sound effect handle.
+     */
+    sound_handle play_with_priority(int priority, fixed volume, const fixed_point& position,
+                                    const camera_ptr& camera) const;
+
     /**
      * @brief Default equal operator.
      */
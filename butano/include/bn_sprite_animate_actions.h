@@ -20,6 +20,7 @@
 #include "bn_sprite_ptr.h"
 #include "bn_sprite_tiles_ptr.h"
 #include "bn_sprite_tiles_item.h"
+#include "bn_sprite_tiles_delta_item.h"
 #include "bn_sprite_animate_actions_fwd.h"
 
 namespace bn
@@ -943,6 +944,191 @@ template<typename ...Args>
                 array<uint16_t, sizeof...(Args)>{{ uint16_t(graphics_indexes)... }});
 }
 
+
+
+// delta animation
+
+class sprite_delta_animate_action
+{
+
+public:
+    /**
+     * @brief Generates a sprite_delta_animate_action which loops over the tile sets of the given
+     * sprite_tiles_delta_item only once.
+     * @param sprite sprite_ptr to copy.
+     * @param wait_updates Number of times the action must be updated before changing the tiles of the given sprite_ptr.
+     * @param delta_item sprite_tiles_delta_item which references the tile sets to use by the given sprite_ptr.
+     * @return The requested sprite_delta_animate_action.
+     */
+    [[nodiscard]] static sprite_delta_animate_action once(
+            const sprite_ptr& sprite, int wait_updates, const sprite_tiles_delta_item& delta_item)
+    {
+        return sprite_delta_animate_action(sprite, wait_updates, delta_item, false);
+    }
+
+    /**
+     * @brief Generates a sprite_delta_animate_action which loops over the tile sets of the given
+     * sprite_tiles_delta_item only once.
+     * @param sprite sprite_ptr to move.
+     * @param wait_updates Number of times the action must be updated before changing the tiles of the given sprite_ptr.
+     * @param delta_item sprite_tiles_delta_item which references the tile sets to use by the given sprite_ptr.
+     * @return The requested sprite_delta_animate_action.
+     */
+    [[nodiscard]] static sprite_delta_animate_action once(
+            sprite_ptr&& sprite, int wait_updates, const sprite_tiles_delta_item& delta_item)
+    {
+        return sprite_delta_animate_action(move(sprite), wait_updates, delta_item, false);
+    }
+
+    /**
+     * @brief Generates a sprite_delta_animate_action which loops over the tile sets of the given
+     * sprite_tiles_delta_item forever.
+     * @param sprite sprite_ptr to copy.
+     * @param wait_updates Number of times the action must be updated before changing the tiles of the given sprite_ptr.
+     * @param delta_item sprite_tiles_delta_item which references the tile sets to use by the given sprite_ptr.
+     * @return The requested sprite_delta_animate_action.
+     */
+    [[nodiscard]] static sprite_delta_animate_action forever(
+            const sprite_ptr& sprite, int wait_updates, const sprite_tiles_delta_item& delta_item)
+    {
+        return sprite_delta_animate_action(sprite, wait_updates, delta_item, true);
+    }
+
+    /**
+     * @brief Generates a sprite_delta_animate_action which loops over the tile sets of the given
+     * sprite_tiles_delta_item forever.
+     * @param sprite sprite_ptr to move.
+     * @param wait_updates Number of times the action must be updated before changing the tiles of the given sprite_ptr.
+     * @param delta_item sprite_tiles_delta_item which references the tile sets to use by the given sprite_ptr.
+     * @return The requested sprite_delta_animate_action.
+     */
+    [[nodiscard]] static sprite_delta_animate_action forever(
+            sprite_ptr&& sprite, int wait_updates, const sprite_tiles_delta_item& delta_item)
+    {
+        return sprite_delta_animate_action(move(sprite), wait_updates, delta_item, true);
+    }
+
+    sprite_delta_animate_action(const sprite_delta_animate_action& other) = delete;
+
+    sprite_delta_animate_action& operator=(const sprite_delta_animate_action& other) = delete;
+
+    /**
+     * @brief Move constructor.
+     * @param other sprite_delta_animate_action to move.
+     */
+    sprite_delta_animate_action(sprite_delta_animate_action&& other) noexcept = default;
+
+    /**
+     * @brief Move assignment operator.
+     * @param other sprite_delta_animate_action to move.
+     * @return Reference to this.
+     */
+    sprite_delta_animate_action& operator=(sprite_delta_animate_action&& other) noexcept = default;
+
+    /**
+     * @brief Changes the tile set of the given sprite_ptr when the given amount of update calls are done.
+     */
+    void update();
+
+    /**
+     * @brief Indicates if the action must not be updated anymore.
+     */
+    [[nodiscard]] bool done() const
+    {
+        return _current_graphics_index == _delta_item.graphics_count();
+    }
+
+    /**
+     * @brief Resets the action to its initial state.
+     */
+    void reset()
+    {
+        _current_graphics_index = 0;
+        _current_wait_updates = 0;
+    }
+
+    /**
+     * @brief Returns the sprite_ptr to modify.
+     */
+    [[nodiscard]] const sprite_ptr& sprite() const
+    {
+        return _sprite;
+    }
+
+    /**
+     * @brief Returns the number of times the action must be updated before changing the tiles
+     * of the given sprite_ptr.
+     */
+    [[nodiscard]] int wait_updates() const
+    {
+        return _wait_updates;
+    }
+
+    /**
+     * @brief Sets the number of times the action must be updated before changing the tiles
+     * of the given sprite_ptr.
+     */
+    void set_wait_updates(int wait_updates);
+
+    /**
+     * @brief Returns the number of times the action must be updated before the next tiles change.
+     */
+    [[nodiscard]] int next_change_updates() const
+    {
+        return _current_wait_updates;
+    }
+
+    /**
+     * @brief Returns the sprite_tiles_delta_item which references the tile sets to use by the given sprite_ptr.
+     */
+    [[nodiscard]] const sprite_tiles_delta_item& delta_item() const
+    {
+        return _delta_item;
+    }
+
+    /**
+     * @brief Returns the sprite tiles allocated for the given sprite_ptr.
+     */
+    [[nodiscard]] const sprite_tiles_ptr& tiles() const
+    {
+        return _tiles;
+    }
+
+    /**
+     * @brief Indicates if the action can be updated forever or not.
+     */
+    [[nodiscard]] bool update_forever() const
+    {
+        return _forever;
+    }
+
+    /**
+     * @brief Returns the index of the next tile set to show.
+     */
+    [[nodiscard]] int current_graphics_index() const
+    {
+        return _current_graphics_index;
+    }
+
+private:
+    sprite_ptr _sprite;
+    sprite_tiles_delta_item _delta_item;
+    sprite_tiles_ptr _tiles;
+    uint16_t _wait_updates = 0;
+    uint16_t _current_graphics_index = 0;
+    uint16_t _current_wait_updates = 0;
+    uint16_t _vram_graphics_index = 0;
+    bool _forever;
+
+    sprite_delta_animate_action(const sprite_ptr& sprite, int wait_updates, const sprite_tiles_delta_item& delta_item,
+                                bool forever);
+
+    sprite_delta_animate_action(sprite_ptr&& sprite, int wait_updates, const sprite_tiles_delta_item& delta_item,
+                                bool forever);
+
+    void _init(int wait_updates);
+};
+
 }
 
 #endif
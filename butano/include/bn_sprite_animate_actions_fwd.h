@@ -57,6 +57,19 @@ namespace bn
      */
     template<int MaxSize>
     class sprite_cached_animate_action;
+
+
+    // delta animation
+
+    /**
+     * @brief Changes the tile set of a sprite_ptr when the action is updated a given number of times,
+     * uploading only the tiles which change from one tile set to the next one.
+     *
+     * @ingroup sprite
+     * @ingroup tile
+     * @ingroup action
+     */
+    class sprite_delta_animate_action;
 }
 
 #endif
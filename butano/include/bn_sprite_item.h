@@ -14,6 +14,7 @@
  * @ingroup tool
  */
 
+#include "bn_vector_fwd.h"
 #include "bn_fixed_point.h"
 #include "bn_sprite_shape_size.h"
 #include "bn_sprite_tiles_item.h"
@@ -179,6 +180,22 @@ public:
      */
     [[nodiscard]] optional<sprite_ptr> create_sprite_optional(const fixed_point& position, int graphics_index) const;
 
+    /**
+     * @brief Creates multiple sprites using the information contained in this item.
+     * @param positions Positions of the sprites to create.
+     * @param output_sprites Destination vector where the created sprites are stored.
+     */
+    void create_sprites(const span<const fixed_point>& positions, ivector<sprite_ptr>& output_sprites) const;
+
+    /**
+     * @brief Creates multiple sprites using the information contained in this item.
+     * @param positions Positions of the sprites to create.
+     * @param graphics_index Index of the tile set to reference in tiles_item().
+     * @param output_sprites Destination vector where the created sprites are stored.
+     */
+    void create_sprites(const span<const fixed_point>& positions, int graphics_index,
+                        ivector<sprite_ptr>& output_sprites) const;
+
     /**
      * @brief Default equal operator.
      */
@@ -13,7 +13,9 @@
  * @ingroup sprite
  */
 
+#include "bn_span_fwd.h"
 #include "bn_optional.h"
+#include "bn_vector_fwd.h"
 #include "bn_fixed_point.h"
 
 namespace bn
@@ -197,6 +199,38 @@ public:
      */
     [[nodiscard]] static optional<sprite_ptr> create_optional(sprite_builder&& builder);
 
+    /**
+     * @brief Creates multiple sprites sharing the same sprite_item.
+     *
+     * The tiles and the color palette of the given sprite_item are searched or created only once.
+     *
+     * @param positions Positions of the sprites to create.
+     * @param item sprite_item containing the required information to generate the sprites.
+     * @param output_sprites Destination vector where the created sprites are stored.
+     */
+    static void create_many(const span<const fixed_point>& positions, const sprite_item& item,
+                            ivector<sprite_ptr>& output_sprites);
+
+    /**
+     * @brief Creates multiple sprites sharing the same sprite_item.
+     *
+     * The tiles and the color palette of the given sprite_item are searched or created only once.
+     *
+     * @param positions Positions of the sprites to create.
+     * @param item sprite_item containing the required information to generate the sprites.
+     * @param graphics_index Index of the tile set to reference in item.tiles_item().
+     * @param output_sprites Destination vector where the created sprites are stored.
+     */
+    static void create_many(const span<const fixed_point>& positions, const sprite_item& item, int graphics_index,
+                            ivector<sprite_ptr>& output_sprites);
+
+    /**
+     * @brief Sets the position of multiple sprites (relative to their camera, if they have one).
+     * @param sprites Sprites to move.
+     * @param positions New positions of the sprites.
+     */
+    static void set_positions(const span<sprite_ptr>& sprites, const span<const fixed_point>& positions);
+
     /**
      * @brief Copy constructor.
      * @param other sprite_ptr to copy.
@@ -602,6 +636,29 @@ public:
      */
     void put_below();
 
+    /**
+     * @brief Indicates if this sprite is sorted by its vertical position or not.
+     *
+     * Sprites with y sort enabled are drawn above the other y sorted sprites
+     * with the same background priority and z order which are higher on the screen.
+     */
+    [[nodiscard]] bool y_sort_enabled() const;
+
+    /**
+     * @brief Sets if this sprite must be sorted by its vertical position or not.
+     *
+     * Sprites with y sort enabled are drawn above the other y sorted sprites
+     * with the same background priority and z order which are higher on the screen.
+     *
+     * Only the sprites which have moved are sorted again, so it is much faster than
+     * updating the z order of each sprite every frame.
+     *
+     * Keep in mind that sprites without y sort enabled are not moved,
+     * so to get the expected results please don't mix them with y sorted sprites
+     * with the same background priority and z order.
+     */
+    void set_y_sort_enabled(bool y_sort_enabled);
+
     /**
      * @brief Indicates if this sprite is flipped in the horizontal axis or not.
      */
@@ -14,7 +14,7 @@
  * @ingroup tile
  */
 
-#include "bn_common.h"
+#include "bn_fixed.h"
 
 /**
  * @brief Sprite tiles related functions.
@@ -45,6 +45,39 @@ namespace bn::sprite_tiles
      */
     [[nodiscard]] int available_items_count();
 
+    /**
+     * @brief Returns how much the available sprite tiles are fragmented in VRAM, in the range [0..1].
+     *
+     * Zero means that all available sprite tiles are contiguous,
+     * and values close to one mean that only small tile sets can be created.
+     */
+    [[nodiscard]] fixed fragmentation();
+
+    /**
+     * @brief Returns the number of sprite tiles kept in VRAM without sprite_tiles_ptr objects referencing them.
+     *
+     * These tiles are reused if the same tile set is requested again,
+     * or removed if their space is needed by other tile sets.
+     */
+    [[nodiscard]] int cached_tiles_count();
+
+    /**
+     * @brief Returns the number of sprite tile sets which were found in VRAM after being released
+     * since the last reset_cache_counters call.
+     */
+    [[nodiscard]] int cache_hits_count();
+
+    /**
+     * @brief Returns the number of sprite tile sets which were not found in VRAM and had to be uploaded
+     * since the last reset_cache_counters call.
+     */
+    [[nodiscard]] int cache_misses_count();
+
+    /**
+     * @brief Sets cache_hits_count and cache_misses_count to zero.
+     */
+    void reset_cache_counters();
+
     /**
      * @brief Logs the current status of the sprite tiles manager.
      */
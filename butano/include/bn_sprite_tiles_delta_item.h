@@ -0,0 +1,242 @@
+/*
+ * Copyright (c) 2020-2023 Gustavo Valiente gustavo.valiente@protonmail.com
+ * zlib License, see LICENSE file.
+ */
+
+#ifndef BN_SPRITE_TILES_DELTA_ITEM_H
+#define BN_SPRITE_TILES_DELTA_ITEM_H
+
+/**
+ * @file
+ * bn::sprite_tiles_delta_item header file.
+ *
+ * @ingroup sprite
+ * @ingroup tile
+ * @ingroup tool
+ */
+
+#include "bn_sprite_tiles_item.h"
+
+namespace bn
+{
+
+/**
+ * @brief Contains the required information to animate sprite tiles by uploading only the tiles
+ * which change from one tile set to the next one.
+ *
+ * The first tile set is stored in full, and each tile set is stored as a list of runs of changed tiles
+ * with respect to the previous one. The changed tiles of the first tile set are relative to the last one,
+ * so animations can be looped.
+ *
+ * Each run is stored in 32 bits: the index of its first tile in the tile set (bits 0-7),
+ * its tiles count (bits 8-15) and the index of its first tile in tiles_ref (bits 16-31).
+ *
+ * The assets conversion tools generate an object of this type in the build folder for each *.bmp file
+ * with `sprite` type and `delta_frames` field.
+ *
+ * The tiles and the runs are not copied but referenced, so they should outlive the sprite_tiles_delta_item
+ * to avoid dangling references.
+ *
+ * @ingroup sprite
+ * @ingroup tile
+ * @ingroup tool
+ */
+class sprite_tiles_delta_item
+{
+
+public:
+    /**
+     * @brief Constructor.
+     * @param tiles_ref Reference to the tiles of the first tile set, followed by the changed tiles of all tile sets.
+     *
+     * The tiles are not copied but referenced, so they should outlive the sprite_tiles_delta_item
+     * to avoid dangling references.
+     *
+     * @param runs_ref Reference to the changed tiles runs of all tile sets.
+     *
+     * The runs are not copied but referenced, so they should outlive the sprite_tiles_delta_item
+     * to avoid dangling references.
+     *
+     * @param runs_indexes_ref Reference to the index of the first run of each tile set in runs_ref,
+     * followed by the total runs count.
+     *
+     * The indexes are not copied but referenced, so they should outlive the sprite_tiles_delta_item
+     * to avoid dangling references.
+     *
+     * @param bpp tiles_ref bits per pixel.
+     * @param tiles_count_per_graphic Number of sprite tiles contained in each sprite tile set.
+     * @param max_graphics_runs_count Maximum number of changed tiles runs of a sprite tile set.
+     */
+    constexpr sprite_tiles_delta_item(
+            const span<const tile>& tiles_ref, const span<const uint32_t>& runs_ref,
+            const span<const uint16_t>& runs_indexes_ref, bpp_mode bpp, int tiles_count_per_graphic,
+            int max_graphics_runs_count) :
+        _tiles_ref(tiles_ref),
+        _runs_ref(runs_ref),
+        _runs_indexes_ref(runs_indexes_ref),
+        _tiles_count_per_graphic(uint8_t(tiles_count_per_graphic)),
+        _max_graphics_runs_count(uint8_t(max_graphics_runs_count)),
+        _bpp(bpp)
+    {
+        BN_ASSERT(sprite_tiles_item::valid_tiles_count(tiles_count_per_graphic, bpp),
+                  "Invalid tiles count per graphic: ", tiles_count_per_graphic, " - ", int(bpp));
+        BN_ASSERT(tiles_ref.size() >= tiles_count_per_graphic,
+                  "Invalid tiles count: ", tiles_ref.size(), " - ", tiles_count_per_graphic);
+        BN_ASSERT(runs_indexes_ref.size() > 1 && runs_indexes_ref.size() <= 65536,
+                  "Invalid runs indexes count: ", runs_indexes_ref.size());
+        BN_ASSERT(runs_indexes_ref[runs_indexes_ref.size() - 1] == runs_ref.size(),
+                  "Invalid runs count: ", runs_indexes_ref[runs_indexes_ref.size() - 1], " - ", runs_ref.size());
+        BN_ASSERT(max_graphics_runs_count >= 0 && max_graphics_runs_count <= tiles_count_per_graphic &&
+                  max_graphics_runs_count <= runs_ref.size(),
+                  "Invalid max graphics runs count: ", max_graphics_runs_count, " - ", runs_ref.size());
+    }
+
+    /**
+     * @brief Returns the reference to the tiles of the first tile set,
+     * followed by the changed tiles of all tile sets.
+     */
+    [[nodiscard]] constexpr const span<const tile>& tiles_ref() const
+    {
+        return _tiles_ref;
+    }
+
+    /**
+     * @brief Returns the reference to the changed tiles runs of all tile sets.
+     */
+    [[nodiscard]] constexpr const span<const uint32_t>& runs_ref() const
+    {
+        return _runs_ref;
+    }
+
+    /**
+     * @brief Returns the reference to the index of the first run of each tile set in runs_ref(),
+     * followed by the total runs count.
+     */
+    [[nodiscard]] constexpr const span<const uint16_t>& runs_indexes_ref() const
+    {
+        return _runs_indexes_ref;
+    }
+
+    /**
+     * @brief Returns the bits per pixel of the referenced tiles.
+     */
+    [[nodiscard]] constexpr bpp_mode bpp() const
+    {
+        return _bpp;
+    }
+
+    /**
+     * @brief Returns the number of sprite tile sets.
+     */
+    [[nodiscard]] constexpr int graphics_count() const
+    {
+        return _runs_indexes_ref.size() - 1;
+    }
+
+    /**
+     * @brief Returns the number of sprite tiles contained in each sprite tile set.
+     */
+    [[nodiscard]] constexpr int tiles_count_per_graphic() const
+    {
+        return _tiles_count_per_graphic;
+    }
+
+    /**
+     * @brief Returns the maximum number of changed tiles runs of a sprite tile set.
+     *
+     * It should not be greater than BN_CFG_SPRITE_TILES_MAX_DELTA_RUNS.
+     */
+    [[nodiscard]] constexpr int max_graphics_runs_count() const
+    {
+        return _max_graphics_runs_count;
+    }
+
+    /**
+     * @brief Returns the reference to the first sprite tile set.
+     */
+    [[nodiscard]] constexpr span<const tile> graphics_tiles_ref() const
+    {
+        return span<const tile>(_tiles_ref.data(), _tiles_count_per_graphic);
+    }
+
+    /**
+     * @brief Returns the changed tiles runs of the sprite tile set indicated by graphics_index
+     * with respect to the previous one (the last one if graphics_index is 0).
+     */
+    [[nodiscard]] constexpr span<const uint32_t> graphics_runs_ref(int graphics_index) const
+    {
+        BN_ASSERT(graphics_index >= 0 && graphics_index < graphics_count(),
+                  "Invalid graphics index: ", graphics_index, " - ", graphics_count());
+
+        int first_run = _runs_indexes_ref[graphics_index];
+        int last_run = _runs_indexes_ref[graphics_index + 1];
+        return _runs_ref.subspan(first_run, last_run - first_run);
+    }
+
+    /**
+     * @brief Returns a sprite_tiles_item which references the first sprite tile set.
+     */
+    [[nodiscard]] constexpr sprite_tiles_item tiles_item() const
+    {
+        return sprite_tiles_item(graphics_tiles_ref(), _bpp);
+    }
+
+    /**
+     * @brief Allocates a new sprite_tiles_ptr and uploads the first sprite tile set to it.
+     *
+     * The new sprite_tiles_ptr is not shared with other sprite_tiles_delta_item objects,
+     * so the changed tiles of the other sprite tile sets can be applied to it
+     * with sprite_tiles_ptr::apply_tiles_delta.
+     *
+     * @return The new sprite_tiles_ptr.
+     */
+    [[nodiscard]] sprite_tiles_ptr create_tiles() const;
+
+    /**
+     * @brief Allocates a new sprite_tiles_ptr and uploads the first sprite tile set to it.
+     *
+     * The new sprite_tiles_ptr is not shared with other sprite_tiles_delta_item objects,
+     * so the changed tiles of the other sprite tile sets can be applied to it
+     * with sprite_tiles_ptr::apply_tiles_delta.
+     *
+     * @return The new sprite_tiles_ptr if it could be allocated; bn::nullopt otherwise.
+     */
+    [[nodiscard]] optional<sprite_tiles_ptr> create_tiles_optional() const;
+
+    /**
+     * @brief Equal operator.
+     * @param a First sprite_tiles_delta_item to compare.
+     * @param b Second sprite_tiles_delta_item to compare.
+     * @return `true` if the first sprite_tiles_delta_item is equal to the second one, otherwise `false`.
+     */
+    [[nodiscard]] constexpr friend bool operator==(const sprite_tiles_delta_item& a,
+                                                   const sprite_tiles_delta_item& b)
+    {
+        return a._tiles_ref.data() == b._tiles_ref.data() && a._tiles_ref.size() == b._tiles_ref.size() &&
+                a._runs_ref.data() == b._runs_ref.data() && a._runs_indexes_ref.data() == b._runs_indexes_ref.data();
+    }
+
+    /**
+     * @brief Not equal operator.
+     * @param a First sprite_tiles_delta_item to compare.
+     * @param b Second sprite_tiles_delta_item to compare.
+     * @return `true` if the first sprite_tiles_delta_item is not equal to the second one, otherwise `false`.
+     */
+    [[nodiscard]] constexpr friend bool operator!=(const sprite_tiles_delta_item& a,
+                                                   const sprite_tiles_delta_item& b)
+    {
+        return ! (a == b);
+    }
+
+private:
+    span<const tile> _tiles_ref;
+    span<const uint32_t> _runs_ref;
+    span<const uint16_t> _runs_indexes_ref;
+    uint8_t _tiles_count_per_graphic;
+    uint8_t _max_graphics_runs_count;
+    bpp_mode _bpp;
+};
+
+}
+
+#endif
@@ -22,6 +22,7 @@ namespace bn
 
 class tile;
 class sprite_tiles_item;
+class sprite_tiles_delta_item;
 enum class bpp_mode : uint8_t;
 enum class compression_type : uint8_t;
 
@@ -217,6 +218,14 @@ public:
      */
     [[nodiscard]] compression_type compression() const;
 
+    /**
+     * @brief Indicates if the referenced tiles have been committed to VRAM.
+     *
+     * Compressed tiles can be decompressed progressively across several frames
+     * (see BN_CFG_SPRITE_TILES_DECOMPRESSION_BYTES_PER_FRAME), so they are not ready until the last chunk is written.
+     */
+    [[nodiscard]] bool ready() const;
+
     /**
      * @brief Returns the referenced tiles unless it was created with allocate or allocate_optional.
      * In that case, it returns bn::nullopt.
@@ -255,6 +264,29 @@ public:
      */
     void reload_tiles_ref();
 
+    /**
+     * @brief Uploads the first tile set of the given sprite_tiles_delta_item to VRAM.
+     *
+     * The tiles must have been created with allocate or allocate_optional.
+     *
+     * @param delta_item sprite_tiles_delta_item which references the tiles to upload.
+     */
+    void reload_tiles_delta(const sprite_tiles_delta_item& delta_item);
+
+    /**
+     * @brief Uploads to VRAM the tiles of the given tile set which are different from the previous one
+     * (the last one if graphics_index is 0).
+     *
+     * The tiles must have been created with allocate or allocate_optional, and they must contain
+     * the previous tile set, so only the changed tiles are uploaded.
+     *
+     * Tiles are uploaded in the next VBlank, in the same order in which this method is called.
+     *
+     * @param delta_item sprite_tiles_delta_item which references the tiles to upload.
+     * @param graphics_index Index of the tile set to upload.
+     */
+    void apply_tiles_delta(const sprite_tiles_delta_item& delta_item, int graphics_index);
+
     /**
      * @brief Returns the allocated memory in VRAM
      * if this sprite_tiles_ptr was created with allocate or allocate_optional; bn::nullopt otherwise.
@@ -13,6 +13,7 @@
  * @ingroup sprite
  */
 
+#include "bn_config_sprites.h"
 #include "../hw/include/bn_hw_sprites_constants.h"
 
 /**
@@ -106,6 +107,36 @@ namespace bn::sprites
      */
     void set_reserved_handles_count(int reserved_handles_count);
 
+    /**
+     * @brief Returns the number of bytes copied to OAM in the last commit.
+     *
+     * Only modified hardware sprite handles are copied to OAM, so it can be used to measure
+     * how much VBlank time is spent updating sprites.
+     */
+    [[nodiscard]] int last_committed_bytes();
+
+    /**
+     * @brief Returns the number of vertical bands in which the screen is divided to multiplex sprites.
+     *
+     * See BN_CFG_SPRITES_MULTIPLEXER_HANDLES and BN_CFG_SPRITES_MULTIPLEXER_BANDS.
+     */
+    [[nodiscard]] constexpr int multiplexer_bands_count()
+    {
+        return BN_CFG_SPRITES_MULTIPLEXER_BANDS;
+    }
+
+    /**
+     * @brief Returns the number of sprites multiplexed in the given vertical band of the screen
+     * in the last update.
+     *
+     * Sprites are multiplexed only if they don't fit in the hardware sprite handles
+     * not reserved by BN_CFG_SPRITES_MULTIPLEXER_HANDLES.
+     *
+     * @param band Vertical band index in the range [0..multiplexer_bands_count() - 1].
+     * @return Number of multiplexed sprites in the given band, in the range [0..BN_CFG_SPRITES_MULTIPLEXER_HANDLES].
+     */
+    [[nodiscard]] int multiplexed_items_count(int band);
+
     /**
      * @brief Reloads the internal attributes of all sprites (including the reserved ones).
      *
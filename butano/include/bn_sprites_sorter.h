@@ -0,0 +1,45 @@
+/*
+ * Copyright (c) 2020-2023 Gustavo Valiente gustavo.valiente@protonmail.com
+ * zlib License, see LICENSE file.
+ */
+
+#ifndef BN_SPRITES_SORTER_H
+#define BN_SPRITES_SORTER_H
+
+/**
+ * @file
+ * Available sprites sorters header file.
+ *
+ * @ingroup sprite
+ */
+
+#include "bn_common.h"
+
+/**
+ * @def BN_SPRITES_SORTER_LAYERS
+ *
+ * Sprites are grouped in layers depending of their background priority and z order.
+ *
+ * Inserting a sprite requires a linear search over the used layers,
+ * and the number of used layers is limited by BN_CFG_SPRITES_MAX_SORT_LAYERS.
+ *
+ * @ingroup sprite
+ */
+#define BN_SPRITES_SORTER_LAYERS    0
+
+/**
+ * @def BN_SPRITES_SORTER_RADIX
+ *
+ * Sprites are stored in a flat array sorted by background priority and z order.
+ *
+ * Inserting a sprite takes constant time, and sprites with modified background priority or z order
+ * are sorted with a single radix sort pass the next time the sprites are updated.
+ *
+ * There's no limit on the number of unique z orders, so it is a better fit for scenes
+ * which change the z order of lots of sprites each frame.
+ *
+ * @ingroup sprite
+ */
+#define BN_SPRITES_SORTER_RADIX     1
+
+#endif
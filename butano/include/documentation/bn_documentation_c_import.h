@@ -98,26 +98,39 @@
  *   * `"bpp_8"`: up to 256 colors.
  *   * `"bpp_4"`: up to 16 colors.
  * * `"colors_count"`: optional field which specifies the sprite palette size [1..256].
+ * * `"delta_frames"`: optional field which specifies if only the first sprite image and the tiles
+ * which change from one sprite image to the next one must be stored (`false` by default).
+ * If it is `true`, a bn::sprite_tiles_delta_item is generated too, and the generated bn::sprite_item
+ * references the first sprite image only. Tiles compression is not supported with this field.
+ * * `"delta_frames_max_runs"`: optional field which specifies the maximum number of changed tiles runs
+ * of each sprite image if `"delta_frames"` is `true` (`32` by default). The nearest runs are joined until they fit,
+ * and it must not be greater than @ref BN_CFG_SPRITE_TILES_MAX_DELTA_RUNS.
  * * `"tiles_compression"`: optional field which specifies the compression of the tiles data:
  *   * `"none"`: uncompressed data (this is the default option).
  *   * `"lz77"`: LZ77 compressed data.
  *   * `"run_length"`: run-length compressed data.
  *   * `"huffman"`: Huffman compressed data.
- *   * `"auto"`: uses the option which gives the smallest data size.
+ *   * `"fast_lz"`: fast LZ compressed data (bigger than LZ77, but faster to decompress).
+ *   * `"auto"`: uses the option which gives the smallest data size
+ *     (fast LZ is preferred if it is not much bigger than LZ77 or Huffman, nor bigger than the uncompressed data).
  *   * `"auto_no_huffman"`: uses the option which gives the smallest data size, excluding "huffman".
  * * `"palette_compression"`: optional field which specifies the compression of the colors data:
  *   * `"none"`: uncompressed data (this is the default option).
  *   * `"lz77"`: LZ77 compressed data.
  *   * `"run_length"`: run-length compressed data.
  *   * `"huffman"`: Huffman compressed data.
- *   * `"auto"`: uses the option which gives the smallest data size.
+ *   * `"fast_lz"`: fast LZ compressed data (bigger than LZ77, but faster to decompress).
+ *   * `"auto"`: uses the option which gives the smallest data size
+ *     (fast LZ is preferred if it is not much bigger than LZ77 or Huffman, nor bigger than the uncompressed data).
  *   * `"auto_no_huffman"`: uses the option which gives the smallest data size, excluding "huffman".
  * * `"compression"`: optional field which specifies the compression of the tiles and the colors data:
  *   * `"none"`: uncompressed data (this is the default option).
  *   * `"lz77"`: LZ77 compressed data.
  *   * `"run_length"`: run-length compressed data.
  *   * `"huffman"`: Huffman compressed data.
- *   * `"auto"`: uses the option which gives the smallest data size.
+ *   * `"fast_lz"`: fast LZ compressed data (bigger than LZ77, but faster to decompress).
+ *   * `"auto"`: uses the option which gives the smallest data size
+ *     (fast LZ is preferred if it is not much bigger than LZ77 or Huffman, nor bigger than the uncompressed data).
  *   * `"auto_no_huffman"`: uses the option which gives the smallest data size, excluding "huffman".
  *
  * If the conversion process has finished successfully,
@@ -134,6 +147,13 @@
  * bn::sprite_ptr sprite = bn::sprite_items::image.create_sprite(0, 0);
  * @endcode
  *
+ * If the `"delta_frames"` field is `true`, the sprite can be animated with bn::sprite_delta_animate_action:
+ *
+ * @code{.cpp}
+ * bn::sprite_delta_animate_action action = bn::sprite_delta_animate_action::forever(
+ *         sprite, 4, bn::sprite_tiles_delta_items::image);
+ * @endcode
+ *
  *
  * @subsection import_sprite_tiles Sprite tiles
  *
@@ -166,7 +186,9 @@
  *   * `"lz77"`: LZ77 compressed data.
  *   * `"run_length"`: run-length compressed data.
  *   * `"huffman"`: Huffman compressed data.
- *   * `"auto"`: uses the option which gives the smallest data size.
+ *   * `"fast_lz"`: fast LZ compressed data (bigger than LZ77, but faster to decompress).
+ *   * `"auto"`: uses the option which gives the smallest data size
+ *     (fast LZ is preferred if it is not much bigger than LZ77 or Huffman, nor bigger than the uncompressed data).
  *   * `"auto_no_huffman"`: uses the option which gives the smallest data size, excluding "huffman".
  *
  * If the conversion process has finished successfully,
@@ -205,7 +227,9 @@
  *   * `"lz77"`: LZ77 compressed data.
  *   * `"run_length"`: run-length compressed data.
  *   * `"huffman"`: Huffman compressed data.
- *   * `"auto"`: uses the option which gives the smallest data size.
+ *   * `"fast_lz"`: fast LZ compressed data (bigger than LZ77, but faster to decompress).
+ *   * `"auto"`: uses the option which gives the smallest data size
+ *     (fast LZ is preferred if it is not much bigger than LZ77 or Huffman, nor bigger than the uncompressed data).
  *   * `"auto_no_huffman"`: uses the option which gives the smallest data size, excluding "huffman".
  *
  * If the conversion process has finished successfully,
@@ -262,35 +286,57 @@
  * (`true` by default).
  * * `"big"`: optional boolean field which specifies if maps generated with this item are big or not.
  *    If this field is omitted, big maps are generated only if needed.
+ * * `"streaming_region_size"`: optional field which specifies the size in pixels of the regions of a big map
+ *    (it must be divisible by 256). Each region references its own tiles subset, which is loaded in VRAM
+ *    only when the region is near the visible area, so big maps with more than 1024 different tiles are supported
+ *    (see bn::regular_bg_streaming_tiles_item).
+ * * `"tiles_group"`: optional field which specifies the name of a tiles group shared with other regular backgrounds.
+ *    The tiles of all regular backgrounds of a group are stored in a shared bn::regular_bg_tiles_item
+ *    without repeated and flipped tiles, so backgrounds displayed at the same time (like parallax layers)
+ *    use the same tiles in VRAM. All regular backgrounds of a group must have the same BPP mode,
+ *    and their tiles are not compressed.
+ *    Streaming regions and Huffman compressed maps are not supported.
  * * `"tiles_compression"`: optional field which specifies the compression of the tiles data:
  *   * `"none"`: uncompressed data (this is the default option).
  *   * `"lz77"`: LZ77 compressed data.
  *   * `"run_length"`: run-length compressed data.
  *   * `"huffman"`: Huffman compressed data.
- *   * `"auto"`: uses the option which gives the smallest data size.
+ *   * `"fast_lz"`: fast LZ compressed data (bigger than LZ77, but faster to decompress).
+ *   * `"auto"`: uses the option which gives the smallest data size
+ *     (fast LZ is preferred if it is not much bigger than LZ77 or Huffman, nor bigger than the uncompressed data).
  *   * `"auto_no_huffman"`: uses the option which gives the smallest data size, excluding "huffman".
  * * `"palette_compression"`: optional field which specifies the compression of the colors data:
  *   * `"none"`: uncompressed data (this is the default option).
  *   * `"lz77"`: LZ77 compressed data.
  *   * `"run_length"`: run-length compressed data.
  *   * `"huffman"`: Huffman compressed data.
- *   * `"auto"`: uses the option which gives the smallest data size.
+ *   * `"fast_lz"`: fast LZ compressed data (bigger than LZ77, but faster to decompress).
+ *   * `"auto"`: uses the option which gives the smallest data size
+ *     (fast LZ is preferred if it is not much bigger than LZ77 or Huffman, nor bigger than the uncompressed data).
  *   * `"auto_no_huffman"`: uses the option which gives the smallest data size, excluding "huffman".
  * * `"map_compression"`: optional field which specifies the compression of the map data:
  *   * `"none"`: uncompressed data (this is the default option).
  *   * `"lz77"`: LZ77 compressed data.
  *   * `"run_length"`: run-length compressed data.
  *   * `"huffman"`: Huffman compressed data.
- *   * `"auto"`: uses the option which gives the smallest data size.
+ *   * `"fast_lz"`: fast LZ compressed data (bigger than LZ77, but faster to decompress).
+ *   * `"auto"`: uses the option which gives the smallest data size
+ *     (fast LZ is preferred if it is not much bigger than LZ77 or Huffman, nor bigger than the uncompressed data).
  *   * `"auto_no_huffman"`: uses the option which gives the smallest data size, excluding "huffman".
  * * `"compression"`: optional field which specifies the compression of the tiles, the colors and the map data:
  *   * `"none"`: uncompressed data (this is the default option).
  *   * `"lz77"`: LZ77 compressed data.
  *   * `"run_length"`: run-length compressed data.
  *   * `"huffman"`: Huffman compressed data.
- *   * `"auto"`: uses the option which gives the smallest data size.
+ *   * `"fast_lz"`: fast LZ compressed data (bigger than LZ77, but faster to decompress).
+ *   * `"auto"`: uses the option which gives the smallest data size
+ *     (fast LZ is preferred if it is not much bigger than LZ77 or Huffman, nor bigger than the uncompressed data).
  *   * `"auto_no_huffman"`: uses the option which gives the smallest data size, excluding "huffman".
  *
+ * Compressed big maps are split in 8x8 cells chunks which are decompressed on demand
+ * (Huffman compression is not supported).
+ * They can be displayed only if @ref BN_CFG_BG_BLOCKS_BIG_MAP_CHUNKS is greater than zero.
+ *
  * If the conversion process has finished successfully,
  * a bn::regular_bg_item should have been generated in the `build` folder.
  *
@@ -305,6 +351,10 @@
  * bn::regular_bg_ptr regular_bg = bn::regular_bg_items::image.create_bg(0, 0);
  * @endcode
  *
+ * The tiles of a tiles group named `layers` are generated in a header file named `bn_regular_bg_tiles_items_layers.h`
+ * (a bn::regular_bg_tiles_item named `bn::regular_bg_tiles_items::layers`), which is included by the
+ * headers of the regular backgrounds of the group.
+ *
  *
  * @subsection import_regular_bg_tiles Regular background tiles
  *
@@ -330,7 +380,9 @@
  *   * `"lz77"`: LZ77 compressed data.
  *   * `"run_length"`: run-length compressed data.
  *   * `"huffman"`: Huffman compressed data.
- *   * `"auto"`: uses the option which gives the smallest data size.
+ *   * `"fast_lz"`: fast LZ compressed data (bigger than LZ77, but faster to decompress).
+ *   * `"auto"`: uses the option which gives the smallest data size
+ *     (fast LZ is preferred if it is not much bigger than LZ77 or Huffman, nor bigger than the uncompressed data).
  *   * `"auto_no_huffman"`: uses the option which gives the smallest data size, excluding "huffman".
  * * `"generate_palette"`: optional field which specifies if a background palette must be generated (`false` by default).
  * * `"palette_colors_count"`: optional field which specifies the background palette size [1..256].
@@ -339,7 +391,9 @@
  *   * `"lz77"`: LZ77 compressed data.
  *   * `"run_length"`: run-length compressed data.
  *   * `"huffman"`: Huffman compressed data.
- *   * `"auto"`: uses the option which gives the smallest data size.
+ *   * `"fast_lz"`: fast LZ compressed data (bigger than LZ77, but faster to decompress).
+ *   * `"auto"`: uses the option which gives the smallest data size
+ *     (fast LZ is preferred if it is not much bigger than LZ77 or Huffman, nor bigger than the uncompressed data).
  *   * `"auto_no_huffman"`: uses the option which gives the smallest data size, excluding "huffman".
  *
  * If the conversion process has finished successfully,
@@ -386,28 +440,36 @@
  *   * `"lz77"`: LZ77 compressed data.
  *   * `"run_length"`: run-length compressed data.
  *   * `"huffman"`: Huffman compressed data.
- *   * `"auto"`: uses the option which gives the smallest data size.
+ *   * `"fast_lz"`: fast LZ compressed data (bigger than LZ77, but faster to decompress).
+ *   * `"auto"`: uses the option which gives the smallest data size
+ *     (fast LZ is preferred if it is not much bigger than LZ77 or Huffman, nor bigger than the uncompressed data).
  *   * `"auto_no_huffman"`: uses the option which gives the smallest data size, excluding "huffman".
  * * `"palette_compression"`: optional field which specifies the compression of the colors data:
  *   * `"none"`: uncompressed data (this is the default option).
  *   * `"lz77"`: LZ77 compressed data.
  *   * `"run_length"`: run-length compressed data.
  *   * `"huffman"`: Huffman compressed data.
- *   * `"auto"`: uses the option which gives the smallest data size.
+ *   * `"fast_lz"`: fast LZ compressed data (bigger than LZ77, but faster to decompress).
+ *   * `"auto"`: uses the option which gives the smallest data size
+ *     (fast LZ is preferred if it is not much bigger than LZ77 or Huffman, nor bigger than the uncompressed data).
  *   * `"auto_no_huffman"`: uses the option which gives the smallest data size, excluding "huffman".
  * * `"map_compression"`: optional field which specifies the compression of the map data:
  *   * `"none"`: uncompressed data (this is the default option).
  *   * `"lz77"`: LZ77 compressed data.
  *   * `"run_length"`: run-length compressed data.
  *   * `"huffman"`: Huffman compressed data.
- *   * `"auto"`: uses the option which gives the smallest data size.
+ *   * `"fast_lz"`: fast LZ compressed data (bigger than LZ77, but faster to decompress).
+ *   * `"auto"`: uses the option which gives the smallest data size
+ *     (fast LZ is preferred if it is not much bigger than LZ77 or Huffman, nor bigger than the uncompressed data).
  *   * `"auto_no_huffman"`: uses the option which gives the smallest data size, excluding "huffman".
  * * `"compression"`: optional field which specifies the compression of the tiles, the colors and the map data:
  *   * `"none"`: uncompressed data (this is the default option).
  *   * `"lz77"`: LZ77 compressed data.
  *   * `"run_length"`: run-length compressed data.
  *   * `"huffman"`: Huffman compressed data.
- *   * `"auto"`: uses the option which gives the smallest data size.
+ *   * `"fast_lz"`: fast LZ compressed data (bigger than LZ77, but faster to decompress).
+ *   * `"auto"`: uses the option which gives the smallest data size
+ *     (fast LZ is preferred if it is not much bigger than LZ77 or Huffman, nor bigger than the uncompressed data).
  *   * `"auto_no_huffman"`: uses the option which gives the smallest data size, excluding "huffman".
  *
  * If the conversion process has finished successfully,
@@ -444,7 +506,9 @@
  *   * `"lz77"`: LZ77 compressed data.
  *   * `"run_length"`: run-length compressed data.
  *   * `"huffman"`: Huffman compressed data.
- *   * `"auto"`: uses the option which gives the smallest data size.
+ *   * `"fast_lz"`: fast LZ compressed data (bigger than LZ77, but faster to decompress).
+ *   * `"auto"`: uses the option which gives the smallest data size
+ *     (fast LZ is preferred if it is not much bigger than LZ77 or Huffman, nor bigger than the uncompressed data).
  *   * `"auto_no_huffman"`: uses the option which gives the smallest data size, excluding "huffman".
  * * `"generate_palette"`: optional field which specifies if a background palette must be generated (`false` by default).
  * * `"palette_colors_count"`: optional field which specifies the background palette size [1..256].
@@ -453,7 +517,9 @@
  *   * `"lz77"`: LZ77 compressed data.
  *   * `"run_length"`: run-length compressed data.
  *   * `"huffman"`: Huffman compressed data.
- *   * `"auto"`: uses the option which gives the smallest data size.
+ *   * `"fast_lz"`: fast LZ compressed data (bigger than LZ77, but faster to decompress).
+ *   * `"auto"`: uses the option which gives the smallest data size
+ *     (fast LZ is preferred if it is not much bigger than LZ77 or Huffman, nor bigger than the uncompressed data).
  *   * `"auto_no_huffman"`: uses the option which gives the smallest data size, excluding "huffman".
  *
  * If the conversion process has finished successfully,
@@ -493,7 +559,9 @@
  *   * `"lz77"`: LZ77 compressed data.
  *   * `"run_length"`: run-length compressed data.
  *   * `"huffman"`: Huffman compressed data.
- *   * `"auto"`: uses the option which gives the smallest data size.
+ *   * `"fast_lz"`: fast LZ compressed data (bigger than LZ77, but faster to decompress).
+ *   * `"auto"`: uses the option which gives the smallest data size
+ *     (fast LZ is preferred if it is not much bigger than LZ77 or Huffman, nor bigger than the uncompressed data).
  *   * `"auto_no_huffman"`: uses the option which gives the smallest data size, excluding "huffman".
  *
  * If the conversion process has finished successfully,
@@ -594,6 +662,46 @@
  * If it sounds too quiet for you, you can change it via bn::dmg_music::set_master_volume.
  *
  *
+ * @subsection import_adpcm_music ADPCM music
+ *
+ * Music which can't be converted to a module file can be streamed from ROM as 4-bit IMA ADPCM instead.
+ *
+ * To do it, put a waveform audio file (a file with `*.wav` extension) into the `audio` folder
+ * and accompany it with a `*.json` file with the same name. 8-bit and 16-bit files are supported,
+ * and stereo files are mixed down to mono.
+ *
+ * An example of the `*.json` files for ADPCM music is the following:
+ *
+ * @code{.json}
+ * {
+ *     "type": "adpcm_music",
+ *     "sample_rate": 15768
+ * }
+ * @endcode
+ *
+ * Available fields are the following:
+ * * `"type"`: required field which must be `"adpcm_music"`.
+ * * `"sample_rate"`: optional field which specifies the sample rate in Hz of the generated stream.
+ * By default it is the lowest of the waveform audio file sample rate and the mixing rate
+ * specified by @ref BN_CFG_AUDIO_MIXING_RATE (see @ref import_audio_report).
+ * Sample rates higher than the mixing rate (see bn::audio::mixing_rate) waste ROM and CPU.
+ *
+ * If the conversion process has finished successfully,
+ * a bn::adpcm_music_item should have been generated in the `build` folder.
+ *
+ * For example, from a file named `song.wav`,
+ * a header file named `bn_adpcm_music_items_song.h` is generated in the `build` folder.
+ *
+ * You can use this header to play the stream with only one line of C++ code:
+ *
+ * @code{.cpp}
+ * #include "bn_adpcm_music_items_song.h"
+ *
+ * bn::adpcm_music_items::song.play();
+ * @endcode
+ *
+ * ADPCM music takes half a byte per sample, so a minute at 15768 Hz takes around 462KB of ROM.
+ *
  * @subsection import_sound Sound effects
  *
  * The required format for sound effects is waveform audio files (files with `*.wav` extension)
@@ -611,6 +719,33 @@
  *
  * bn::sound_items::sfx.play();
  * @endcode
+ *
+ *
+ * @subsection import_audio_report Audio report
+ *
+ * Each time the audio files are processed, a report named `_bn_audio_report.json` is generated in the `build` folder.
+ * It contains the following information for each music, sound effect and ADPCM music file:
+ * * Size in the soundbank (samples are stored as 8-bit mono) or in ROM (ADPCM music).
+ * * Number of channels.
+ * * Sample rate of each sample and its ratio to the mixing rate.
+ * * Warnings for samples with a sample rate higher than the mixing rate, since they could be resampled
+ * to save ROM without losing quality, and for music with more channels than @ref BN_CFG_AUDIO_MAX_MUSIC_CHANNELS.
+ *
+ * @ref BN_CFG_AUDIO_MIXING_RATE and @ref BN_CFG_AUDIO_MAX_MUSIC_CHANNELS values are read from the `USERFLAGS`
+ * variable of your project's `Makefile`:
+ *
+ * @code{.mk}
+ * USERFLAGS := -DBN_CFG_AUDIO_MIXING_RATE=BN_AUDIO_MIXING_RATE_21_KHZ -DBN_CFG_AUDIO_MAX_MUSIC_CHANNELS=8
+ * @endcode
+ *
+ * Sound effects with a sample rate higher than the mixing rate can be resampled to it automatically
+ * before being added to the soundbank by adding the following line to your project's `Makefile`:
+ *
+ * @code{.mk}
+ * AUDIORESAMPLE := true
+ * @endcode
+ *
+ * Samples of module files are not resampled.
  */
 
 #endif
@@ -20,6 +20,73 @@
  *   and bn::sprite_palette_ptr::set_rotate_range added.
  * * bn::fixed::modulo added.
  * * GCC14 false build warnings in Butano Fighter fixed.
+ * * Radix sprites sorter added. It can be enabled with @ref BN_CFG_SPRITES_SORTER.
+ * * bn::sprite_ptr::y_sort_enabled and bn::sprite_ptr::set_y_sort_enabled added.
+ * * More than 128 sprites can be displayed with HDMA sprite multiplexing.
+ *   It can be enabled with @ref BN_CFG_SPRITES_MULTIPLEXER_HANDLES.
+ * * bn::sprites::multiplexer_bands_count and bn::sprites::multiplexed_items_count added.
+ * * Only modified sprite handles are copied to OAM.
+ * * bn::sprites::last_committed_bytes added.
+ * * bn::sprite_ptr::create_many, bn::sprite_ptr::set_positions and bn::sprite_item::create_sprites added.
+ * * bn::particle_system added: a structure-of-arrays particle system which writes its particles directly
+ *   to reserved hardware sprite handles.
+ * * Sprites attached to a camera can be indexed by a spatial grid to speed up camera updates.
+ *   It can be enabled with @ref BN_CFG_SPRITES_CULLING_GRID_ENABLED.
+ * * Released sprite tile sets can be kept in VRAM until their space is needed.
+ *   It can be enabled with @ref BN_CFG_SPRITE_TILES_CACHE_ENABLED.
+ * * bn::sprite_tiles::cached_tiles_count, bn::sprite_tiles::cache_hits_count,
+ *   bn::sprite_tiles::cache_misses_count and bn::sprite_tiles::reset_cache_counters added.
+ * * Sprite tiles can be moved in VRAM to reduce its fragmentation.
+ *   It can be enabled with @ref BN_CFG_SPRITE_TILES_DEFRAG_MAX_TILES.
+ * * bn::sprite_tiles::fragmentation added.
+ * * bn::core::last_frame_stats and bn::core::last_frame_stats_count added: timer ticks spent in each engine phase
+ *   of the last frames are always stored (see @ref BN_CFG_CORE_MAX_FRAME_STATS).
+ * * Compressed big regular maps supported: they are split in chunks which are decompressed on demand
+ *   (see @ref BN_CFG_BG_BLOCKS_BIG_MAP_CHUNKS).
+ * * bn::regular_bg_streaming_tiles_item added: big regular maps can be split in regions
+ *   with their own tiles, which are loaded on demand.
+ * * bn::regular_bg_map_ptr::reload_cells_ref can upload only the map cells of a given area.
+ * * bn::bg_maps::last_committed_bytes added.
+ * * Regular and affine background maps commit speed improved when tiles or palette offsets are applied,
+ *   even if the source data and VRAM are not word aligned.
+ * * Big regular background maps column updates speed improved.
+ * * Background tiles and maps can be moved in VRAM to reduce its fragmentation.
+ *   It can be enabled with @ref BN_CFG_BG_BLOCKS_DEFRAG_MAX_BLOCKS.
+ * * bn::bg_tiles::fragmentation and bn::bg_maps::fragmentation added.
+ * * Compressed tiles and maps can be decompressed progressively across several frames with
+ *   @ref BN_CFG_BG_BLOCKS_DECOMPRESSION_BYTES_PER_FRAME and @ref BN_CFG_SPRITE_TILES_DECOMPRESSION_BYTES_PER_FRAME.
+ * * `ready()` method added to tiles and map pointers.
+ * * Run-length decompression is much faster.
+ * * GBA BIOS decompression routines can be used instead of the IWRAM ones with
+ *   @ref BN_CFG_DECOMPRESSION_BIOS_ENABLED.
+ * * Fast LZ compression added (bn::compression_type::FAST_LZ). It gives bigger data than LZ77,
+ *   but it can be decompressed much faster.
+ * * `"auto"` compression prefers fast LZ if it is not much bigger than LZ77 or Huffman.
+ * * bn::sprite_tiles_delta_item and bn::sprite_delta_animate_action added: sprite animations can be stored
+ *   and uploaded as the tiles which change from one frame to the next one.
+ * * Regular backgrounds can share their tiles with the `"tiles_group"` import field:
+ *   repeated and flipped tiles are removed across all backgrounds of a group, which use the same tiles in VRAM.
+ * * bn::audio::last_mixing_ticks and bn::audio::last_mixing_usage added.
+ * * Direct Sound mixing rate and the maximum number of mixed channels can be reduced at runtime
+ *   with bn::audio::set_mixing_rate and bn::audio::set_max_channels.
+ * * Audio commands are stored in a ring buffer and repeated setter commands are merged,
+ *   so the default @ref BN_CFG_AUDIO_MAX_COMMANDS value has been increased to 64 and it must be a power of two.
+ * * Sound effects play, speed and panning commands which don't fit in the audio commands list are dropped
+ *   instead of raising an error.
+ * * bn::audio::coalesced_commands_count, bn::audio::dropped_commands_count
+ *   and bn::audio::reset_commands_counters added.
+ * * When there are too many sound effects, the quietest of the lowest priority ones is stopped,
+ *   and new sound effects with lower priority than all active ones are not played.
+ * * The same sound effect can be deduplicated when played repeatedly (see bn::sound::set_deduplication_frames).
+ * * Sound effects volume and panning can be derived from their position relative to a camera.
+ * * bn::sound::active_count added.
+ * * Sound effects with zero volume are not played.
+ * * Sound effect handles erasure from the internal sounds queue fixed.
+ * * ADPCM music added: waveform audio files can be streamed from ROM as 4-bit IMA ADPCM
+ *   and played with bn::adpcm_music alongside module music (see @ref import_adpcm_music).
+ * * Audio assets tool generates a report with the size, channels count and sample rates of each audio file,
+ *   warning about samples above the mixing rate (see @ref import_audio_report).
+ * * Sound effects can be resampled to the mixing rate when they are imported.
  *
  *
  * @section changelog_17_5_0 17.5.0
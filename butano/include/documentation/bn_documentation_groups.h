@@ -188,6 +188,15 @@
  * @ingroup audio
  */
 
+/**
+ * @defgroup adpcm_music ADPCM music
+ *
+ * Waveform audio files (files with `*.wav` extension) encoded to 4-bit IMA ADPCM,
+ * streamed from ROM and mixed with the output of <a href="https://maxmod.devkitpro.org/">Maxmod</a>.
+ *
+ * @ingroup audio
+ */
+
 /**
  * @defgroup sound Sound effects
  *
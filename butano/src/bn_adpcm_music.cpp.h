@@ -0,0 +1,75 @@
+/*
+ * Copyright (c) 2020-2023 Gustavo Valiente gustavo.valiente@protonmail.com
+ * zlib License, see LICENSE file.
+ */
+
+#include "bn_adpcm_music.h"
+
+#include "bn_adpcm_music_item.h"
+#include "bn_audio_manager.h"
+
+namespace bn::adpcm_music
+{
+
+bool playing()
+{
+    return audio_manager::adpcm_music_playing();
+}
+
+optional<adpcm_music_item> playing_item()
+{
+    return audio_manager::playing_adpcm_music_item();
+}
+
+void play(const adpcm_music_item& item)
+{
+    audio_manager::play_adpcm_music(item, 1, true);
+}
+
+void play(const adpcm_music_item& item, fixed volume)
+{
+    BN_BASIC_ASSERT(volume >= 0 && volume <= 1, "Volume range is [0..1]: ", volume);
+
+    audio_manager::play_adpcm_music(item, volume, true);
+}
+
+void play(const adpcm_music_item& item, fixed volume, bool loop)
+{
+    BN_BASIC_ASSERT(volume >= 0 && volume <= 1, "Volume range is [0..1]: ", volume);
+
+    audio_manager::play_adpcm_music(item, volume, loop);
+}
+
+void stop()
+{
+    audio_manager::stop_adpcm_music();
+}
+
+bool paused()
+{
+    return audio_manager::adpcm_music_paused();
+}
+
+void pause()
+{
+    audio_manager::pause_adpcm_music();
+}
+
+void resume()
+{
+    audio_manager::resume_adpcm_music();
+}
+
+fixed volume()
+{
+    return audio_manager::adpcm_music_volume();
+}
+
+void set_volume(fixed volume)
+{
+    BN_BASIC_ASSERT(volume >= 0 && volume <= 1, "Volume range is [0..1]: ", volume);
+
+    audio_manager::set_adpcm_music_volume(volume);
+}
+
+}
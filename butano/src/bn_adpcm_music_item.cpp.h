@@ -0,0 +1,28 @@
+/*
+ * Copyright (c) 2020-2023 Gustavo Valiente gustavo.valiente@protonmail.com
+ * zlib License, see LICENSE file.
+ */
+
+#include "bn_adpcm_music_item.h"
+
+#include "bn_adpcm_music.h"
+
+namespace bn
+{
+
+void adpcm_music_item::play() const
+{
+    adpcm_music::play(*this);
+}
+
+void adpcm_music_item::play(fixed volume) const
+{
+    adpcm_music::play(*this, volume);
+}
+
+void adpcm_music_item::play(fixed volume, bool loop) const
+{
+    adpcm_music::play(*this, volume, loop);
+}
+
+}
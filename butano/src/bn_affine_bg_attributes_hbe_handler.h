@@ -9,6 +9,7 @@
 #include "bn_affine_bg_tiles_ptr.h"
 #include "bn_affine_bg_attributes.h"
 #include "bn_bgs_manager.h"
+#include "bn_bg_blocks_manager.h"
 #include "../hw/include/bn_hw_bgs.h"
 
 namespace bn
@@ -35,6 +36,12 @@ public:
         last_value_type new_value = last_value_type(target_id);
         bool updated = *last_value != new_value;
         *last_value = new_value;
+
+        #if BN_CFG_BG_BLOCKS_DEFRAG_MAX_BLOCKS
+            // Map and tiles blocks must be written again if they have been moved in VRAM:
+            updated |= bg_blocks_manager::relocated();
+        #endif
+
         return updated;
     }
 
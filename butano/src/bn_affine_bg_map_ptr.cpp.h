@@ -387,6 +387,11 @@ compression_type affine_bg_map_ptr::compression() const
     return bg_blocks_manager::compression(_handle);
 }
 
+bool affine_bg_map_ptr::ready() const
+{
+    return ! bg_blocks_manager::must_commit(_handle);
+}
+
 optional<span<const affine_bg_map_cell>> affine_bg_map_ptr::cells_ref() const
 {
     return bg_blocks_manager::affine_map_cells_ref(_handle);
@@ -110,6 +110,11 @@ compression_type affine_bg_tiles_ptr::compression() const
     return bg_blocks_manager::compression(_handle);
 }
 
+bool affine_bg_tiles_ptr::ready() const
+{
+    return ! bg_blocks_manager::must_commit(_handle);
+}
+
 optional<span<const tile>> affine_bg_tiles_ptr::tiles_ref() const
 {
     return bg_blocks_manager::tiles_ref(_handle);
@@ -5,11 +5,57 @@
 
 #include "bn_audio.h"
 
+#include "bn_timers.h"
 #include "bn_audio_manager.h"
 
 namespace bn::audio
 {
 
+int mixing_rate()
+{
+    return audio_manager::mixing_rate();
+}
+
+void set_mixing_rate(int mixing_rate)
+{
+    audio_manager::set_mixing_rate(mixing_rate);
+}
+
+int max_channels()
+{
+    return audio_manager::max_channels();
+}
+
+void set_max_channels(int max_channels)
+{
+    audio_manager::set_max_channels(max_channels);
+}
+
+int last_mixing_ticks()
+{
+    return audio_manager::last_mixing_ticks();
+}
+
+fixed last_mixing_usage()
+{
+    return fixed(audio_manager::last_mixing_ticks()) / timers::ticks_per_frame();
+}
+
+int coalesced_commands_count()
+{
+    return audio_manager::coalesced_commands_count();
+}
+
+int dropped_commands_count()
+{
+    return audio_manager::dropped_commands_count();
+}
+
+void reset_commands_counters()
+{
+    audio_manager::reset_commands_counters();
+}
+
 bool update_on_vblank()
 {
     return audio_manager::update_on_vblank();
@@ -5,9 +5,11 @@
 
 #include "bn_audio_manager.h"
 
+#include "bn_display.h"
 #include "bn_config_audio.h"
 #include "bn_unordered_map.h"
 #include "bn_identity_hasher.h"
+#include "bn_adpcm_music_item.h"
 #include "bn_dmg_music_position.h"
 #include "../hw/include/bn_hw_audio.h"
 
@@ -19,7 +21,9 @@
 #include "bn_music_item.cpp.h"
 #include "bn_sound_item.cpp.h"
 #include "bn_sound_handle.cpp.h"
+#include "bn_adpcm_music.cpp.h"
 #include "bn_dmg_music_item.cpp.h"
+#include "bn_adpcm_music_item.cpp.h"
 
 namespace bn::audio_manager
 {
@@ -29,13 +33,15 @@ struct sound_data_type
     int item_id;
     fixed speed;
     fixed panning;
+    unsigned play_frame;
     optional<mm_sfxhand> hw_handle;
 
-    void init(bn::sound_item _item, fixed _speed, fixed _panning)
+    void init(bn::sound_item _item, fixed _speed, fixed _panning, unsigned _play_frame)
     {
         item_id = _item.id();
         speed = _speed;
         panning = _panning;
+        play_frame = _play_frame;
         hw_handle.reset();
     }
 };
@@ -44,6 +50,7 @@ namespace
 {
     constexpr int max_commands = BN_CFG_AUDIO_MAX_COMMANDS;
     static_assert(max_commands > 2, "Invalid max audio commands");
+    static_assert(power_of_two(max_commands), "Invalid max audio commands");
 
     constexpr int max_sound_channels = BN_CFG_AUDIO_MAX_SOUND_CHANNELS;
     static_assert(max_sound_channels > 0, "Invalid max sound channels");
@@ -80,6 +87,11 @@ namespace
         return fixed_t<3>(volume).data();
     }
 
+    int _hw_adpcm_music_volume(fixed volume)
+    {
+        return fixed_t<8>(volume).data();
+    }
+
     int _hw_sound_speed(fixed speed)
     {
         return min(fixed_t<10>(speed).data(), 65535);
@@ -320,6 +332,48 @@ namespace
     };
 
 
+    class play_adpcm_music_command
+    {
+
+    public:
+        play_adpcm_music_command(const uint8_t* data, int volume, bool loop) :
+            _data(data),
+            _volume(volume),
+            _loop(loop)
+        {
+        }
+
+        void execute() const
+        {
+            hw::audio::play_adpcm_music(_data, _volume, _loop);
+        }
+
+    private:
+        const uint8_t* _data;
+        int _volume;
+        bool _loop;
+    };
+
+
+    class set_adpcm_music_volume_command
+    {
+
+    public:
+        explicit set_adpcm_music_volume_command(int volume) :
+            _volume(volume)
+        {
+        }
+
+        void execute() const
+        {
+            hw::audio::set_adpcm_music_volume(_volume);
+        }
+
+    private:
+        int _volume;
+    };
+
+
     class play_sound_command
     {
 
@@ -335,7 +389,10 @@ namespace
         {
             if(sound_data_type* data = sound_data(_handle))
             {
-                data->hw_handle = hw::audio::play_sound(_priority, _id);
+                if(mm_sfxhand hw_handle = hw::audio::play_sound(_priority, _id))
+                {
+                    data->hw_handle = hw_handle;
+                }
             }
         }
 
@@ -364,7 +421,10 @@ namespace
         {
             if(sound_data_type* data = sound_data(_handle))
             {
-                data->hw_handle = hw::audio::play_sound(_priority, _id, _volume, _speed, _panning);
+                if(mm_sfxhand hw_handle = hw::audio::play_sound(_priority, _id, _volume, _speed, _panning))
+                {
+                    data->hw_handle = hw_handle;
+                }
             }
         }
 
@@ -465,6 +525,11 @@ namespace
         {
         }
 
+        [[nodiscard]] int handle() const
+        {
+            return _handle;
+        }
+
         void execute() const
         {
             if(sound_data_type* data = sound_data(_handle))
@@ -501,6 +566,44 @@ namespace
     };
 
 
+    class set_mixing_rate_command
+    {
+
+    public:
+        explicit set_mixing_rate_command(int mixing_rate) :
+            _mixing_rate(mixing_rate)
+        {
+        }
+
+        void execute() const
+        {
+            hw::audio::set_mixing_rate(_mixing_rate);
+        }
+
+    private:
+        int _mixing_rate;
+    };
+
+
+    class set_max_channels_command
+    {
+
+    public:
+        explicit set_max_channels_command(int max_channels) :
+            _max_channels(max_channels)
+        {
+        }
+
+        void execute() const
+        {
+            hw::audio::set_max_channels(_max_channels);
+        }
+
+    private:
+        int _max_channels;
+    };
+
+
     enum command_code : uint8_t
     {
         MUSIC_PLAY,
@@ -520,6 +623,11 @@ namespace
         DMG_MUSIC_SET_POSITION,
         DMG_MUSIC_SET_VOLUME,
         DMG_MUSIC_SET_MASTER_VOLUME,
+        ADPCM_MUSIC_PLAY,
+        ADPCM_MUSIC_STOP,
+        ADPCM_MUSIC_PAUSE,
+        ADPCM_MUSIC_RESUME,
+        ADPCM_MUSIC_SET_VOLUME,
         SOUND_PLAY,
         SOUND_PLAY_EX,
         SOUND_STOP,
@@ -527,7 +635,9 @@ namespace
         SOUND_SET_SPEED,
         SOUND_SET_PANNING,
         SOUND_STOP_ALL,
-        SOUND_SET_MASTER_VOLUME
+        SOUND_SET_MASTER_VOLUME,
+        MIXING_SET_RATE,
+        MIXING_SET_MAX_CHANNELS
     };
 
 
@@ -554,23 +664,213 @@ namespace
         bn::dmg_music_position dmg_music_position;
         fixed dmg_music_left_volume;
         fixed dmg_music_right_volume;
+        fixed adpcm_music_volume;
         fixed sound_master_volume = 1;
-        int commands_count = 0;
+        unsigned commands_head = 0;
+        unsigned commands_tail = 0;
+        unsigned frame = 0;
+        fixed sound_attenuation_distance = display::width();
+        int sound_deduplication_frames = 0;
+        int coalesced_commands_count = 0;
+        int dropped_commands_count = 0;
         int music_item_id = 0;
         int music_position = 0;
         int jingle_item_id = 0;
+        int mixing_rate = BN_CFG_AUDIO_MIXING_RATE;
+        int max_channels = BN_CFG_AUDIO_MAX_MUSIC_CHANNELS + BN_CFG_AUDIO_MAX_SOUND_CHANNELS;
         const uint8_t* dmg_music_data = nullptr;
+        const uint8_t* adpcm_music_data = nullptr;
         uint16_t new_sound_handle = 0;
         command_code command_codes[max_commands];
         bn::dmg_music_type dmg_music_type = dmg_music_type::GBT_PLAYER;
         bn::dmg_music_master_volume dmg_music_master_volume = dmg_music_master_volume::QUARTER;
         bool music_playing = false;
         bool music_paused = false;
+        bool music_loop = false;
         bool jingle_playing = false;
         bool dmg_music_paused = false;
+        bool adpcm_music_paused = false;
     };
 
     BN_DATA_EWRAM_BSS static_data data;
+
+
+    // Commands are pushed to a ring buffer by the game code and popped by execute_commands.
+    //
+    // Pending commands are never popped while a new one is being pushed,
+    // so they can be coalesced with the new one.
+
+    [[nodiscard]] int _pending_commands_count()
+    {
+        return int(data.commands_tail - data.commands_head);
+    }
+
+    [[nodiscard]] bool _coalescable_command(command_code code)
+    {
+        switch(code)
+        {
+
+        case MUSIC_SET_POSITION:
+        case MUSIC_SET_VOLUME:
+        case MUSIC_SET_TEMPO:
+        case MUSIC_SET_PITCH:
+        case JINGLE_SET_VOLUME:
+        case DMG_MUSIC_SET_POSITION:
+        case DMG_MUSIC_SET_VOLUME:
+        case DMG_MUSIC_SET_MASTER_VOLUME:
+        case ADPCM_MUSIC_SET_VOLUME:
+        case SOUND_SET_PANNING:
+        case SOUND_SET_MASTER_VOLUME:
+        case MIXING_SET_RATE:
+        case MIXING_SET_MAX_CHANNELS:
+            return true;
+
+        default:
+            return false;
+        }
+    }
+
+    [[nodiscard]] command_data* _coalesced_command_data(command_code code, int handle)
+    {
+        if(! _coalescable_command(code))
+        {
+            return nullptr;
+        }
+
+        // Coalescable commands don't depend on each other, so the search stops at the first one which does:
+        for(unsigned index = data.commands_tail, head = data.commands_head; index != head; )
+        {
+            --index;
+
+            unsigned slot = index & (max_commands - 1);
+            command_code pending_code = data.command_codes[slot];
+            command_data& pending_command_data = data.command_datas[slot];
+
+            if(pending_code == code)
+            {
+                if(code != SOUND_SET_PANNING || handle ==
+                        reinterpret_cast<const set_sound_panning_command&>(pending_command_data.data).handle())
+                {
+                    ++data.coalesced_commands_count;
+                    return &pending_command_data;
+                }
+            }
+            else if(! _coalescable_command(pending_code))
+            {
+                return nullptr;
+            }
+        }
+
+        return nullptr;
+    }
+
+    unsigned _push_command_slot(command_code code)
+    {
+        unsigned tail = data.commands_tail;
+        BN_BASIC_ASSERT(_pending_commands_count() < max_commands, "No more audio commands available");
+
+        unsigned slot = tail & (max_commands - 1);
+        data.command_codes[slot] = code;
+        return slot;
+    }
+
+    void _publish_command()
+    {
+        BN_BARRIER;
+        ++data.commands_tail;
+    }
+
+    void _push_command(command_code code)
+    {
+        _push_command_slot(code);
+        _publish_command();
+    }
+
+    template<typename Command>
+    void _push_command(command_code code, const Command& command, int handle = -1)
+    {
+        static_assert(sizeof(Command) <= sizeof(command_data));
+        static_assert(alignof(Command) <= alignof(command_data));
+
+        if(command_data* coalesced_command_data = _coalesced_command_data(code, handle))
+        {
+            new(coalesced_command_data) Command(command);
+        }
+        else
+        {
+            unsigned slot = _push_command_slot(code);
+            new(data.command_datas + slot) Command(command);
+            _publish_command();
+        }
+    }
+
+    [[nodiscard]] optional<uint16_t> _duplicated_sound_handle(bn::sound_item item)
+    {
+        optional<uint16_t> result;
+
+        if(int deduplication_frames = data.sound_deduplication_frames)
+        {
+            int item_id = item.id();
+            unsigned frame = data.frame;
+
+            for(const auto& sound : data.sound_map)
+            {
+                const sound_data_type& sound_data = sound.second;
+
+                if(sound_data.item_id == item_id && int(frame - sound_data.play_frame) < deduplication_frames)
+                {
+                    result = uint16_t(sound.first);
+                    break;
+                }
+            }
+        }
+
+        return result;
+    }
+
+    [[nodiscard]] bool _sound_command_available()
+    {
+        // Sound effects play, speed and panning commands can't use the last quarter of the commands ring buffer,
+        // which is reserved for the other commands (they still raise an error if the ring buffer is full):
+        if(_pending_commands_count() >= max_commands - (max_commands / 4))
+        {
+            ++data.dropped_commands_count;
+            return false;
+        }
+
+        return true;
+    }
+
+    [[nodiscard]] bool _play_sound_command_available()
+    {
+        if(data.sound_map.full())
+        {
+            ++data.dropped_commands_count;
+            return false;
+        }
+
+        return _sound_command_available();
+    }
+
+    template<typename Command>
+    [[nodiscard]] bool _push_sound_command(command_code code, const Command& command, int handle = -1)
+    {
+        if(command_data* coalesced_command_data = _coalesced_command_data(code, handle))
+        {
+            new(coalesced_command_data) Command(command);
+            return true;
+        }
+
+        if(! _sound_command_available())
+        {
+            return false;
+        }
+
+        unsigned slot = _push_command_slot(code);
+        new(data.command_datas + slot) Command(command);
+        _publish_command();
+        return true;
+    }
 }
 
 void init()
@@ -609,15 +909,11 @@ optional<music_item> playing_music_item()
 
 void play_music(music_item item, fixed volume, bool loop)
 {
-    int commands = data.commands_count;
-    BN_BASIC_ASSERT(commands < max_commands, "No more audio commands available");
-
-    data.command_codes[commands] = MUSIC_PLAY;
-    new(data.command_datas + commands) play_music_command(item.id(), loop, _hw_music_volume(volume));
-    data.commands_count = commands + 1;
+    _push_command(MUSIC_PLAY, play_music_command(item.id(), loop, _hw_music_volume(volume)));
 
     data.music_item_id = item.id();
     data.music_position = 0;
+    data.music_loop = loop;
     data.music_volume = volume;
     data.music_tempo = 1;
     data.music_pitch = 1;
@@ -629,11 +925,7 @@ void stop_music()
 {
     if(data.music_playing)
     {
-        int commands = data.commands_count;
-        BN_BASIC_ASSERT(commands < max_commands, "No more audio commands available");
-
-        data.command_codes[commands] = MUSIC_STOP;
-        data.commands_count = commands + 1;
+        _push_command(MUSIC_STOP);
 
         data.music_playing = false;
         data.music_paused = false;
@@ -650,11 +942,7 @@ void pause_music()
     BN_BASIC_ASSERT(data.music_playing, "There's no music playing");
     BN_BASIC_ASSERT(! data.music_paused, "Music is already paused");
 
-    int commands = data.commands_count;
-    BN_BASIC_ASSERT(commands < max_commands, "No more audio commands available");
-
-    data.command_codes[commands] = MUSIC_PAUSE;
-    data.commands_count = commands + 1;
+    _push_command(MUSIC_PAUSE);
 
     data.music_paused = true;
 }
@@ -663,11 +951,7 @@ void resume_music()
 {
     BN_BASIC_ASSERT(data.music_paused, "Music is not paused");
 
-    int commands = data.commands_count;
-    BN_BASIC_ASSERT(commands < max_commands, "No more audio commands available");
-
-    data.command_codes[commands] = MUSIC_RESUME;
-    data.commands_count = commands + 1;
+    _push_command(MUSIC_RESUME);
 
     data.music_paused = false;
 }
@@ -685,12 +969,7 @@ void set_music_position(int position)
 
     if(position != data.music_position)
     {
-        int commands = data.commands_count;
-        BN_BASIC_ASSERT(commands < max_commands, "No more audio commands available");
-
-        data.command_codes[commands] = MUSIC_SET_POSITION;
-        new(data.command_datas + commands) set_music_position_command(position);
-        data.commands_count = commands + 1;
+        _push_command(MUSIC_SET_POSITION, set_music_position_command(position));
 
         data.music_position = position;
     }
@@ -710,12 +989,7 @@ void set_music_volume(fixed volume)
 
     if(hw_volume != _hw_music_volume(data.music_volume))
     {
-        int commands = data.commands_count;
-        BN_BASIC_ASSERT(commands < max_commands, "No more audio commands available");
-
-        data.command_codes[commands] = MUSIC_SET_VOLUME;
-        new(data.command_datas + commands) set_music_volume_command(hw_volume);
-        data.commands_count = commands + 1;
+        _push_command(MUSIC_SET_VOLUME, set_music_volume_command(hw_volume));
     }
 
     data.music_volume = volume;
@@ -735,12 +1009,7 @@ void set_music_tempo(fixed tempo)
 
     if(hw_tempo != _hw_music_tempo(data.music_tempo))
     {
-        int commands = data.commands_count;
-        BN_BASIC_ASSERT(commands < max_commands, "No more audio commands available");
-
-        data.command_codes[commands] = MUSIC_SET_TEMPO;
-        new(data.command_datas + commands) set_music_tempo_command(hw_tempo);
-        data.commands_count = commands + 1;
+        _push_command(MUSIC_SET_TEMPO, set_music_tempo_command(hw_tempo));
     }
 
     data.music_tempo = tempo;
@@ -760,12 +1029,7 @@ void set_music_pitch(fixed pitch)
 
     if(hw_pitch != _hw_music_pitch(data.music_pitch))
     {
-        int commands = data.commands_count;
-        BN_BASIC_ASSERT(commands < max_commands, "No more audio commands available");
-
-        data.command_codes[commands] = MUSIC_SET_PITCH;
-        new(data.command_datas + commands) set_music_pitch_command(hw_pitch);
-        data.commands_count = commands + 1;
+        _push_command(MUSIC_SET_PITCH, set_music_pitch_command(hw_pitch));
     }
 
     data.music_pitch = pitch;
@@ -790,12 +1054,7 @@ optional<music_item> playing_jingle_item()
 
 void play_jingle(music_item item, fixed volume)
 {
-    int commands = data.commands_count;
-    BN_BASIC_ASSERT(commands < max_commands, "No more audio commands available");
-
-    data.command_codes[commands] = JINGLE_PLAY;
-    new(data.command_datas + commands) play_jingle_command(item.id(), _hw_music_volume(volume));
-    data.commands_count = commands + 1;
+    _push_command(JINGLE_PLAY, play_jingle_command(item.id(), _hw_music_volume(volume)));
 
     data.jingle_item_id = item.id();
     data.jingle_volume = volume;
@@ -816,12 +1075,7 @@ void set_jingle_volume(fixed volume)
 
     if(hw_volume != _hw_music_volume(data.jingle_volume))
     {
-        int commands = data.commands_count;
-        BN_BASIC_ASSERT(commands < max_commands, "No more audio commands available");
-
-        data.command_codes[commands] = JINGLE_SET_VOLUME;
-        new(data.command_datas + commands) set_jingle_volume_command(hw_volume);
-        data.commands_count = commands + 1;
+        _push_command(JINGLE_SET_VOLUME, set_jingle_volume_command(hw_volume));
     }
 
     data.jingle_volume = volume;
@@ -846,12 +1100,7 @@ optional<dmg_music_item> playing_dmg_music_item()
 
 void play_dmg_music(const dmg_music_item& item, int speed, bool loop)
 {
-    int commands = data.commands_count;
-    BN_BASIC_ASSERT(commands < max_commands, "No more audio commands available");
-
-    data.command_codes[commands] = DMG_MUSIC_PLAY;
-    new(data.command_datas + commands) play_dmg_music_command(item.data_ptr(), item.type(), loop, speed);
-    data.commands_count = commands + 1;
+    _push_command(DMG_MUSIC_PLAY, play_dmg_music_command(item.data_ptr(), item.type(), loop, speed));
 
     data.dmg_music_position = bn::dmg_music_position();
     data.dmg_music_left_volume = 1;
@@ -865,11 +1114,7 @@ void stop_dmg_music()
 {
     if(data.dmg_music_data)
     {
-        int commands = data.commands_count;
-        BN_BASIC_ASSERT(commands < max_commands, "No more audio commands available");
-
-        data.command_codes[commands] = DMG_MUSIC_STOP;
-        data.commands_count = commands + 1;
+        _push_command(DMG_MUSIC_STOP);
 
         data.dmg_music_data = nullptr;
         data.dmg_music_paused = false;
@@ -886,11 +1131,7 @@ void pause_dmg_music()
     BN_BASIC_ASSERT(data.dmg_music_data, "There's no DMG music playing");
     BN_BASIC_ASSERT(! data.dmg_music_paused, "DMG music is already paused");
 
-    int commands = data.commands_count;
-    BN_BASIC_ASSERT(commands < max_commands, "No more audio commands available");
-
-    data.command_codes[commands] = DMG_MUSIC_PAUSE;
-    data.commands_count = commands + 1;
+    _push_command(DMG_MUSIC_PAUSE);
 
     data.dmg_music_paused = true;
 }
@@ -899,11 +1140,7 @@ void resume_dmg_music()
 {
     BN_BASIC_ASSERT(data.dmg_music_paused, "DMG music is not paused");
 
-    int commands = data.commands_count;
-    BN_BASIC_ASSERT(commands < max_commands, "No more audio commands available");
-
-    data.command_codes[commands] = DMG_MUSIC_RESUME;
-    data.commands_count = commands + 1;
+    _push_command(DMG_MUSIC_RESUME);
 
     data.dmg_music_paused = false;
 }
@@ -921,12 +1158,7 @@ void set_dmg_music_position(const bn::dmg_music_position& position)
 
     if(position != data.dmg_music_position)
     {
-        int commands = data.commands_count;
-        BN_BASIC_ASSERT(commands < max_commands, "No more audio commands available");
-
-        data.command_codes[commands] = DMG_MUSIC_SET_POSITION;
-        new(data.command_datas + commands) set_dmg_music_position_command(position.pattern(), position.row());
-        data.commands_count = commands + 1;
+        _push_command(DMG_MUSIC_SET_POSITION, set_dmg_music_position_command(position.pattern(), position.row()));
 
         data.dmg_music_position = position;
     }
@@ -965,12 +1197,7 @@ void set_dmg_music_volume(fixed left_volume, fixed right_volume)
     if(hw_left_volume != _hw_dmg_music_volume(data.dmg_music_left_volume) ||
             hw_right_volume != _hw_dmg_music_volume(data.dmg_music_right_volume))
     {
-        int commands = data.commands_count;
-        BN_BASIC_ASSERT(commands < max_commands, "No more audio commands available");
-
-        data.command_codes[commands] = DMG_MUSIC_SET_VOLUME;
-        new(data.command_datas + commands) set_dmg_music_volume_command(hw_left_volume, hw_right_volume);
-        data.commands_count = commands + 1;
+        _push_command(DMG_MUSIC_SET_VOLUME, set_dmg_music_volume_command(hw_left_volume, hw_right_volume));
     }
 
     data.dmg_music_left_volume = left_volume;
@@ -986,17 +1213,98 @@ void set_dmg_music_master_volume(bn::dmg_music_master_volume volume)
 {
     if(volume != data.dmg_music_master_volume)
     {
-        int commands = data.commands_count;
-        BN_BASIC_ASSERT(commands < max_commands, "No more audio commands available");
-
-        data.command_codes[commands] = DMG_MUSIC_SET_MASTER_VOLUME;
-        new(data.command_datas + commands) set_dmg_music_master_volume_command(int(volume));
-        data.commands_count = commands + 1;
+        _push_command(DMG_MUSIC_SET_MASTER_VOLUME, set_dmg_music_master_volume_command(int(volume)));
 
         data.dmg_music_master_volume = volume;
     }
 }
 
+bool adpcm_music_playing()
+{
+    return data.adpcm_music_data;
+}
+
+optional<adpcm_music_item> playing_adpcm_music_item()
+{
+    optional<adpcm_music_item> result;
+
+    if(const uint8_t* adpcm_music_data = data.adpcm_music_data)
+    {
+        result = adpcm_music_item(*adpcm_music_data);
+    }
+
+    return result;
+}
+
+void play_adpcm_music(const adpcm_music_item& item, fixed volume, bool loop)
+{
+    BN_BASIC_ASSERT(item.sample_rate() > 0 && item.sample_rate() < 65536,
+                    "Invalid ADPCM music sample rate: ", item.sample_rate());
+
+    _push_command(ADPCM_MUSIC_PLAY,
+                  play_adpcm_music_command(item.data_ptr(), _hw_adpcm_music_volume(volume), loop));
+
+    data.adpcm_music_volume = volume;
+    data.adpcm_music_data = item.data_ptr();
+    data.adpcm_music_paused = false;
+}
+
+void stop_adpcm_music()
+{
+    if(data.adpcm_music_data)
+    {
+        _push_command(ADPCM_MUSIC_STOP);
+
+        data.adpcm_music_data = nullptr;
+        data.adpcm_music_paused = false;
+    }
+}
+
+bool adpcm_music_paused()
+{
+    return data.adpcm_music_paused;
+}
+
+void pause_adpcm_music()
+{
+    BN_BASIC_ASSERT(data.adpcm_music_data, "There's no ADPCM music playing");
+    BN_BASIC_ASSERT(! data.adpcm_music_paused, "ADPCM music is already paused");
+
+    _push_command(ADPCM_MUSIC_PAUSE);
+
+    data.adpcm_music_paused = true;
+}
+
+void resume_adpcm_music()
+{
+    BN_BASIC_ASSERT(data.adpcm_music_paused, "ADPCM music is not paused");
+
+    _push_command(ADPCM_MUSIC_RESUME);
+
+    data.adpcm_music_paused = false;
+}
+
+fixed adpcm_music_volume()
+{
+    BN_BASIC_ASSERT(data.adpcm_music_data, "There's no ADPCM music playing");
+
+    return data.adpcm_music_volume;
+}
+
+void set_adpcm_music_volume(fixed volume)
+{
+    BN_BASIC_ASSERT(data.adpcm_music_data, "There's no ADPCM music playing");
+
+    int hw_volume = _hw_adpcm_music_volume(volume);
+
+    if(hw_volume != _hw_adpcm_music_volume(data.adpcm_music_volume))
+    {
+        _push_command(ADPCM_MUSIC_SET_VOLUME, set_adpcm_music_volume_command(hw_volume));
+    }
+
+    data.adpcm_music_volume = volume;
+}
+
 sound_data_type* sound_data(uint16_t handle)
 {
     auto it = data.sound_map.find(handle);
@@ -1011,36 +1319,43 @@ sound_data_type* sound_data(uint16_t handle)
 
 uint16_t play_sound(int priority, bn::sound_item item)
 {
-    int commands = data.commands_count;
-    BN_BASIC_ASSERT(commands < max_commands, "No more audio commands available");
-    BN_BASIC_ASSERT(! data.sound_map.full(), "No more sound handles available");
+    if(optional<uint16_t> duplicated_handle = _duplicated_sound_handle(item))
+    {
+        return *duplicated_handle;
+    }
 
     uint16_t handle = data.new_sound_handle;
-    data.sound_map[handle].init(item, 1, 0);
     data.new_sound_handle = handle + 1;
 
-    data.command_codes[commands] = SOUND_PLAY;
-    new(data.command_datas + commands) play_sound_command(priority, item.id(), handle);
-    data.commands_count = commands + 1;
+    if(_play_sound_command_available())
+    {
+        data.sound_map[handle].init(item, 1, 0, data.frame);
+        _push_command(SOUND_PLAY, play_sound_command(priority, item.id(), handle));
+    }
 
     return handle;
 }
 
 uint16_t play_sound(int priority, bn::sound_item item, fixed volume, fixed speed, fixed panning)
 {
-    int commands = data.commands_count;
-    BN_BASIC_ASSERT(commands < max_commands, "No more audio commands available");
-    BN_BASIC_ASSERT(! data.sound_map.full(), "No more sound handles available");
+    if(optional<uint16_t> duplicated_handle = _duplicated_sound_handle(item))
+    {
+        return *duplicated_handle;
+    }
 
     uint16_t handle = data.new_sound_handle;
-    data.sound_map[handle].init(item, speed, panning);
     data.new_sound_handle = handle + 1;
 
-    data.command_codes[commands] = SOUND_PLAY_EX;
-    new(data.command_datas + commands) play_sound_ex_command(
-            priority, item.id(), handle, _hw_sound_volume(volume), _hw_sound_speed(speed),
-            _hw_sound_panning(panning));
-    data.commands_count = commands + 1;
+    // Muted sound effects can't be heard, so they are not played:
+    int hw_volume = _hw_sound_volume(volume);
+
+    if(hw_volume && _play_sound_command_available())
+    {
+        data.sound_map[handle].init(item, speed, panning, data.frame);
+        _push_command(SOUND_PLAY_EX, play_sound_ex_command(
+                priority, item.id(), handle, hw_volume, _hw_sound_speed(speed),
+                _hw_sound_panning(panning)));
+    }
 
     return handle;
 }
@@ -1049,12 +1364,7 @@ void stop_sound(uint16_t handle)
 {
     if(data.sound_map.find(handle) != data.sound_map.end())
     {
-        int commands = data.commands_count;
-        BN_BASIC_ASSERT(commands < max_commands, "No more audio commands available");
-
-        data.command_codes[commands] = SOUND_STOP;
-        new(data.command_datas + commands) stop_sound_command(handle);
-        data.commands_count = commands + 1;
+        _push_command(SOUND_STOP, stop_sound_command(handle));
     }
 }
 
@@ -1062,12 +1372,7 @@ void release_sound(uint16_t handle)
 {
     if(data.sound_map.find(handle) != data.sound_map.end())
     {
-        int commands = data.commands_count;
-        BN_BASIC_ASSERT(commands < max_commands, "No more audio commands available");
-
-        data.command_codes[commands] = SOUND_RELEASE;
-        new(data.command_datas + commands) release_sound_command(handle);
-        data.commands_count = commands + 1;
+        _push_command(SOUND_RELEASE, release_sound_command(handle));
     }
 }
 
@@ -1104,12 +1409,11 @@ void set_sound_speed(uint16_t handle, fixed speed)
             int hw_scale = scale.data();
             BN_BASIC_ASSERT(hw_scale < 65536, "Speed change is too high: ", sound_data.speed, " - ", speed);
 
-            int commands = data.commands_count;
-            BN_BASIC_ASSERT(commands < max_commands, "No more audio commands available");
-
-            data.command_codes[commands] = SOUND_SET_SPEED;
-            new(data.command_datas + commands) set_sound_speed_command(handle, hw_scale);
-            data.commands_count = commands + 1;
+            // If the command is dropped, the stored speed is kept so the next change is relative to it:
+            if(! _push_sound_command(SOUND_SET_SPEED, set_sound_speed_command(handle, hw_scale)))
+            {
+                return;
+            }
         }
 
         sound_data.speed = speed;
@@ -1134,24 +1438,44 @@ void set_sound_panning(uint16_t handle, fixed panning)
 
     if(hw_panning != _hw_sound_panning(sound_data.panning))
     {
-        int commands = data.commands_count;
-        BN_BASIC_ASSERT(commands < max_commands, "No more audio commands available");
-
-        data.command_codes[commands] = SOUND_SET_PANNING;
-        new(data.command_datas + commands) set_sound_panning_command(handle, hw_panning);
-        data.commands_count = commands + 1;
+        // If the command is dropped, the stored panning is kept so the next change is not ignored:
+        if(! _push_sound_command(SOUND_SET_PANNING, set_sound_panning_command(handle, hw_panning), handle))
+        {
+            return;
+        }
     }
 
     sound_data.panning = panning;
 }
 
-void stop_all_sounds()
+int active_sounds_count()
 {
-    int commands = data.commands_count;
-    BN_BASIC_ASSERT(commands < max_commands, "No more audio commands available");
+    return data.sound_map.size();
+}
 
-    data.command_codes[commands] = SOUND_STOP_ALL;
-    data.commands_count = commands + 1;
+int sound_deduplication_frames()
+{
+    return data.sound_deduplication_frames;
+}
+
+void set_sound_deduplication_frames(int frames)
+{
+    data.sound_deduplication_frames = frames;
+}
+
+fixed sound_attenuation_distance()
+{
+    return data.sound_attenuation_distance;
+}
+
+void set_sound_attenuation_distance(fixed distance)
+{
+    data.sound_attenuation_distance = distance;
+}
+
+void stop_all_sounds()
+{
+    _push_command(SOUND_STOP_ALL);
 
     data.sound_map.clear();
 }
@@ -1167,17 +1491,71 @@ void set_sound_master_volume(fixed volume)
 
     if(hw_volume != _hw_sound_master_volume(data.sound_master_volume))
     {
-        int commands = data.commands_count;
-        BN_BASIC_ASSERT(commands < max_commands, "No more audio commands available");
-
-        data.command_codes[commands] = SOUND_SET_MASTER_VOLUME;
-        new(data.command_datas + commands) set_sound_master_volume_command(hw_volume);
-        data.commands_count = commands + 1;
+        _push_command(SOUND_SET_MASTER_VOLUME, set_sound_master_volume_command(hw_volume));
     }
 
     data.sound_master_volume = volume;
 }
 
+int mixing_rate()
+{
+    return data.mixing_rate;
+}
+
+void set_mixing_rate(int mixing_rate)
+{
+    BN_ASSERT(mixing_rate >= BN_AUDIO_MIXING_RATE_8_KHZ && mixing_rate <= BN_CFG_AUDIO_MIXING_RATE,
+              "Invalid mixing rate: ", mixing_rate, " - ", BN_CFG_AUDIO_MIXING_RATE);
+
+    if(mixing_rate != data.mixing_rate)
+    {
+        _push_command(MIXING_SET_RATE, set_mixing_rate_command(mixing_rate));
+
+        data.mixing_rate = mixing_rate;
+        data.jingle_playing = false;
+        data.sound_map.clear();
+    }
+}
+
+int max_channels()
+{
+    return data.max_channels;
+}
+
+void set_max_channels(int max_channels)
+{
+    BN_ASSERT(max_channels > 0 && max_channels <= BN_CFG_AUDIO_MAX_MUSIC_CHANNELS + max_sound_channels,
+              "Invalid max channels: ", max_channels, " - ", BN_CFG_AUDIO_MAX_MUSIC_CHANNELS + max_sound_channels);
+
+    if(max_channels != data.max_channels)
+    {
+        _push_command(MIXING_SET_MAX_CHANNELS, set_max_channels_command(max_channels));
+
+        data.max_channels = max_channels;
+    }
+}
+
+int last_mixing_ticks()
+{
+    return hw::audio::last_mixing_ticks();
+}
+
+int coalesced_commands_count()
+{
+    return data.coalesced_commands_count;
+}
+
+int dropped_commands_count()
+{
+    return data.dropped_commands_count;
+}
+
+void reset_commands_counters()
+{
+    data.coalesced_commands_count = 0;
+    data.dropped_commands_count = 0;
+}
+
 bool update_on_vblank()
 {
     return hw::audio::update_on_vblank();
@@ -1198,6 +1576,9 @@ void execute_commands()
     const uint8_t* old_dmg_music_data = data.dmg_music_data;
     const uint8_t* dmg_music_data = old_dmg_music_data;
     bool dmg_music_paused = data.dmg_music_paused;
+    const uint8_t* old_adpcm_music_data = data.adpcm_music_data;
+    const uint8_t* adpcm_music_data = old_adpcm_music_data;
+    bool adpcm_music_paused = data.adpcm_music_paused;
     bool music_playing = data.music_playing;
     bool music_paused = data.music_paused;
     bool jingle_playing = data.jingle_playing;
@@ -1219,10 +1600,21 @@ void execute_commands()
         dmg_music_paused = false;
     }
 
+    if(adpcm_music_data && ! hw::audio::adpcm_music_playing())
+    {
+        adpcm_music_data = nullptr;
+        adpcm_music_paused = false;
+    }
+
     hw::audio::update_sounds_queue();
 
-    for(int index = 0, limit = data.commands_count; index < limit; ++index)
+    unsigned commands_tail = data.commands_tail;
+    BN_BARRIER;
+
+    for(unsigned command = data.commands_head; command != commands_tail; ++command)
     {
+        unsigned index = command & (max_commands - 1);
+
         switch(data.command_codes[index])
         {
 
@@ -1340,6 +1732,41 @@ void execute_commands()
             reinterpret_cast<const set_dmg_music_master_volume_command&>(data.command_datas[index].data).execute();
             break;
 
+        case ADPCM_MUSIC_PLAY:
+            reinterpret_cast<const play_adpcm_music_command&>(data.command_datas[index].data).execute();
+            adpcm_music_data = old_adpcm_music_data;
+            adpcm_music_paused = false;
+            break;
+
+        case ADPCM_MUSIC_STOP:
+            hw::audio::stop_adpcm_music();
+            adpcm_music_data = nullptr;
+            adpcm_music_paused = false;
+            break;
+
+        case ADPCM_MUSIC_PAUSE:
+            if(adpcm_music_data)
+            {
+                hw::audio::pause_adpcm_music();
+                adpcm_music_paused = true;
+            }
+            break;
+
+        case ADPCM_MUSIC_RESUME:
+            if(adpcm_music_data)
+            {
+                hw::audio::resume_adpcm_music();
+                adpcm_music_paused = false;
+            }
+            break;
+
+        case ADPCM_MUSIC_SET_VOLUME:
+            if(adpcm_music_data)
+            {
+                reinterpret_cast<const set_adpcm_music_volume_command&>(data.command_datas[index].data).execute();
+            }
+            break;
+
         case SOUND_PLAY:
             reinterpret_cast<const play_sound_command&>(data.command_datas[index].data).execute();
             break;
@@ -1372,12 +1799,51 @@ void execute_commands()
             reinterpret_cast<const set_sound_master_volume_command&>(data.command_datas[index].data).execute();
             break;
 
+        case MIXING_SET_RATE:
+            {
+                // Maxmod is initialized again, so music is restarted where it was,
+                // while sound effects and the active jingle are stopped:
+                int music_position = 0;
+
+                if(music_playing)
+                {
+                    music_position = hw::audio::music_position();
+                    hw::audio::stop_music();
+                }
+
+                reinterpret_cast<const set_mixing_rate_command&>(data.command_datas[index].data).execute();
+
+                if(music_playing)
+                {
+                    hw::audio::play_music(data.music_item_id, data.music_loop);
+                    hw::audio::set_music_position(music_position);
+                    hw::audio::set_music_volume(_hw_music_volume(data.music_volume));
+                    hw::audio::set_music_tempo(_hw_music_tempo(data.music_tempo));
+                    hw::audio::set_music_pitch(_hw_music_pitch(data.music_pitch));
+
+                    if(music_paused)
+                    {
+                        hw::audio::pause_music();
+                    }
+                }
+
+                jingle_playing = false;
+                hw::audio::set_sound_master_volume(_hw_sound_master_volume(data.sound_master_volume));
+            }
+            break;
+
+        case MIXING_SET_MAX_CHANNELS:
+            reinterpret_cast<const set_max_channels_command&>(data.command_datas[index].data).execute();
+            break;
+
         default:
             break;
         }
     }
 
-    data.commands_count = 0;
+    BN_BARRIER;
+    data.commands_head = commands_tail;
+    ++data.frame;
 
     if(music_playing)
     {
@@ -1397,6 +1863,8 @@ void execute_commands()
     data.jingle_playing = jingle_playing;
     data.dmg_music_data = dmg_music_data;
     data.dmg_music_paused = dmg_music_paused;
+    data.adpcm_music_data = adpcm_music_data;
+    data.adpcm_music_paused = adpcm_music_paused;
 
     for(auto it = data.sound_map.begin(), end = data.sound_map.end(); it != end; )
     {
@@ -1420,7 +1888,7 @@ void commit()
 
 void stop()
 {
-    data.commands_count = 0;
+    data.commands_head = data.commands_tail;
     data.sound_map.clear();
 
     hw::audio::stop();
@@ -16,6 +16,7 @@ namespace bn
     class sound_item;
     class dmg_music_item;
     class dmg_music_position;
+    class adpcm_music_item;
 }
 
 namespace bn::audio_manager
@@ -108,6 +109,27 @@ namespace bn::audio_manager
     void set_dmg_music_master_volume(bn::dmg_music_master_volume volume);
 
 
+    // adpcm_music
+
+    [[nodiscard]] bool adpcm_music_playing();
+
+    [[nodiscard]] optional<adpcm_music_item> playing_adpcm_music_item();
+
+    void play_adpcm_music(const adpcm_music_item& item, fixed volume, bool loop);
+
+    void stop_adpcm_music();
+
+    [[nodiscard]] bool adpcm_music_paused();
+
+    void pause_adpcm_music();
+
+    void resume_adpcm_music();
+
+    [[nodiscard]] fixed adpcm_music_volume();
+
+    void set_adpcm_music_volume(fixed volume);
+
+
     // sound
 
     struct sound_data_type;
@@ -132,6 +154,16 @@ namespace bn::audio_manager
 
     void set_sound_panning(uint16_t handle, fixed panning);
 
+    [[nodiscard]] int active_sounds_count();
+
+    [[nodiscard]] int sound_deduplication_frames();
+
+    void set_sound_deduplication_frames(int frames);
+
+    [[nodiscard]] fixed sound_attenuation_distance();
+
+    void set_sound_attenuation_distance(fixed distance);
+
     void stop_all_sounds();
 
     [[nodiscard]] fixed sound_master_volume();
@@ -139,6 +171,28 @@ namespace bn::audio_manager
     void set_sound_master_volume(fixed volume);
 
 
+    // mixing
+
+    [[nodiscard]] int mixing_rate();
+
+    void set_mixing_rate(int mixing_rate);
+
+    [[nodiscard]] int max_channels();
+
+    void set_max_channels(int max_channels);
+
+    [[nodiscard]] int last_mixing_ticks();
+
+
+    // commands
+
+    [[nodiscard]] int coalesced_commands_count();
+
+    [[nodiscard]] int dropped_commands_count();
+
+    void reset_commands_counters();
+
+
     // other
 
     [[nodiscard]] bool update_on_vblank();
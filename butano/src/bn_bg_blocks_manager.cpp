@@ -9,7 +9,9 @@
 #include "bn_string_view.h"
 #include "bn_bgs_manager.h"
 #include "bn_config_bg_blocks.h"
+#include "bn_resumable_decompressor.h"
 #include "bn_affine_bg_big_map_canvas_size.h"
+#include "bn_regular_bg_big_map_chunks.h"
 #include "../hw/include/bn_hw_dma.h"
 #include "../hw/include/bn_hw_memory.h"
 #include "../hw/include/bn_hw_bg_blocks.h"
@@ -110,6 +112,10 @@ namespace
             hw::decompress::huff(source_ptr, destination_ptr);
             break;
 
+        case compression_type::FAST_LZ:
+            hw::decompress::fast_lz(source_ptr, destination_ptr);
+            break;
+
         default:
             BN_ERROR("Unknown compression type: ", int(compression));
             break;
@@ -119,7 +125,8 @@ namespace
     void _hw_commit_offset(const uint16_t* source_data_ptr, unsigned half_words, uint16_t offset,
                            uint16_t* destination_vram_ptr)
     {
-        if(half_words % 2 == 1)
+        // Tiles offset and palette offset are applied at once, since both are added to the map cells:
+        if(half_words && ! aligned<4>(destination_vram_ptr))
         {
             *destination_vram_ptr = *source_data_ptr + offset;
             ++source_data_ptr;
@@ -127,34 +134,41 @@ namespace
             --half_words;
         }
 
-        if(aligned<4>(source_data_ptr) && aligned<4>(destination_vram_ptr))
+        if(unsigned words = half_words / 2)
         {
             unsigned word_offset = (unsigned(offset) << 16) + offset;
+            auto destination_words_ptr = reinterpret_cast<unsigned*>(destination_vram_ptr);
 
-            if(unsigned blocks = half_words / 16)
+            if(aligned<4>(source_data_ptr))
             {
-                bn_hw_bg_blocks_commit_blocks(
-                            reinterpret_cast<const unsigned*>(source_data_ptr), blocks, word_offset,
-                            reinterpret_cast<unsigned*>(destination_vram_ptr));
-                source_data_ptr += blocks * 16;
-                destination_vram_ptr += blocks * 16;
-                half_words -= blocks * 16;
-            }
+                auto source_words_ptr = reinterpret_cast<const unsigned*>(source_data_ptr);
+
+                if(unsigned blocks = words / 8)
+                {
+                    bn_hw_bg_blocks_commit_blocks(source_words_ptr, blocks, word_offset, destination_words_ptr);
+                    source_words_ptr += blocks * 8;
+                    destination_words_ptr += blocks * 8;
+                }
 
-            if(unsigned words = half_words / 2)
+                if(unsigned remaining_words = words % 8)
+                {
+                    bn_hw_bg_blocks_commit_words(source_words_ptr, remaining_words, word_offset,
+                                                 destination_words_ptr);
+                }
+            }
+            else
             {
-                bn_hw_bg_blocks_commit_words(
-                            reinterpret_cast<const unsigned*>(source_data_ptr), words, word_offset,
-                            reinterpret_cast<unsigned*>(destination_vram_ptr));
-                source_data_ptr += words * 2;
-                destination_vram_ptr += words * 2;
-                half_words -= words * 2;
+                bn_hw_bg_blocks_commit_unaligned_words(source_data_ptr, words, word_offset, destination_words_ptr);
             }
+
+            source_data_ptr += words * 2;
+            destination_vram_ptr += words * 2;
+            half_words -= words * 2;
         }
 
         if(half_words)
         {
-            bn_hw_bg_blocks_commit_half_words(source_data_ptr, half_words, offset, destination_vram_ptr);
+            *destination_vram_ptr = *source_data_ptr + offset;
         }
     }
 
@@ -189,15 +203,22 @@ namespace
         optional<regular_bg_tiles_ptr> regular_tiles;
         optional<affine_bg_tiles_ptr> affine_tiles;
         optional<bg_palette_ptr> palette;
+        const regular_bg_streaming_tiles_item* streaming_tiles = nullptr;
+        uint16_t streaming_regions[regular_bg_streaming_tiles_item::banks_count];
         uint16_t width = 0; // If is_tiles == true, it stores half_words.
         uint16_t height = 0;
+        uint8_t dirty_x = 0;
+        uint8_t dirty_y = 0;
+        uint8_t dirty_width = 0;
+        uint8_t dirty_height = 0;
+        uint8_t streaming_banks_to_commit = 0;
         uint8_t start_block = 0;
         uint8_t blocks_count = 0;
         uint8_t next_index = max_list_items;
 
     private:
         uint8_t _status: 2 = uint8_t(status_type::FREE);
-        uint8_t _compression: 2 = uint8_t(compression_type::NONE);
+        uint8_t _compression: 3 = uint8_t(compression_type::NONE);
         uint8_t _big_map_canvas_size: 2 = uint8_t(affine_bg_big_map_canvas_size::NORMAL);
 
     public:
@@ -205,6 +226,7 @@ namespace
         bool is_big: 1 = false;
         bool is_affine: 1 = false;
         bool commit: 1 = false;
+        bool dirty: 1 = false;
 
         [[nodiscard]] status_type status() const
         {
@@ -466,6 +488,31 @@ namespace
     };
 
 
+    #if BN_CFG_BG_BLOCKS_BIG_MAP_CHUNKS > 0
+        class big_map_chunk
+        {
+
+        public:
+            const uint16_t* map_data = nullptr;
+            unsigned stamp = 0;
+            int index = 0;
+            alignas(int) uint16_t cells[regular_bg_big_map_chunks::cells];
+        };
+    #endif
+
+
+    #if BN_CFG_BG_BLOCKS_DEFRAG_MAX_BLOCKS
+        class relocation_data
+        {
+
+        public:
+            int source_block = 0;
+            int destination_block = 0;
+            int blocks_count = 0;
+        };
+    #endif
+
+
     class static_data
     {
 
@@ -478,9 +525,26 @@ namespace
         int to_remove_blocks_count = 0;
         int to_commit_uncompressed_items_count = 0;
         int to_commit_compressed_items_count = 0;
+        int committed_map_bytes = 0;
+        int last_committed_map_bytes = 0;
         bool allow_tiles_offset = true;
         bool check_commit = false;
         bool delay_commit = false;
+        bool commit_streaming_tiles = false;
+
+        #if BN_CFG_BG_BLOCKS_BIG_MAP_CHUNKS > 0
+            big_map_chunk big_map_chunks[BN_CFG_BG_BLOCKS_BIG_MAP_CHUNKS];
+            unsigned big_map_chunks_stamp = 0;
+        #endif
+
+        #if BN_CFG_BG_BLOCKS_DEFRAG_MAX_BLOCKS
+            relocation_data relocation;
+        #endif
+
+        #if BN_CFG_BG_BLOCKS_DECOMPRESSION_BYTES_PER_FRAME
+            resumable_decompressor decompressor;
+            int decompressing_id = -1;
+        #endif
     };
 
     BN_DATA_EWRAM_BSS static_data data;
@@ -743,7 +807,8 @@ namespace
 
             if(item.data == data_ptr && ! item.is_tiles && map_item.dimensions().width() == item.width &&
                     map_item.dimensions().height() == item.height && map_item.compression() == item.compression() &&
-                    map_item.big() == item.is_big && ! item.is_affine)
+                    map_item.big() == item.is_big && map_item.streaming_tiles_ptr() == item.streaming_tiles &&
+                    ! item.is_affine)
             {
                 const regular_bg_tiles_ptr* item_tiles = item.regular_tiles.get();
                 const bg_palette_ptr* item_palette = item.palette.get();
@@ -894,6 +959,7 @@ namespace
             uint16_t* destination_vram_ptr = hw::bg_blocks::vram(item.start_block);
             auto tiles_offset = unsigned(item.affine_tiles_offset());
             int half_words = (item.width * item.height) / 2;
+            data.committed_map_bytes += half_words * 2;
 
             if(tiles_offset)
             {
@@ -924,6 +990,7 @@ namespace
             auto tiles_offset = unsigned(item.regular_tiles_offset());
             auto palette_offset = unsigned(item.palette_offset());
             int half_words = item.width * item.height;
+            data.committed_map_bytes += half_words * 2;
 
             if(compression != compression_type::NONE && (tiles_offset || palette_offset))
             {
@@ -943,6 +1010,113 @@ namespace
         }
     }
 
+    void _commit_regular_map_cells(const item_type& item)
+    {
+        const uint16_t* source_data_ptr = item.data;
+        uint16_t* destination_vram_ptr = hw::bg_blocks::vram(item.start_block);
+        auto tiles_offset = unsigned(item.regular_tiles_offset());
+        auto palette_offset = unsigned(item.palette_offset());
+        uint16_t offset = hw::bg_blocks::regular_map_cells_offset(tiles_offset, palette_offset);
+        int map_screenblocks_columns = item.width / 32;
+        int x = item.dirty_x;
+        int y = item.dirty_y;
+        int width = item.dirty_width;
+        int height = item.dirty_height;
+        int column_limit = x + width;
+
+        for(int row = y, row_limit = y + height; row < row_limit; ++row)
+        {
+            int row_index = ((row / 32) * map_screenblocks_columns * 1024) + ((row & 31) * 32);
+
+            // Maps wider than 32 cells are split in 32x32 cells screenblocks:
+            for(int column = x; column < column_limit;)
+            {
+                int screenblock_column = column & 31;
+                int elements = min(32 - screenblock_column, column_limit - column);
+                int cell_index = row_index + ((column / 32) * 1024) + screenblock_column;
+
+                if(offset)
+                {
+                    _hw_commit_offset(source_data_ptr + cell_index, unsigned(elements), offset,
+                                      destination_vram_ptr + cell_index);
+                }
+                else
+                {
+                    hw::memory::copy_half_words(source_data_ptr + cell_index, elements,
+                                                destination_vram_ptr + cell_index);
+                }
+
+                column += elements;
+            }
+        }
+
+        data.committed_map_bytes += width * height * 2;
+    }
+
+    #if BN_CFG_BG_BLOCKS_DECOMPRESSION_BYTES_PER_FRAME
+        [[nodiscard]] bool _commit_compressed_item(int id, const item_type& item, int& max_bytes)
+        {
+            const uint16_t* source_data_ptr = item.data;
+
+            // Big maps are committed from bgs_manager:
+            if(! source_data_ptr || (! item.is_tiles && item.is_big))
+            {
+                return true;
+            }
+
+            resumable_decompressor& decompressor = data.decompressor;
+
+            if(data.decompressing_id != id || decompressor.source_ptr() != source_data_ptr)
+            {
+                decompressor.start(source_data_ptr, item.compression());
+                data.decompressing_id = id;
+            }
+
+            uint16_t* destination_vram_ptr = hw::bg_blocks::vram(item.start_block);
+            max_bytes -= decompressor.decompress(destination_vram_ptr, max_bytes);
+
+            if(! decompressor.finished())
+            {
+                return false;
+            }
+
+            decompressor.stop();
+
+            if(item.is_tiles)
+            {
+                return true;
+            }
+
+            // Map cells offsets are applied when the whole map has been decompressed:
+            if(item.is_affine)
+            {
+                int half_words = (item.width * item.height) / 2;
+                data.committed_map_bytes += half_words * 2;
+
+                if(auto tiles_offset = unsigned(item.affine_tiles_offset()))
+                {
+                    uint16_t offset = hw::bg_blocks::affine_map_cells_offset(tiles_offset);
+                    _hw_commit_offset(destination_vram_ptr, unsigned(half_words), offset, destination_vram_ptr);
+                }
+            }
+            else
+            {
+                int half_words = item.width * item.height;
+                auto tiles_offset = unsigned(item.regular_tiles_offset());
+                auto palette_offset = unsigned(item.palette_offset());
+                data.committed_map_bytes += half_words * 2;
+
+                if(tiles_offset || palette_offset)
+                {
+                    uint16_t offset = hw::bg_blocks::regular_map_cells_offset(tiles_offset, palette_offset);
+                    _hw_commit_offset(destination_vram_ptr, unsigned(half_words), offset, destination_vram_ptr);
+                }
+            }
+
+            return true;
+        }
+    #endif
+
     [[nodiscard]] int _create_item(int id, int padding_blocks_count, bool delay_commit, create_data&& create_data)
     {
         item_type* item = &data.items.item(id);
@@ -1016,6 +1190,14 @@ namespace
             break;
         }
 
+        #if BN_CFG_BG_BLOCKS_DECOMPRESSION_BYTES_PER_FRAME
+            // Compressed items are decompressed progressively:
+            if(create_data.compression != compression_type::NONE)
+            {
+                delay_commit = true;
+            }
+        #endif
+
         const uint16_t* data_ptr = create_data.data_ptr;
         item->data = data_ptr;
         item->blocks_count = uint8_t(blocks_count);
@@ -1024,6 +1206,8 @@ namespace
         item->regular_tiles = move(create_data.regular_tiles);
         item->affine_tiles = move(create_data.affine_tiles);
         item->palette = move(create_data.palette);
+        item->streaming_tiles = nullptr;
+        item->streaming_banks_to_commit = 0;
         item->width = uint16_t(create_data.width);
         item->height = uint16_t(create_data.height);
         item->usages = 1;
@@ -1211,6 +1395,306 @@ namespace
     {
         return _fix_map_x(map_y, map_height);
     }
+
+    [[nodiscard]] constexpr bool _valid_regular_map_compression(compression_type compression, bool big)
+    {
+        #if BN_CFG_BG_BLOCKS_BIG_MAP_CHUNKS > 0
+            return compression != compression_type::HUFFMAN || ! big;
+        #else
+            return compression == compression_type::NONE || ! big;
+        #endif
+    }
+
+    #if BN_CFG_BG_BLOCKS_BIG_MAP_CHUNKS > 0
+        const uint16_t* _big_map_chunk_cells(const uint16_t* map_data, int chunk_index)
+        {
+            unsigned stamp = ++data.big_map_chunks_stamp;
+            big_map_chunk* oldest_chunk = data.big_map_chunks;
+
+            for(big_map_chunk& chunk : data.big_map_chunks)
+            {
+                if(chunk.map_data == map_data && chunk.index == chunk_index)
+                {
+                    chunk.stamp = stamp;
+                    return chunk.cells;
+                }
+
+                if(chunk.stamp < oldest_chunk->stamp)
+                {
+                    oldest_chunk = &chunk;
+                }
+            }
+
+            regular_bg_big_map_chunks::decompress(map_data, chunk_index, oldest_chunk->cells);
+            oldest_chunk->map_data = map_data;
+            oldest_chunk->stamp = stamp;
+            oldest_chunk->index = chunk_index;
+            return oldest_chunk->cells;
+        }
+
+        void _remove_big_map_chunks(const uint16_t* map_data)
+        {
+            for(big_map_chunk& chunk : data.big_map_chunks)
+            {
+                if(chunk.map_data == map_data)
+                {
+                    chunk.map_data = nullptr;
+                    chunk.stamp = 0;
+                }
+            }
+        }
+    #endif
+
+    void _reset_streaming_regions(item_type& item)
+    {
+        for(uint16_t& streaming_region : item.streaming_regions)
+        {
+            streaming_region = numeric_limits<uint16_t>::max();
+        }
+
+        item.streaming_banks_to_commit = 0;
+    }
+
+    void _set_streaming_tiles(item_type& item, const regular_bg_streaming_tiles_item* streaming_tiles)
+    {
+        item.streaming_tiles = streaming_tiles;
+        _reset_streaming_regions(item);
+    }
+
+    [[nodiscard]] bool _valid_streaming_tiles_count(const regular_bg_streaming_tiles_item* streaming_tiles,
+                                                    const regular_bg_tiles_ptr& tiles)
+    {
+        return ! streaming_tiles || tiles.tiles_count() >= streaming_tiles->vram_tiles_count();
+    }
+
+    [[nodiscard]] int _streaming_region_index(const regular_bg_streaming_tiles_item& streaming_tiles, int map_width,
+                                              int map_x, int map_y)
+    {
+        const size& region_dimensions = streaming_tiles.region_dimensions();
+        int region_width = region_dimensions.width();
+        int regions_columns = map_width / region_width;
+        return ((map_y / region_dimensions.height()) * regions_columns) + (map_x / region_width);
+    }
+
+    [[nodiscard]] int _streaming_bank(const regular_bg_streaming_tiles_item& streaming_tiles, int map_x, int map_y)
+    {
+        // Adjacent regions always use different banks:
+        const size& region_dimensions = streaming_tiles.region_dimensions();
+        int region_x = map_x / region_dimensions.width();
+        int region_y = map_y / region_dimensions.height();
+        return (region_x & 1) + ((region_y & 1) * 2);
+    }
+
+    [[nodiscard]] bool _commit_big_map_by_blocks(const item_type& item)
+    {
+        #if BN_CFG_BG_BLOCKS_BIG_MAP_CHUNKS > 0
+            return item.streaming_tiles || item.compression() != compression_type::NONE;
+        #else
+            return item.streaming_tiles;
+        #endif
+    }
+
+    void _commit_big_map_blocks(const item_type& item, int x, int y, int width, int height)
+    {
+        constexpr int block_size = regular_bg_big_map_chunks::size;
+
+        const uint16_t* map_data = item.data;
+        const regular_bg_streaming_tiles_item* streaming_tiles = item.streaming_tiles;
+        int map_width = item.width;
+        int map_height = item.height;
+        uint16_t* vram_data = hw::bg_blocks::vram(item.start_block);
+        auto tiles_offset = unsigned(item.regular_tiles_offset());
+        auto palette_offset = unsigned(item.palette_offset());
+        unsigned bank_tiles_offset = 0;
+
+        if(streaming_tiles)
+        {
+            bank_tiles_offset = unsigned(streaming_tiles->bank_tiles_count());
+
+            if(item.palette->bpp() == bpp_mode::BPP_8)
+            {
+                bank_tiles_offset /= 2;
+            }
+        }
+
+        for(int row = 0; row < height;)
+        {
+            int map_y = _fix_map_y(y + row, map_height);
+            int block_y = map_y % block_size;
+            int block_rows = min(block_size - block_y, height - row);
+
+            for(int column = 0; column < width;)
+            {
+                int map_x = _fix_map_x(x + column, map_width);
+                int block_x = map_x % block_size;
+                int block_columns = min(block_size - block_x, width - column);
+                const uint16_t* source_data = map_data + ((map_y * map_width) + map_x);
+                int source_stride = map_width;
+
+                #if BN_CFG_BG_BLOCKS_BIG_MAP_CHUNKS > 0
+                    if(item.compression() != compression_type::NONE)
+                    {
+                        int chunk_index = regular_bg_big_map_chunks::index(map_x, map_y, map_width);
+                        source_data = _big_map_chunk_cells(map_data, chunk_index);
+                        source_data += (block_y * block_size) + block_x;
+                        source_stride = block_size;
+                    }
+                #endif
+
+                unsigned block_tiles_offset = tiles_offset;
+
+                if(streaming_tiles)
+                {
+                    int bank = _streaming_bank(*streaming_tiles, map_x, map_y);
+                    block_tiles_offset += unsigned(bank) * bank_tiles_offset;
+                }
+
+                uint16_t offset = hw::bg_blocks::regular_map_cells_offset(block_tiles_offset, palette_offset);
+
+                for(int block_row = 0; block_row < block_rows; ++block_row)
+                {
+                    uint16_t* dest_data = vram_data + (((map_y + block_row) & 31) * 32);
+
+                    for(int block_column = 0; block_column < block_columns; ++block_column)
+                    {
+                        dest_data[(map_x + block_column) & 31] = uint16_t(source_data[block_column] + offset);
+                    }
+
+                    source_data += source_stride;
+                }
+
+                column += block_columns;
+            }
+
+            row += block_rows;
+        }
+
+        data.committed_map_bytes += width * height * 2;
+    }
+
+    #if BN_CFG_BG_BLOCKS_DEFRAG_MAX_BLOCKS
+        [[nodiscard]] bool _map_references_tiles(const item_type& map_item, int tiles_start_block)
+        {
+            if(map_item.is_tiles || map_item.status() != status_type::USED)
+            {
+                return false;
+            }
+
+            if(map_item.is_affine)
+            {
+                const affine_bg_tiles_ptr* affine_tiles = map_item.affine_tiles.get();
+                return affine_tiles && affine_tiles->id() == tiles_start_block;
+            }
+
+            const regular_bg_tiles_ptr* regular_tiles = map_item.regular_tiles.get();
+            return regular_tiles && regular_tiles->id() == tiles_start_block;
+        }
+
+        [[nodiscard]] bool _movable_item(const item_type& item, int new_start_block)
+        {
+            // Allocated items can be modified from VRAM directly, so they can't be moved:
+            if(item.status() != status_type::USED || ! item.data)
+            {
+                return false;
+            }
+
+            // Items waiting to be committed (maybe decompressed progressively) are not moved:
+            if(item.commit)
+            {
+                return false;
+            }
+
+            if(! item.is_tiles)
+            {
+                return ! item.is_big;
+            }
+
+            int start_block = item.start_block;
+            int alignment_blocks_count = hw::bg_blocks::tiles_alignment_blocks_count();
+            bool offset_changed = start_block % alignment_blocks_count != new_start_block % alignment_blocks_count;
+
+            if(offset_changed && ! data.allow_tiles_offset)
+            {
+                return false;
+            }
+
+            bool bpp_4 = true;
+            int max_blocks_count;
+
+            for(item_type& map_item : data.items)
+            {
+                if(_map_references_tiles(map_item, start_block))
+                {
+                    // Maps which reference the tiles must be fully committed again if the tiles offset changes:
+                    if(offset_changed && (map_item.is_big || ! map_item.data ||
+                                          map_item.compression() != compression_type::NONE))
+                    {
+                        return false;
+                    }
+
+                    if(! map_item.is_affine && map_item.palette->bpp() == bpp_mode::BPP_8)
+                    {
+                        bpp_4 = false;
+                    }
+                }
+            }
+
+            if(item.is_affine)
+            {
+                max_blocks_count = hw::bg_blocks::max_affine_tiles_blocks_count();
+            }
+            else
+            {
+                max_blocks_count = bpp_4 ? hw::bg_blocks::max_bpp_4_regular_tiles_blocks_count() :
+                                           hw::bg_blocks::max_bpp_8_regular_tiles_blocks_count();
+            }
+
+            return (new_start_block % alignment_blocks_count) + item.blocks_count <= max_blocks_count;
+        }
+
+        void _move_item(item_type& item, int new_start_block)
+        {
+            int start_block = item.start_block;
+
+            if(item.is_tiles)
+            {
+                int alignment_blocks_count = hw::bg_blocks::tiles_alignment_blocks_count();
+                int new_tiles_cbb = new_start_block / alignment_blocks_count;
+                bool tiles_cbb_changed = start_block / alignment_blocks_count != new_tiles_cbb;
+                bool offset_changed = start_block % alignment_blocks_count != new_start_block % alignment_blocks_count;
+
+                for(item_type& map_item : data.items)
+                {
+                    if(_map_references_tiles(map_item, start_block))
+                    {
+                        if(tiles_cbb_changed)
+                        {
+                            if(map_item.is_affine)
+                            {
+                                bgs_manager::update_affine_map_tiles_cbb(map_item.start_block, new_tiles_cbb);
+                            }
+                            else
+                            {
+                                bgs_manager::update_regular_map_tiles_cbb(map_item.start_block, new_tiles_cbb);
+                            }
+                        }
+
+                        if(offset_changed)
+                        {
+                            map_item.commit = true;
+                            data.check_commit = true;
+                        }
+                    }
+                }
+            }
+            else
+            {
+                bgs_manager::update_map_sbb(start_block, new_start_block);
+            }
+
+            item.start_block = uint8_t(new_start_block);
+        }
+    #endif
 }
 
 void init()
@@ -1287,6 +1771,33 @@ int available_map_blocks_count()
     return data.free_blocks_count;
 }
 
+int last_committed_map_bytes()
+{
+    return data.last_committed_map_bytes;
+}
+
+fixed fragmentation()
+{
+    int free_blocks_count = data.free_blocks_count;
+
+    if(! free_blocks_count)
+    {
+        return 0;
+    }
+
+    int biggest_free_item_blocks_count = 0;
+
+    for(const item_type& item : data.items)
+    {
+        if(item.status() == status_type::FREE)
+        {
+            biggest_free_item_blocks_count = max(biggest_free_item_blocks_count, int(item.blocks_count));
+        }
+    }
+
+    return 1 - (fixed(biggest_free_item_blocks_count) / free_blocks_count);
+}
+
 affine_bg_big_map_canvas_size new_affine_big_map_canvas_size()
 {
     return data.new_affine_big_map_canvas_info.canvas_size();
@@ -1526,13 +2037,16 @@ int create_regular_map(const regular_bg_map_item& map_item, const regular_bg_map
     BN_ASSERT(aligned<4>(data_ptr), "Map cells are not aligned");
     BN_ASSERT(regular_bg_tiles_item::valid_tiles_count(tiles.tiles_count(), palette.bpp()),
               "Invalid tiles count: ", tiles.tiles_count(), " - ", int(palette.bpp()));
-    BN_BASIC_ASSERT(compression == compression_type::NONE || ! big, "Compressed big maps are not supported");
+    BN_BASIC_ASSERT(_valid_regular_map_compression(compression, big), "Compressed big maps are not supported");
+    BN_ASSERT(_valid_streaming_tiles_count(map_item.streaming_tiles_ptr(), tiles),
+              "Not enough tiles to stream the map regions: ", tiles.tiles_count());
 
     result = _create_impl(
                 create_data::from_regular_map(data_ptr, dimensions, compression, big, move(tiles), move(palette)));
 
     if(result >= 0)
     {
+        _set_streaming_tiles(data.items.item(result), map_item.streaming_tiles_ptr());
         BN_BG_BLOCKS_LOG("CREATED. start_block: ", data.items.item(result).start_block);
         BN_BG_BLOCKS_LOG_STATUS();
     }
@@ -1633,13 +2147,16 @@ int create_new_regular_map(const regular_bg_map_item& map_item, const regular_bg
     BN_ASSERT(aligned<4>(data_ptr), "Map cells are not aligned");
     BN_ASSERT(regular_bg_tiles_item::valid_tiles_count(tiles.tiles_count(), palette.bpp()),
               "Invalid tiles count: ", tiles.tiles_count(), " - ", int(palette.bpp()));
-    BN_BASIC_ASSERT(compression == compression_type::NONE || ! big, "Compressed big maps are not supported");
+    BN_BASIC_ASSERT(_valid_regular_map_compression(compression, big), "Compressed big maps are not supported");
+    BN_ASSERT(_valid_streaming_tiles_count(map_item.streaming_tiles_ptr(), tiles),
+              "Not enough tiles to stream the map regions: ", tiles.tiles_count());
 
     int result = _create_impl(
                 create_data::from_regular_map(data_ptr, dimensions, compression, big, move(tiles), move(palette)));
 
     if(result >= 0)
     {
+        _set_streaming_tiles(data.items.item(result), map_item.streaming_tiles_ptr());
         BN_BG_BLOCKS_LOG("CREATED. start_block: ", data.items.item(result).start_block);
         BN_BG_BLOCKS_LOG_STATUS();
     }
@@ -2096,9 +2613,13 @@ void set_regular_map_cells_ref(int id, const regular_bg_map_item& map_item, cons
                     "Map height does not match item map height: ", map_item.dimensions().height(), " - ", item.height);
     BN_BASIC_ASSERT(map_item.big() == item.is_big, "Map big does not match item map big: ",
                     map_item.big(), " - ", item.is_big);
-    BN_BASIC_ASSERT(compression == compression_type::NONE || ! map_item.big(),
+    BN_BASIC_ASSERT(_valid_regular_map_compression(compression, map_item.big()),
                     "Compressed big maps are not supported");
 
+    const regular_bg_streaming_tiles_item* streaming_tiles = map_item.streaming_tiles_ptr();
+    BN_ASSERT(! item.regular_tiles || _valid_streaming_tiles_count(streaming_tiles, *item.regular_tiles),
+              "Not enough tiles to stream the map regions: ", item.regular_tiles->tiles_count());
+
     if(item_data != data_ptr)
     {
         BN_BASIC_ASSERT(item_data, "Item has no data");
@@ -2106,14 +2627,16 @@ void set_regular_map_cells_ref(int id, const regular_bg_map_item& map_item, cons
 
         item.data = data_ptr;
         item.set_compression(compression);
+        _set_streaming_tiles(item, streaming_tiles);
         item.commit = true;
         data.check_commit = true;
 
         BN_BG_BLOCKS_LOG_STATUS();
     }
-    else if(compression != item.compression())
+    else if(compression != item.compression() || streaming_tiles != item.streaming_tiles)
     {
         item.set_compression(compression);
+        _set_streaming_tiles(item, streaming_tiles);
         item.commit = true;
         data.check_commit = true;
 
@@ -2172,12 +2695,64 @@ void reload(int id)
 
     BN_BASIC_ASSERT(item.data, "Item has no data");
 
+    #if BN_CFG_BG_BLOCKS_BIG_MAP_CHUNKS > 0
+        _remove_big_map_chunks(item.data);
+    #endif
+
+    _reset_streaming_regions(item);
     item.commit = true;
     data.check_commit = true;
 
     BN_BG_BLOCKS_LOG_STATUS();
 }
 
+void reload_regular_map_cells(int id, int x, int y, int width, int height)
+{
+    item_type& item = data.items.item(id);
+
+    BN_BG_BLOCKS_LOG("bg_blocks_manager - RELOAD REGULAR MAP CELLS: ", id, " - ", item.start_block, " - ",
+                     x, " - ", y, " - ", width, " - ", height);
+
+    BN_BASIC_ASSERT(item.data, "Item has no data");
+    BN_ASSERT(x >= 0 && width > 0 && x + width <= item.width,
+              "Invalid x or width: ", x, " - ", width, " - ", item.width);
+    BN_ASSERT(y >= 0 && height > 0 && y + height <= item.height,
+              "Invalid y or height: ", y, " - ", height, " - ", item.height);
+
+    if(item.commit)
+    {
+        return;
+    }
+
+    // Big and compressed maps can't be committed partially:
+    if(item.is_big || item.compression() != compression_type::NONE)
+    {
+        reload(id);
+        return;
+    }
+
+    if(item.dirty)
+    {
+        int dirty_x = item.dirty_x;
+        int dirty_y = item.dirty_y;
+        int right = max(x + width, dirty_x + item.dirty_width);
+        int bottom = max(y + height, dirty_y + item.dirty_height);
+        x = min(x, dirty_x);
+        y = min(y, dirty_y);
+        width = right - x;
+        height = bottom - y;
+    }
+
+    item.dirty_x = uint8_t(x);
+    item.dirty_y = uint8_t(y);
+    item.dirty_width = uint8_t(width);
+    item.dirty_height = uint8_t(height);
+    item.dirty = true;
+    data.check_commit = true;
+
+    BN_BG_BLOCKS_LOG_STATUS();
+}
+
 const regular_bg_tiles_ptr& regular_map_tiles(int id)
 {
     const item_type& item = data.items.item(id);
@@ -2222,7 +2797,17 @@ void set_regular_map_tiles(int id, regular_bg_tiles_ptr&& tiles)
 
         item.regular_tiles = move(tiles);
 
-        if(item.regular_tiles_offset() != old_tiles_offset)
+        if(item.streaming_tiles)
+        {
+            BN_ASSERT(_valid_streaming_tiles_count(item.streaming_tiles, *item.regular_tiles),
+                      "Not enough tiles to stream the map regions: ", item.regular_tiles->tiles_count());
+
+            // Streamed tiles must be loaded again in the new tiles:
+            _reset_streaming_regions(item);
+            item.commit = true;
+            data.check_commit = true;
+        }
+        else if(item.regular_tiles_offset() != old_tiles_offset)
         {
             item.commit = true;
             data.check_commit = true;
@@ -2457,6 +3042,12 @@ void update_regular_map_col(int id, int x, int y)
         return;
     }
 
+    if(_commit_big_map_by_blocks(item))
+    {
+        _commit_big_map_blocks(item, x, y, 1, 32);
+        return;
+    }
+
     int map_width = item.width;
     int map_height = item.height;
     x = _fix_map_x(x, map_width);
@@ -2470,44 +3061,16 @@ void update_regular_map_col(int id, int x, int y)
     uint16_t* dest_data = hw::bg_blocks::vram(item.start_block) + (y_separator * 32) + (x & 31);
     auto tiles_offset = unsigned(item.regular_tiles_offset());
     auto palette_offset = unsigned(item.palette_offset());
+    uint16_t offset = hw::bg_blocks::regular_map_cells_offset(tiles_offset, palette_offset);
+    auto source_stride = unsigned(map_width * 2);
+    data.committed_map_bytes += 32 * 2;
 
-    if(tiles_offset || palette_offset)
-    {
-        uint16_t offset = hw::bg_blocks::regular_map_cells_offset(tiles_offset, palette_offset);
+    bn_hw_bg_blocks_commit_column(first_source_data, source_stride, unsigned(32 - y_separator), offset, dest_data);
 
-        for(int iy = y_separator; iy < 32; ++iy)
-        {
-            *dest_data = *first_source_data + offset;
-            dest_data += 32;
-            first_source_data += map_width;
-        }
-
-        dest_data -= 1024;
-
-        for(int iy = 0; iy < y_separator; ++iy)
-        {
-            *dest_data = *second_source_data + offset;
-            dest_data += 32;
-            second_source_data += map_width;
-        }
-    }
-    else
+    if(y_separator)
     {
-        for(int iy = y_separator; iy < 32; ++iy)
-        {
-            *dest_data = *first_source_data;
-            dest_data += 32;
-            first_source_data += map_width;
-        }
-
-        dest_data -= 1024;
-
-        for(int iy = 0; iy < y_separator; ++iy)
-        {
-            *dest_data = *second_source_data;
-            dest_data += 32;
-            second_source_data += map_width;
-        }
+        dest_data -= y_separator * 32;
+        bn_hw_bg_blocks_commit_column(second_source_data, source_stride, unsigned(y_separator), offset, dest_data);
     }
 }
 
@@ -2542,6 +3105,7 @@ void update_affine_map_col(int id, int x, int y)
     const uint8_t* second_source_data = item_data + ((second_y * map_width) + x);
     auto dest_data = reinterpret_cast<uint8_t*>(hw::bg_blocks::vram(item.start_block));
     dest_data += ((y_separator << canvas_size_bits) + (x & canvas_viewport_size));
+    data.committed_map_bytes += canvas_size;
 
     if(auto tiles_offset = unsigned(item.affine_tiles_offset()))
     {
@@ -2656,6 +3220,12 @@ void update_regular_map_row(int id, int x, int y)
         return;
     }
 
+    if(_commit_big_map_by_blocks(item))
+    {
+        _commit_big_map_blocks(item, x, y, 32, 1);
+        return;
+    }
+
     int map_width = item.width;
     int map_height = item.height;
     x = _fix_map_x(x, map_width);
@@ -2670,6 +3240,7 @@ void update_regular_map_row(int id, int x, int y)
     uint16_t* dest_data = hw::bg_blocks::vram(item.start_block) + (((y & 31) * 32) + x_separator);
     auto tiles_offset = unsigned(item.regular_tiles_offset());
     auto palette_offset = unsigned(item.palette_offset());
+    data.committed_map_bytes += 32 * 2;
 
     if(tiles_offset || palette_offset)
     {
@@ -2718,6 +3289,7 @@ void update_affine_map_row(int id, int x, int y)
     const uint8_t* second_source_data = item_data + ((y * map_width) + second_x);
     auto dest_data = reinterpret_cast<uint8_t*>(hw::bg_blocks::vram(item.start_block));
     dest_data += ((y & canvas_viewport_size) << canvas_size_bits) + x_separator;
+    data.committed_map_bytes += canvas_info.size();
 
     if(auto tiles_offset = unsigned(item.affine_tiles_offset()))
     {
@@ -2753,6 +3325,12 @@ void set_regular_map_position(int id, int x, int y)
         return;
     }
 
+    if(_commit_big_map_by_blocks(item))
+    {
+        _commit_big_map_blocks(item, x, y, 32, 32);
+        return;
+    }
+
     int map_width = item.width;
     int map_height = item.height;
     x = _fix_map_x(x, map_width);
@@ -2764,6 +3342,7 @@ void set_regular_map_position(int id, int x, int y)
     int second_x = _fix_map_x(x + elements, map_width);
     auto tiles_offset = unsigned(item.regular_tiles_offset());
     auto palette_offset = unsigned(item.palette_offset());
+    data.committed_map_bytes += 32 * 32 * 2;
 
     if(tiles_offset || palette_offset)
     {
@@ -2809,6 +3388,77 @@ void set_regular_map_position(int id, int x, int y)
     }
 }
 
+void load_regular_map_tiles(int id, int x, int y)
+{
+    item_type& item = data.items.item(id);
+    const regular_bg_streaming_tiles_item* streaming_tiles = item.streaming_tiles;
+
+    if(! streaming_tiles || ! item.data || ! item.regular_tiles)
+    {
+        return;
+    }
+
+    int map_width = item.width;
+    int map_height = item.height;
+    x = _fix_map_x(x, map_width);
+    y = _fix_map_y(y, map_height);
+
+    // The 32x32 cells area can't overlap more than 2x2 regions:
+    int columns[2] = { x, _fix_map_x(x + 31, map_width) };
+    int rows[2] = { y, _fix_map_y(y + 31, map_height) };
+
+    for(int row : rows)
+    {
+        for(int column : columns)
+        {
+            int region_index = _streaming_region_index(*streaming_tiles, map_width, column, row);
+            int bank = _streaming_bank(*streaming_tiles, column, row);
+            uint16_t& bank_region = item.streaming_regions[bank];
+
+            if(bank_region != region_index)
+            {
+                BN_ASSERT(streaming_tiles->region_tiles_ref(region_index).size() <=
+                          streaming_tiles->bank_tiles_count(), "Too many region tiles: ", region_index, " - ",
+                          streaming_tiles->region_tiles_ref(region_index).size());
+
+                bank_region = uint16_t(region_index);
+                item.streaming_banks_to_commit |= uint8_t(1 << bank);
+                data.commit_streaming_tiles = true;
+            }
+        }
+    }
+}
+
+#if BN_CFG_BG_BLOCKS_BIG_MAP_CHUNKS > 0
+    void load_regular_map_chunks(int id, int x, int y)
+    {
+        const item_type& item = data.items.item(id);
+        const uint16_t* item_data = item.data;
+
+        if(! item_data || item.compression() == compression_type::NONE)
+        {
+            return;
+        }
+
+        constexpr int chunk_size = regular_bg_big_map_chunks::size;
+        int map_width = item.width;
+        int map_height = item.height;
+        int first_x = x - (_fix_map_x(x, map_width) % chunk_size);
+        int first_y = y - (_fix_map_y(y, map_height) % chunk_size);
+
+        for(int row = first_y, row_limit = y + 32; row < row_limit; row += chunk_size)
+        {
+            int map_y = _fix_map_y(row, map_height);
+
+            for(int column = first_x, column_limit = x + 32; column < column_limit; column += chunk_size)
+            {
+                int map_x = _fix_map_x(column, map_width);
+                _big_map_chunk_cells(item_data, regular_bg_big_map_chunks::index(map_x, map_y, map_width));
+            }
+        }
+    }
+#endif
+
 void set_affine_map_position(int id, int x, int y)
 {
     // BN_ASSERT(x % 2 == 0, "Invalid x: ", x);
@@ -2837,6 +3487,7 @@ void set_affine_map_position(int id, int x, int y)
     int x_separator = x & canvas_viewport_size;
     int elements = canvas_info.size() - x_separator;
     int second_x = _fix_map_x(x + elements, map_width);
+    data.committed_map_bytes += canvas_info.cells();
 
     if(auto tiles_offset = unsigned(item.affine_tiles_offset()))
     {
@@ -2884,8 +3535,112 @@ void set_affine_map_position(int id, int x, int y)
     }
 }
 
+#if BN_CFG_BG_BLOCKS_DEFRAG_MAX_BLOCKS
+    void defragment()
+    {
+        relocation_data& relocation = data.relocation;
+
+        if(relocation.blocks_count || ! data.free_blocks_count)
+        {
+            return;
+        }
+
+        auto end = data.items.end();
+        auto previous_iterator = data.items.before_begin();
+        auto iterator = data.items.begin();
+
+        while(iterator != end)
+        {
+            const item_type& free_item = *iterator;
+
+            if(free_item.status() == status_type::FREE)
+            {
+                // The items placed after the free item are moved to its start:
+                int free_blocks_count = free_item.blocks_count;
+                auto last_moved_iterator = iterator;
+                auto moved_iterator = iterator;
+                ++moved_iterator;
+
+                int moved_blocks_count = 0;
+
+                while(moved_iterator != end)
+                {
+                    const item_type& moved_item = *moved_iterator;
+                    int next_moved_blocks_count = moved_blocks_count + moved_item.blocks_count;
+
+                    if(next_moved_blocks_count > BN_CFG_BG_BLOCKS_DEFRAG_MAX_BLOCKS ||
+                            ! _movable_item(moved_item, moved_item.start_block - free_blocks_count))
+                    {
+                        break;
+                    }
+
+                    moved_blocks_count = next_moved_blocks_count;
+                    last_moved_iterator = moved_iterator;
+                    ++moved_iterator;
+                }
+
+                if(moved_blocks_count)
+                {
+                    int destination_block = free_item.start_block;
+                    int source_block = destination_block + free_blocks_count;
+                    int last_moved_id = last_moved_iterator.id();
+                    moved_iterator = data.items.erase_after(previous_iterator.id());
+
+                    while(true)
+                    {
+                        item_type& moved_item = *moved_iterator;
+                        _move_item(moved_item, moved_item.start_block - free_blocks_count);
+
+                        if(moved_iterator.id() == last_moved_id)
+                        {
+                            break;
+                        }
+
+                        ++moved_iterator;
+                    }
+
+                    // And the free item is moved after them:
+                    item_type new_free_item;
+                    new_free_item.start_block = uint8_t(destination_block + moved_blocks_count);
+                    new_free_item.blocks_count = uint8_t(free_blocks_count);
+
+                    auto new_free_iterator = data.items.insert_after(last_moved_id, new_free_item);
+                    auto next_iterator = new_free_iterator;
+                    ++next_iterator;
+
+                    if(next_iterator != end && next_iterator->status() == status_type::FREE)
+                    {
+                        new_free_iterator->blocks_count += next_iterator->blocks_count;
+                        data.items.erase_after(new_free_iterator.id());
+                    }
+
+                    relocation.source_block = source_block;
+                    relocation.destination_block = destination_block;
+                    relocation.blocks_count = moved_blocks_count;
+
+                    BN_BG_BLOCKS_LOG("bg_blocks_manager - DEFRAGMENT: ", source_block, " - ", destination_block,
+                                     " - ", moved_blocks_count);
+                    BN_BG_BLOCKS_LOG_STATUS();
+                    return;
+                }
+            }
+
+            previous_iterator = iterator;
+            ++iterator;
+        }
+    }
+
+    bool relocated()
+    {
+        return data.relocation.blocks_count;
+    }
+#endif
+
 void update()
 {
+    data.last_committed_map_bytes = data.committed_map_bytes;
+    data.committed_map_bytes = 0;
+
     if(data.to_remove_blocks_count || data.check_commit)
     {
         BN_BG_BLOCKS_LOG("bg_blocks_manager - UPDATE");
@@ -2901,6 +3656,15 @@ void update()
         data.to_remove_blocks_count = 0;
         data.check_commit = false;
 
+        #if BN_CFG_BG_BLOCKS_DECOMPRESSION_BYTES_PER_FRAME
+            // Items to remove are freed, so their decompression can't be resumed:
+            if(data.decompressor.source_ptr() &&
+                    data.items.item(data.decompressing_id).status() == status_type::TO_REMOVE)
+            {
+                data.decompressor.stop();
+            }
+        #endif
+
         while(iterator != end)
         {
             item_type& item = *iterator;
@@ -2913,6 +3677,7 @@ void update()
                 item.height = 0;
                 item.set_status(status_type::FREE);
                 item.commit = false;
+                item.dirty = false;
                 data.free_blocks_count += item.blocks_count;
 
                 auto next_iterator = iterator;
@@ -2940,7 +3705,7 @@ void update()
                     }
                 }
             }
-            else if(item.commit)
+            else if(item.commit || item.dirty)
             {
                 if(item.compression() == compression_type::NONE)
                 {
@@ -2970,6 +3735,25 @@ void update()
 
 void commit_uncompressed(bool use_dma)
 {
+    #if BN_CFG_BG_BLOCKS_DEFRAG_MAX_BLOCKS
+        // Blocks must be moved before committing other items to the free space:
+        relocation_data& relocation = data.relocation;
+
+        if(int blocks_count = relocation.blocks_count)
+        {
+            if(use_dma)
+            {
+                hw::bg_blocks::move_with_dma(relocation.source_block, blocks_count, relocation.destination_block);
+            }
+            else
+            {
+                hw::bg_blocks::move_with_cpu(relocation.source_block, blocks_count, relocation.destination_block);
+            }
+
+            relocation.blocks_count = 0;
+        }
+    #endif
+
     if(int commit_items_count = data.to_commit_uncompressed_items_count)
     {
         BN_BG_BLOCKS_LOG("bg_blocks_manager - COMMIT UNCOMPRESSED");
@@ -2978,14 +3762,54 @@ void commit_uncompressed(bool use_dma)
         {
             int item_index = data.to_commit_uncompressed_items_array[index];
             item_type& item = data.items.item(item_index);
-            item.commit = false;
-            _commit_item(item, use_dma);
+            item.dirty = false;
+
+            if(item.commit)
+            {
+                item.commit = false;
+                _commit_item(item, use_dma);
+            }
+            else
+            {
+                _commit_regular_map_cells(item);
+            }
         }
 
         data.to_commit_uncompressed_items_count = 0;
 
         BN_BG_BLOCKS_LOG_STATUS();
     }
+
+    // Streamed tiles are committed after the tiles they replace:
+    if(data.commit_streaming_tiles)
+    {
+        data.commit_streaming_tiles = false;
+
+        for(item_type& item : data.items)
+        {
+            unsigned banks_to_commit = item.streaming_banks_to_commit;
+            const regular_bg_tiles_ptr* regular_tiles = item.regular_tiles.get();
+            item.streaming_banks_to_commit = 0;
+
+            if(banks_to_commit && regular_tiles)
+            {
+                const regular_bg_streaming_tiles_item& streaming_tiles = *item.streaming_tiles;
+                int bank_half_words = streaming_tiles.bank_tiles_count() * int(sizeof(tile) / 2);
+                uint16_t* vram_tiles_ptr = hw::bg_blocks::vram(regular_tiles->id());
+
+                for(int bank = 0; bank < regular_bg_streaming_tiles_item::banks_count; ++bank)
+                {
+                    if(banks_to_commit & (1 << bank))
+                    {
+                        span<const tile> region_tiles = streaming_tiles.region_tiles_ref(item.streaming_regions[bank]);
+                        _hw_commit(reinterpret_cast<const uint16_t*>(region_tiles.data()), compression_type::NONE,
+                                   region_tiles.size() * int(sizeof(tile) / 2), use_dma,
+                                   vram_tiles_ptr + (bank * bank_half_words));
+                    }
+                }
+            }
+        }
+    }
 }
 
 void commit_compressed()
@@ -2994,15 +3818,59 @@ void commit_compressed()
     {
         BN_BG_BLOCKS_LOG("bg_blocks_manager - COMMIT COMPRESSED");
 
-        for(int index = 0; index < commit_items_count; ++index)
-        {
-            int item_index = data.to_commit_compressed_items_array[index];
-            item_type& item = data.items.item(item_index);
-            item.commit = false;
-            _commit_item(item, false);
-        }
+        #if BN_CFG_BG_BLOCKS_DECOMPRESSION_BYTES_PER_FRAME
+            uint8_t* items_array = data.to_commit_compressed_items_array;
+            int max_bytes = BN_CFG_BG_BLOCKS_DECOMPRESSION_BYTES_PER_FRAME;
+            int committed_items_count = 0;
 
-        data.to_commit_compressed_items_count = 0;
+            // The item being decompressed is committed first:
+            if(data.decompressor.source_ptr())
+            {
+                for(int index = 1; index < commit_items_count; ++index)
+                {
+                    if(items_array[index] == data.decompressing_id)
+                    {
+                        swap(items_array[0], items_array[index]);
+                        break;
+                    }
+                }
+            }
+
+            while(committed_items_count < commit_items_count && max_bytes > 0)
+            {
+                int item_index = items_array[committed_items_count];
+                item_type& item = data.items.item(item_index);
+
+                if(! _commit_compressed_item(item_index, item, max_bytes))
+                {
+                    break;
+                }
+
+                item.commit = false;
+                item.dirty = false;
+                ++committed_items_count;
+            }
+
+            commit_items_count -= committed_items_count;
+
+            for(int index = 0; index < commit_items_count; ++index)
+            {
+                items_array[index] = items_array[index + committed_items_count];
+            }
+
+            data.to_commit_compressed_items_count = commit_items_count;
+        #else
+            for(int index = 0; index < commit_items_count; ++index)
+            {
+                int item_index = data.to_commit_compressed_items_array[index];
+                item_type& item = data.items.item(item_index);
+                item.commit = false;
+                item.dirty = false;
+                _commit_item(item, false);
+            }
+
+            data.to_commit_compressed_items_count = 0;
+        #endif
 
         BN_BG_BLOCKS_LOG_STATUS();
     }
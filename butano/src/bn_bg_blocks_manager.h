@@ -7,8 +7,10 @@
 #define BN_BG_BLOCKS_MANAGER_H
 
 #include "bn_span.h"
+#include "bn_fixed.h"
 #include "bn_optional.h"
 #include "bn_config_log.h"
+#include "bn_config_bg_blocks.h"
 #include "bn_affine_bg_map_cell.h"
 #include "bn_regular_bg_map_cell.h"
 
@@ -48,6 +50,10 @@ namespace bn::bg_blocks_manager
 
     [[nodiscard]] int available_map_blocks_count();
 
+    [[nodiscard]] int last_committed_map_bytes();
+
+    [[nodiscard]] fixed fragmentation();
+
     [[nodiscard]] affine_bg_big_map_canvas_size new_affine_big_map_canvas_size();
 
     void set_new_affine_big_map_canvas_size(affine_bg_big_map_canvas_size affine_big_map_canvas_size);
@@ -142,6 +148,8 @@ namespace bn::bg_blocks_manager
 
     void reload(int id);
 
+    void reload_regular_map_cells(int id, int x, int y, int width, int height);
+
     [[nodiscard]] const regular_bg_tiles_ptr& regular_map_tiles(int id);
 
     [[nodiscard]] const affine_bg_tiles_ptr& affine_map_tiles(int id);
@@ -216,8 +224,20 @@ namespace bn::bg_blocks_manager
 
     void set_regular_map_position(int id, int x, int y);
 
+    void load_regular_map_tiles(int id, int x, int y);
+
+    #if BN_CFG_BG_BLOCKS_BIG_MAP_CHUNKS > 0
+        void load_regular_map_chunks(int id, int x, int y);
+    #endif
+
     void set_affine_map_position(int id, int x, int y);
 
+    #if BN_CFG_BG_BLOCKS_DEFRAG_MAX_BLOCKS
+        void defragment();
+
+        [[nodiscard]] bool relocated();
+    #endif
+
     void update();
 
     void commit_uncompressed(bool use_dma);
@@ -30,6 +30,16 @@ int available_blocks_count()
     return bg_blocks_manager::available_map_blocks_count();
 }
 
+fixed fragmentation()
+{
+    return bg_blocks_manager::fragmentation();
+}
+
+int last_committed_bytes()
+{
+    return bg_blocks_manager::last_committed_map_bytes();
+}
+
 affine_bg_big_map_canvas_size new_affine_big_map_canvas_size()
 {
     return bg_blocks_manager::new_affine_big_map_canvas_size();
@@ -30,6 +30,11 @@ int available_blocks_count()
     return bg_blocks_manager::available_tile_blocks_count();
 }
 
+fixed fragmentation()
+{
+    return bg_blocks_manager::fragmentation();
+}
+
 bool allow_offset()
 {
     return bg_blocks_manager::allow_tiles_offset();
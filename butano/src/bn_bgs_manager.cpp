@@ -442,6 +442,16 @@ namespace
                     item->commit_big_map = true;
                     item->full_commit_big_map = full_commit_big_map || bn::abs(new_map_x - old_map_x) > 8 ||
                             bn::abs(new_map_y - old_map_y) > 8;
+
+                    if(item_regular_map)
+                    {
+                        bg_blocks_manager::load_regular_map_tiles(map_handle, new_map_x, new_map_y);
+
+                        #if BN_CFG_BG_BLOCKS_BIG_MAP_CHUNKS > 0
+                            // Chunks are decompressed here to avoid doing it in VBlank:
+                            bg_blocks_manager::load_regular_map_chunks(map_handle, new_map_x, new_map_y);
+                        #endif
+                    }
                 }
             }
         }
@@ -1485,6 +1495,21 @@ void update_regular_map_palette_bpp(int map_id, bpp_mode bpp)
     }
 }
 
+void update_map_sbb(int map_id, int new_map_id)
+{
+    for(item_type* item : data.items_vector)
+    {
+        regular_bg_map_ptr* item_regular_map = item->regular_map.get();
+        int item_map_id = item_regular_map ? item_regular_map->id() : item->affine_map->id();
+
+        if(item_map_id == map_id)
+        {
+            hw::bgs::set_map_sbb(new_map_id, item->hw_cnt);
+            _update_item_hw_cnt(*item);
+        }
+    }
+}
+
 void reload()
 {
     data.commit = true;
@@ -196,6 +196,8 @@ namespace bgs_manager
 
     void update_regular_map_palette_bpp(int map_id, bpp_mode bpp);
 
+    void update_map_sbb(int map_id, int new_map_id);
+
     void reload();
 
     void fill_hblank_effect_regular_positions(int base_position, const fixed* positions_ptr, uint16_t* dest_ptr);
@@ -13,6 +13,8 @@
 #include "bn_timers.h"
 #include "bn_version.h"
 #include "bn_profiler.h"
+#include "bn_frame_stats.h"
+#include "bn_config_core.h"
 #include "bn_system_font.h"
 #include "bn_bgs_manager.h"
 #include "bn_hdma_manager.h"
@@ -131,18 +133,51 @@ namespace
         #endif
         timer cpu_usage_timer;
         ticks last_ticks;
+        frame_stats frame_stats_array[BN_CFG_CORE_MAX_FRAME_STATS];
         bn::system_font system_font;
         string_view assert_tag = BN_VERSION_STRING " " BN_TOOLCHAIN_TAG;
         int skip_frames = 0;
         int last_update_frames = 1;
         int missed_frames = 0;
+        int last_frame_stats_index = 0;
+        int last_frame_stats_count = 0;
         bool dma_enabled = true;
         bool slow_game_pak = false;
         volatile bool waiting_for_vblank = false;
     };
 
+    static_assert(BN_CFG_CORE_MAX_FRAME_STATS > 0, "Invalid max frame stats");
+
     BN_DATA_EWRAM_BSS static_data data;
 
+
+    class frame_stats_builder
+    {
+
+    public:
+        explicit frame_stats_builder(frame_stats& stats) :
+            _stats(stats),
+            _last_ticks(data.cpu_usage_timer.elapsed_ticks())
+        {
+        }
+
+        void add(frame_stats_phase phase)
+        {
+            int ticks = data.cpu_usage_timer.elapsed_ticks();
+            _stats.set_ticks(phase, _stats.ticks(phase) + ticks - _last_ticks);
+            _last_ticks = ticks;
+        }
+
+        void restart()
+        {
+            _last_ticks = 0;
+        }
+
+    private:
+        frame_stats& _stats;
+        int _last_ticks;
+    };
+
     void enable()
     {
         hblank_effects_manager::enable();
@@ -183,39 +218,74 @@ namespace
     {
         ticks result;
 
+        int frame_stats_index = (data.last_frame_stats_index + 1) % BN_CFG_CORE_MAX_FRAME_STATS;
+        frame_stats& stats = data.frame_stats_array[frame_stats_index];
+        stats = frame_stats();
+
+        frame_stats_builder stats_builder(stats);
+
         BN_PROFILER_ENGINE_GENERAL_START("eng_update");
 
         BN_PROFILER_ENGINE_DETAILED_START("eng_cameras_update");
         cameras_manager::update();
         BN_PROFILER_ENGINE_DETAILED_STOP();
+        stats_builder.add(frame_stats_phase::CAMERAS_UPDATE);
+
+        #if BN_CFG_SPRITE_TILES_DEFRAG_MAX_TILES
+            BN_PROFILER_ENGINE_DETAILED_START("eng_spr_tiles_defrag");
+
+            sprite_tiles_manager::relocation_data sprite_tiles_relocation = sprite_tiles_manager::defragment();
+
+            if(int tiles_count = sprite_tiles_relocation.tiles_count)
+            {
+                sprites_manager::relocate_tiles(sprite_tiles_relocation.source_tile,
+                                                sprite_tiles_relocation.destination_tile, tiles_count);
+            }
+
+            BN_PROFILER_ENGINE_DETAILED_STOP();
+            stats_builder.add(frame_stats_phase::SPRITE_TILES_UPDATE);
+        #endif
 
         BN_PROFILER_ENGINE_DETAILED_START("eng_sprites_update");
         sprites_manager::update();
         BN_PROFILER_ENGINE_DETAILED_STOP();
+        stats_builder.add(frame_stats_phase::SPRITES_UPDATE);
 
         BN_PROFILER_ENGINE_DETAILED_START("eng_spr_tiles_update");
         sprite_tiles_manager::update();
         BN_PROFILER_ENGINE_DETAILED_STOP();
+        stats_builder.add(frame_stats_phase::SPRITE_TILES_UPDATE);
 
         BN_PROFILER_ENGINE_DETAILED_START("eng_bgs_update");
         bgs_manager::update();
         BN_PROFILER_ENGINE_DETAILED_STOP();
+        stats_builder.add(frame_stats_phase::BGS_UPDATE);
+
+        #if BN_CFG_BG_BLOCKS_DEFRAG_MAX_BLOCKS
+            BN_PROFILER_ENGINE_DETAILED_START("eng_bg_blocks_defrag");
+            bg_blocks_manager::defragment();
+            BN_PROFILER_ENGINE_DETAILED_STOP();
+        #endif
 
         BN_PROFILER_ENGINE_DETAILED_START("eng_bg_blocks_update");
         bg_blocks_manager::update();
         BN_PROFILER_ENGINE_DETAILED_STOP();
+        stats_builder.add(frame_stats_phase::BG_BLOCKS_UPDATE);
 
         BN_PROFILER_ENGINE_DETAILED_START("eng_palettes_update");
         palettes_manager::update();
         BN_PROFILER_ENGINE_DETAILED_STOP();
+        stats_builder.add(frame_stats_phase::PALETTES_UPDATE);
 
         BN_PROFILER_ENGINE_DETAILED_START("eng_display_update");
         display_manager::update();
         BN_PROFILER_ENGINE_DETAILED_STOP();
+        stats_builder.add(frame_stats_phase::DISPLAY_UPDATE);
 
         BN_PROFILER_ENGINE_DETAILED_START("eng_hblank_fx_update");
         hblank_effects_manager::update();
         BN_PROFILER_ENGINE_DETAILED_STOP();
+        stats_builder.add(frame_stats_phase::HBLANK_EFFECTS_UPDATE);
 
         bool use_dma = data.dma_enabled && ! link_manager::active();
 
@@ -231,6 +301,7 @@ namespace
 
         BN_BARRIER;
         data.cpu_usage_timer.restart();
+        stats_builder.restart();
 
         BN_PROFILER_ENGINE_GENERAL_START("eng_commit");
 
@@ -245,50 +316,61 @@ namespace
         BN_PROFILER_ENGINE_DETAILED_START("eng_display_commit");
         display_manager::commit();
         BN_PROFILER_ENGINE_DETAILED_STOP();
+        stats_builder.add(frame_stats_phase::DISPLAY_COMMIT);
 
         BN_PROFILER_ENGINE_DETAILED_START("eng_sprites_commit");
         sprites_manager::commit(use_dma);
         BN_PROFILER_ENGINE_DETAILED_STOP();
+        stats_builder.add(frame_stats_phase::SPRITES_COMMIT);
 
         BN_PROFILER_ENGINE_DETAILED_START("eng_bgs_commit");
         bgs_manager::commit(use_dma);
         BN_PROFILER_ENGINE_DETAILED_STOP();
+        stats_builder.add(frame_stats_phase::BGS_COMMIT);
 
         BN_PROFILER_ENGINE_DETAILED_START("eng_palettes_commit");
         palettes_manager::commit(use_dma);
         BN_PROFILER_ENGINE_DETAILED_STOP();
+        stats_builder.add(frame_stats_phase::PALETTES_COMMIT);
 
         BN_PROFILER_ENGINE_DETAILED_START("eng_spr_tiles_unc_commit");
         sprite_tiles_manager::commit_uncompressed(use_dma);
         BN_PROFILER_ENGINE_DETAILED_STOP();
+        stats_builder.add(frame_stats_phase::SPRITE_TILES_UNCOMPRESSED_COMMIT);
 
         BN_PROFILER_ENGINE_DETAILED_START("eng_hdma_update");
         hdma_manager::update();
         BN_PROFILER_ENGINE_DETAILED_STOP();
 
         bool hdma_running = hdma_manager::commit(use_dma);
+        stats_builder.add(frame_stats_phase::HDMA_COMMIT);
 
         BN_PROFILER_ENGINE_DETAILED_START("eng_hblank_fx_commit");
         bool hblank_effects_running = hblank_effects_manager::commit();
         BN_PROFILER_ENGINE_DETAILED_STOP();
+        stats_builder.add(frame_stats_phase::HBLANK_EFFECTS_COMMIT);
 
         BN_PROFILER_ENGINE_DETAILED_START("eng_big_maps_commit");
         bgs_manager::commit_big_maps();
         BN_PROFILER_ENGINE_DETAILED_STOP();
+        stats_builder.add(frame_stats_phase::BIG_MAPS_COMMIT);
 
         use_dma = use_dma && ! hdma_running && ! hblank_effects_running;
 
         BN_PROFILER_ENGINE_DETAILED_START("eng_bg_blocks_unc_commit");
         bg_blocks_manager::commit_uncompressed(use_dma);
         BN_PROFILER_ENGINE_DETAILED_STOP();
+        stats_builder.add(frame_stats_phase::BG_BLOCKS_UNCOMPRESSED_COMMIT);
 
         BN_PROFILER_ENGINE_DETAILED_START("eng_spr_tiles_cmp_commit");
         sprite_tiles_manager::commit_compressed();
         BN_PROFILER_ENGINE_DETAILED_STOP();
+        stats_builder.add(frame_stats_phase::SPRITE_TILES_COMPRESSED_COMMIT);
 
         BN_PROFILER_ENGINE_DETAILED_START("eng_bg_blocks_cmp_commit");
         bg_blocks_manager::commit_compressed();
         BN_PROFILER_ENGINE_DETAILED_STOP();
+        stats_builder.add(frame_stats_phase::BG_BLOCKS_COMPRESSED_COMMIT);
 
         BN_PROFILER_ENGINE_DETAILED_START("eng_vblank_callback");
         if(vblank_callback_type vblank_callback = data.vblank_callback)
@@ -296,8 +378,14 @@ namespace
             vblank_callback();
         }
         BN_PROFILER_ENGINE_DETAILED_STOP();
+        stats_builder.add(frame_stats_phase::VBLANK_CALLBACK);
 
         result.vblank_usage_ticks = data.cpu_usage_timer.elapsed_ticks();
+        stats.set_cpu_ticks(result.cpu_usage_ticks);
+        stats.set_vblank_ticks(result.vblank_usage_ticks);
+        stats.set_missed_frames(result.missed_frames);
+        data.last_frame_stats_index = frame_stats_index;
+        data.last_frame_stats_count = min(data.last_frame_stats_count + 1, BN_CFG_CORE_MAX_FRAME_STATS);
 
         //BN_PROFILER_ENGINE_DETAILED_START("eng_audio_commit");
         //audio_manager::commit();
@@ -560,6 +648,30 @@ int last_missed_frames()
     return data.last_ticks.missed_frames;
 }
 
+const frame_stats& last_frame_stats()
+{
+    return data.frame_stats_array[data.last_frame_stats_index];
+}
+
+const frame_stats& last_frame_stats(int frames_ago)
+{
+    BN_ASSERT(frames_ago >= 0 && frames_ago < data.last_frame_stats_count, "Invalid frames ago: ", frames_ago);
+
+    int index = data.last_frame_stats_index - frames_ago;
+
+    if(index < 0)
+    {
+        index += BN_CFG_CORE_MAX_FRAME_STATS;
+    }
+
+    return data.frame_stats_array[index];
+}
+
+int last_frame_stats_count()
+{
+    return data.last_frame_stats_count;
+}
+
 vblank_callback_type vblank_callback()
 {
     return data.vblank_callback;
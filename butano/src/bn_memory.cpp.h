@@ -199,6 +199,10 @@ void decompress(compression_type compression, const void* source_ptr, int bytes,
         hw::decompress::huff(source_ptr, destination_ptr);
         break;
 
+    case compression_type::FAST_LZ:
+        hw::decompress::fast_lz(source_ptr, destination_ptr);
+        break;
+
     default:
         BN_ERROR("Unknown compression type: ", int(compression));
         break;
@@ -0,0 +1,123 @@
+/*
+ * Copyright (c) 2020-2023 Gustavo Valiente gustavo.valiente@protonmail.com
+ * zlib License, see LICENSE file.
+ */
+
+#include "bn_particle_system.h"
+
+#include "bn_sprites.h"
+#include "bn_sprite_item.h"
+#include "bn_display_manager.h"
+#include "bn_sprites_manager.h"
+#include "../hw/include/bn_hw_sprites.h"
+
+namespace bn
+{
+
+iparticle_system::iparticle_system(const sprite_item& item, int max_size, void* buffer) :
+    _palette(item.palette_item().create_palette()),
+    _shape_size(item.shape_size()),
+    _max_size(max_size)
+{
+    BN_ASSERT(max_size > 0 && max_size < hw::sprites::count(), "Invalid max size: ", max_size);
+
+    const sprite_tiles_item& tiles_item = item.tiles_item();
+    int graphics_count = tiles_item.graphics_count();
+    BN_ASSERT(graphics_count <= max_graphics_count, "Too many graphics: ", graphics_count, " - ", max_graphics_count);
+
+    for(int graphics_index = 0; graphics_index < graphics_count; ++graphics_index)
+    {
+        _tiles.push_back(tiles_item.create_tiles(graphics_index));
+    }
+
+    _xs = static_cast<fixed*>(buffer);
+    _ys = _xs + max_size;
+    _x_velocities = _ys + max_size;
+    _y_velocities = _x_velocities + max_size;
+    _lifetimes = reinterpret_cast<uint16_t*>(_y_velocities + max_size);
+    _graphics_indexes = reinterpret_cast<uint8_t*>(_lifetimes + max_size);
+    _wait_counters = _graphics_indexes + max_size;
+    _first_handle_index = sprites_manager::reserve_particle_handles(max_size);
+}
+
+iparticle_system::~iparticle_system()
+{
+    sprites_manager::release_particle_handles(_first_handle_index, _max_size);
+}
+
+void iparticle_system::set_bg_priority(int bg_priority)
+{
+    BN_ASSERT(bg_priority >= 0 && bg_priority <= sprites::max_bg_priority(), "Invalid BG priority: ", bg_priority);
+
+    _bg_priority = uint8_t(bg_priority);
+}
+
+void iparticle_system::set_wait_updates(int wait_updates)
+{
+    BN_ASSERT(wait_updates >= 0 && wait_updates <= 255, "Invalid wait updates: ", wait_updates);
+
+    _wait_updates = uint16_t(wait_updates);
+}
+
+void iparticle_system::emit(const fixed_point& position, const fixed_point& velocity, int lifetime)
+{
+    BN_ASSERT(lifetime > 0 && lifetime < 65536, "Invalid lifetime: ", lifetime);
+    BN_BASIC_ASSERT(! full(), "Particle system is full");
+
+    int index = _size;
+    _xs[index] = position.x();
+    _ys[index] = position.y();
+    _x_velocities[index] = velocity.x();
+    _y_velocities[index] = velocity.y();
+    _lifetimes[index] = uint16_t(lifetime);
+    _graphics_indexes[index] = 0;
+    _wait_counters[index] = 0;
+    _size = index + 1;
+}
+
+void iparticle_system::clear()
+{
+    _size = 0;
+}
+
+void iparticle_system::update()
+{
+    const sprite_palette_ptr& palette = _palette;
+    int palette_id = palette.id();
+    int bg_priority = _bg_priority;
+    int graphics_count = _tiles.size();
+    uint16_t third_attributes[max_graphics_count];
+
+    for(int graphics_index = 0; graphics_index < graphics_count; ++graphics_index)
+    {
+        int tiles_id = _tiles[graphics_index].id();
+        third_attributes[graphics_index] = uint16_t(hw::sprites::third_attributes(tiles_id, palette_id, bg_priority));
+    }
+
+    bool fade_enabled = display_manager::blending_fade_enabled();
+    sprites_manager::particles_update_data update_data;
+    update_data.xs = _xs;
+    update_data.ys = _ys;
+    update_data.x_velocities = _x_velocities;
+    update_data.y_velocities = _y_velocities;
+    update_data.lifetimes = _lifetimes;
+    update_data.graphics_indexes = _graphics_indexes;
+    update_data.wait_counters = _wait_counters;
+    update_data.third_attributes = third_attributes;
+    update_data.size = _size;
+    update_data.graphics_count = graphics_count;
+    update_data.wait_updates = _wait_updates;
+    update_data.gravity_x_data = _gravity.x().data();
+    update_data.gravity_y_data = _gravity.y().data();
+    update_data.width = _shape_size.width();
+    update_data.height = _shape_size.height();
+    update_data.first_attributes = unsigned(hw::sprites::first_attributes(
+            0, _shape_size.shape(), palette.bpp(), 0, false, false, false, fade_enabled));
+    update_data.second_attributes = unsigned(hw::sprites::second_attributes(0, _shape_size.size(), false, false));
+
+    int size = sprites_manager::update_particle_handles(_first_handle_index, _written_size, update_data);
+    _size = size;
+    _written_size = size;
+}
+
+}
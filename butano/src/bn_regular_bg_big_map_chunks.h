@@ -0,0 +1,64 @@
+/*
+ * Copyright (c) 2020-2023 Gustavo Valiente gustavo.valiente@protonmail.com
+ * zlib License, see LICENSE file.
+ */
+
+#ifndef BN_REGULAR_BG_BIG_MAP_CHUNKS_H
+#define BN_REGULAR_BG_BIG_MAP_CHUNKS_H
+
+#include "bn_assert.h"
+#include "../hw/include/bn_hw_memory.h"
+#include "../hw/include/bn_hw_decompress.h"
+
+// Compressed big regular maps are split in 8x8 cells chunks which can be decompressed independently.
+//
+// Layout: a table with the byte offset of each chunk (row-major order), followed by the chunks data.
+// Each chunk starts with a GBA BIOS compression header (uncompressed chunks use type 0).
+
+namespace bn::regular_bg_big_map_chunks
+{
+    constexpr int size = 8;
+    constexpr int cells = size * size;
+
+    [[nodiscard]] inline int columns(int map_width)
+    {
+        return map_width / size;
+    }
+
+    [[nodiscard]] inline int index(int map_x, int map_y, int map_width)
+    {
+        return ((map_y / size) * columns(map_width)) + (map_x / size);
+    }
+
+    inline void decompress(const uint16_t* map_data, int chunk_index, uint16_t* cells_ptr)
+    {
+        auto offsets = reinterpret_cast<const unsigned*>(map_data);
+        const unsigned* chunk_data = offsets + (offsets[chunk_index] / 4);
+
+        switch(*chunk_data & 0xF0)
+        {
+
+        case 0x00:
+            hw::memory::copy_words(chunk_data + 1, cells / 2, cells_ptr);
+            break;
+
+        case 0x10:
+            hw::decompress::lz77(chunk_data, cells_ptr);
+            break;
+
+        case 0x30:
+            hw::decompress::rl_wram(chunk_data, cells_ptr);
+            break;
+
+        case 0x40:
+            hw::decompress::fast_lz(chunk_data, cells_ptr);
+            break;
+
+        default:
+            BN_ERROR("Invalid big map chunk compression: ", *chunk_data & 0xF0);
+            break;
+        }
+    }
+}
+
+#endif
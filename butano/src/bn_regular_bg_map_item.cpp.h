@@ -8,6 +8,7 @@
 #include "bn_bg_palette_ptr.h"
 #include "bn_regular_bg_map_ptr.h"
 #include "bn_regular_bg_tiles_ptr.h"
+#include "bn_regular_bg_big_map_chunks.h"
 #include "../hw/include/bn_hw_decompress.h"
 
 namespace bn
@@ -24,6 +25,34 @@ regular_bg_map_item regular_bg_map_item::decompress(span<regular_bg_map_cell> de
 
     regular_bg_map_item result = *this;
 
+    if(_big && _compression != compression_type::NONE)
+    {
+        constexpr int chunk_size = regular_bg_big_map_chunks::size;
+
+        int map_width = _dimensions.width();
+        int chunks_columns = regular_bg_big_map_chunks::columns(map_width);
+        int chunks_count = chunks_columns * (_dimensions.height() / chunk_size);
+        alignas(int) regular_bg_map_cell chunk_cells[regular_bg_big_map_chunks::cells];
+
+        for(int chunk_index = 0; chunk_index < chunks_count; ++chunk_index)
+        {
+            int chunk_x = (chunk_index % chunks_columns) * chunk_size;
+            int chunk_y = (chunk_index / chunks_columns) * chunk_size;
+            regular_bg_map_cell* destination_cells_ptr = decompressed_cells_ptr + (chunk_y * map_width) + chunk_x;
+            regular_bg_big_map_chunks::decompress(_cells_ptr, chunk_index, chunk_cells);
+
+            for(int chunk_row = 0; chunk_row < chunk_size; ++chunk_row)
+            {
+                hw::memory::copy_words(chunk_cells + (chunk_row * chunk_size), chunk_size / 2, destination_cells_ptr);
+                destination_cells_ptr += map_width;
+            }
+        }
+
+        result._cells_ptr = decompressed_cells_ptr;
+        result._compression = compression_type::NONE;
+        return result;
+    }
+
     switch(_compression)
     {
 
@@ -48,6 +77,12 @@ regular_bg_map_item regular_bg_map_item::decompress(span<regular_bg_map_cell> de
         result._compression = compression_type::NONE;
         break;
 
+    case compression_type::FAST_LZ:
+        hw::decompress::fast_lz(_cells_ptr, decompressed_cells_ptr);
+        result._cells_ptr = decompressed_cells_ptr;
+        result._compression = compression_type::NONE;
+        break;
+
     default:
         BN_ERROR("Unknown compression type: ", int(_compression));
         break;
@@ -392,6 +392,11 @@ compression_type regular_bg_map_ptr::compression() const
     return bg_blocks_manager::compression(_handle);
 }
 
+bool regular_bg_map_ptr::ready() const
+{
+    return ! bg_blocks_manager::must_commit(_handle);
+}
+
 optional<span<const regular_bg_map_cell>> regular_bg_map_ptr::cells_ref() const
 {
     return bg_blocks_manager::regular_map_cells_ref(_handle);
@@ -412,6 +417,11 @@ void regular_bg_map_ptr::reload_cells_ref()
     bg_blocks_manager::reload(_handle);
 }
 
+void regular_bg_map_ptr::reload_cells_ref(int x, int y, int width, int height)
+{
+    bg_blocks_manager::reload_regular_map_cells(_handle, x, y, width, height);
+}
+
 const regular_bg_tiles_ptr& regular_bg_map_ptr::tiles() const
 {
     return bg_blocks_manager::regular_map_tiles(_handle);
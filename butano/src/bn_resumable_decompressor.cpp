@@ -0,0 +1,304 @@
+/*
+ * Copyright (c) 2020-2023 Gustavo Valiente gustavo.valiente@protonmail.com
+ * zlib License, see LICENSE file.
+ */
+
+#include "bn_resumable_decompressor.h"
+
+#include "bn_math.h"
+#include "bn_assert.h"
+
+namespace bn
+{
+
+void resumable_decompressor::start(const void* source_ptr, compression_type compression)
+{
+    BN_BASIC_ASSERT(source_ptr, "Source is null");
+    BN_BASIC_ASSERT(compression != compression_type::NONE, "Uncompressed data not supported");
+
+    auto header_ptr = static_cast<const uint8_t*>(source_ptr);
+    _source_ptr = source_ptr;
+    _input_ptr = header_ptr + 4;
+    _huffman_node_ptr = nullptr;
+    _total_bytes = int(header_ptr[1] | (header_ptr[2] << 8) | (header_ptr[3] << 16));
+    _output_bytes = 0;
+    _bits = 0;
+    _bits_count = 0;
+    _copy_count = 0;
+    _copy_distance = 0;
+    _compression = compression;
+    _pending_byte = 0;
+    _huffman_data_bits = 0;
+    _huffman_nibble_pending = false;
+
+    if(compression == compression_type::HUFFMAN)
+    {
+        // Tree root node is placed after the tree size, and the bitstream after the tree:
+        _huffman_data_bits = header_ptr[0] & 0x0F;
+        _huffman_node_ptr = _input_ptr + 1;
+        _input_ptr += (_input_ptr[0] + 1) * 2;
+
+        BN_BASIC_ASSERT(_huffman_data_bits == 4 || _huffman_data_bits == 8,
+                        "Invalid Huffman data bits: ", _huffman_data_bits);
+    }
+}
+
+int resumable_decompressor::decompress(void* destination_ptr, int max_bytes)
+{
+    BN_BASIC_ASSERT(_source_ptr, "Decompression not started");
+    BN_ASSERT(max_bytes > 0, "Invalid max bytes: ", max_bytes);
+
+    auto output_ptr = static_cast<uint8_t*>(destination_ptr);
+    int output_bytes = _output_bytes;
+    int output_limit = output_bytes + min(max_bytes, _total_bytes - output_bytes);
+
+    switch(_compression)
+    {
+
+    case compression_type::LZ77:
+        _decompress_lz77(output_ptr, output_limit);
+        break;
+
+    case compression_type::RUN_LENGTH:
+        _decompress_run_length(output_ptr, output_limit);
+        break;
+
+    case compression_type::HUFFMAN:
+        _decompress_huffman(output_ptr, output_limit);
+        break;
+
+    case compression_type::FAST_LZ:
+        _decompress_fast_lz(output_ptr, output_limit);
+        break;
+
+    default:
+        BN_ERROR("Unknown compression type: ", int(_compression));
+        break;
+    }
+
+    // The last byte of odd sized data is written with the next byte of the destination:
+    if(finished() && (_total_bytes & 1))
+    {
+        auto last_half_word_ptr = reinterpret_cast<uint16_t*>(output_ptr + _total_bytes - 1);
+        *last_half_word_ptr = uint16_t((*last_half_word_ptr & 0xFF00) | _pending_byte);
+    }
+
+    return _output_bytes - output_bytes;
+}
+
+void resumable_decompressor::_write_byte(uint8_t* output_ptr, unsigned value)
+{
+    int output_bytes = _output_bytes;
+
+    if(output_bytes & 1)
+    {
+        auto half_word_ptr = reinterpret_cast<uint16_t*>(output_ptr + output_bytes - 1);
+        *half_word_ptr = uint16_t(_pending_byte | (value << 8));
+    }
+    else
+    {
+        _pending_byte = uint8_t(value);
+    }
+
+    _output_bytes = output_bytes + 1;
+}
+
+unsigned resumable_decompressor::_read_byte(const uint8_t* output_ptr, int position) const
+{
+    // The pending byte has not been written yet:
+    if(position == _output_bytes - 1 && (_output_bytes & 1))
+    {
+        return _pending_byte;
+    }
+
+    return output_ptr[position];
+}
+
+void resumable_decompressor::_decompress_lz77(uint8_t* output_ptr, int output_limit)
+{
+    while(_output_bytes < output_limit)
+    {
+        if(_copy_count)
+        {
+            _write_byte(output_ptr, _read_byte(output_ptr, _output_bytes - _copy_distance));
+            --_copy_count;
+            continue;
+        }
+
+        if(! _bits_count)
+        {
+            _bits = *_input_ptr;
+            ++_input_ptr;
+            _bits_count = 8;
+        }
+
+        --_bits_count;
+
+        if((_bits >> _bits_count) & 1)
+        {
+            unsigned first_byte = _input_ptr[0];
+            unsigned second_byte = _input_ptr[1];
+            _input_ptr += 2;
+            _copy_count = int(first_byte >> 4) + 3;
+            _copy_distance = int(((first_byte & 0x0F) << 8) | second_byte) + 1;
+        }
+        else
+        {
+            _write_byte(output_ptr, *_input_ptr);
+            ++_input_ptr;
+        }
+    }
+}
+
+void resumable_decompressor::_decompress_run_length(uint8_t* output_ptr, int output_limit)
+{
+    while(_output_bytes < output_limit)
+    {
+        if(_copy_count)
+        {
+            if(_run_compressed)
+            {
+                _write_byte(output_ptr, _run_value);
+            }
+            else
+            {
+                _write_byte(output_ptr, *_input_ptr);
+                ++_input_ptr;
+            }
+
+            --_copy_count;
+            continue;
+        }
+
+        unsigned flag = *_input_ptr;
+        ++_input_ptr;
+
+        if(flag & 0x80)
+        {
+            _run_compressed = true;
+            _run_value = *_input_ptr;
+            ++_input_ptr;
+            _copy_count = int(flag & 0x7F) + 3;
+        }
+        else
+        {
+            _run_compressed = false;
+            _copy_count = int(flag & 0x7F) + 1;
+        }
+    }
+}
+
+void resumable_decompressor::_decompress_huffman(uint8_t* output_ptr, int output_limit)
+{
+    auto source_ptr = static_cast<const uint8_t*>(_source_ptr);
+    const uint8_t* root_node_ptr = source_ptr + 5;
+    const uint8_t* node_ptr = _huffman_node_ptr;
+
+    while(_output_bytes < output_limit)
+    {
+        if(! _bits_count)
+        {
+            _bits = unsigned(_input_ptr[0] | (_input_ptr[1] << 8) | (_input_ptr[2] << 16) | (_input_ptr[3] << 24));
+            _input_ptr += 4;
+            _bits_count = 32;
+        }
+
+        --_bits_count;
+
+        unsigned bit = (_bits >> _bits_count) & 1;
+        unsigned node = *node_ptr;
+        auto node_address = reinterpret_cast<uintptr_t>(node_ptr);
+        auto child_ptr = reinterpret_cast<const uint8_t*>((node_address & ~uintptr_t(1)) + ((node & 0x3F) * 2) + 2);
+        child_ptr += bit;
+
+        if(node & (bit ? 0x40 : 0x80))
+        {
+            unsigned value = *child_ptr;
+            node_ptr = root_node_ptr;
+
+            if(_huffman_data_bits == 8)
+            {
+                _write_byte(output_ptr, value);
+            }
+            else if(_huffman_nibble_pending)
+            {
+                _huffman_nibble_pending = false;
+                _write_byte(output_ptr, _huffman_nibble | (value << 4));
+            }
+            else
+            {
+                _huffman_nibble = uint8_t(value);
+                _huffman_nibble_pending = true;
+            }
+        }
+        else
+        {
+            node_ptr = child_ptr;
+        }
+    }
+
+    _huffman_node_ptr = node_ptr;
+}
+
+void resumable_decompressor::_decompress_fast_lz(uint8_t* output_ptr, int output_limit)
+{
+    // Fast LZ data is made of half words, so the pending byte is never used:
+    while(_output_bytes < output_limit)
+    {
+        auto half_word_ptr = reinterpret_cast<uint16_t*>(output_ptr + _output_bytes);
+
+        if(_copy_count)
+        {
+            if(_run_compressed)
+            {
+                *half_word_ptr = *(half_word_ptr - _copy_distance);
+            }
+            else
+            {
+                *half_word_ptr = uint16_t(_input_ptr[0] | (_input_ptr[1] << 8));
+                _input_ptr += 2;
+            }
+
+            _output_bytes += 2;
+            --_copy_count;
+            continue;
+        }
+
+        unsigned value = unsigned(_input_ptr[0] | (_input_ptr[1] << 8));
+        _input_ptr += 2;
+
+        if(_bits_count)
+        {
+            // Match of the last token:
+            int match_length = int(_bits >> 8);
+
+            if(match_length == 0xFF)
+            {
+                match_length += _input_ptr[0] | (_input_ptr[1] << 8);
+                _input_ptr += 2;
+            }
+
+            _run_compressed = true;
+            _copy_count = match_length + 3;
+            _copy_distance = int(value);
+            _bits_count = 0;
+        }
+        else
+        {
+            int literals_count = int(value & 0xFF);
+
+            if(literals_count == 0xFF)
+            {
+                literals_count += _input_ptr[0] | (_input_ptr[1] << 8);
+                _input_ptr += 2;
+            }
+
+            _run_compressed = false;
+            _copy_count = literals_count;
+            _bits = value;
+            _bits_count = 1;
+        }
+    }
+}
+
+}
@@ -0,0 +1,81 @@
+/*
+ * Copyright (c) 2020-2023 Gustavo Valiente gustavo.valiente@protonmail.com
+ * zlib License, see LICENSE file.
+ */
+
+#ifndef BN_RESUMABLE_DECOMPRESSOR_H
+#define BN_RESUMABLE_DECOMPRESSOR_H
+
+#include "bn_compression_type.h"
+
+namespace bn
+{
+
+// Software decompressor of GBA BIOS and fast LZ compressed data which can be stopped after a given number
+// of output bytes and resumed later.
+//
+// Output is written with 16-bit stores only, so it can decompress to VRAM.
+// The destination pointer can change between calls, as long as the previously written data is moved with it.
+class resumable_decompressor
+{
+
+public:
+    void start(const void* source_ptr, compression_type compression);
+
+    void stop()
+    {
+        _source_ptr = nullptr;
+    }
+
+    [[nodiscard]] const void* source_ptr() const
+    {
+        return _source_ptr;
+    }
+
+    [[nodiscard]] bool finished() const
+    {
+        return _output_bytes == _total_bytes;
+    }
+
+    [[nodiscard]] int remaining_bytes() const
+    {
+        return _total_bytes - _output_bytes;
+    }
+
+    // Returns the number of output bytes written:
+    int decompress(void* destination_ptr, int max_bytes);
+
+private:
+    const void* _source_ptr = nullptr;
+    const uint8_t* _input_ptr = nullptr;
+    const uint8_t* _huffman_node_ptr = nullptr;
+    int _total_bytes = 0;
+    int _output_bytes = 0;
+    unsigned _bits = 0;
+    int _bits_count = 0;
+    int _copy_count = 0;
+    int _copy_distance = 0;
+    compression_type _compression = compression_type::NONE;
+    uint8_t _pending_byte = 0;
+    uint8_t _run_value = 0;
+    uint8_t _huffman_data_bits = 0;
+    uint8_t _huffman_nibble = 0;
+    bool _run_compressed = false;
+    bool _huffman_nibble_pending = false;
+
+    void _write_byte(uint8_t* output_ptr, unsigned value);
+
+    [[nodiscard]] unsigned _read_byte(const uint8_t* output_ptr, int position) const;
+
+    void _decompress_lz77(uint8_t* output_ptr, int output_limit);
+
+    void _decompress_run_length(uint8_t* output_ptr, int output_limit);
+
+    void _decompress_huffman(uint8_t* output_ptr, int output_limit);
+
+    void _decompress_fast_lz(uint8_t* output_ptr, int output_limit);
+};
+
+}
+
+#endif
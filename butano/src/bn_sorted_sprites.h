@@ -7,11 +7,22 @@
 #define BN_SORTED_SPRITES_H
 
 #include "bn_pool.h"
+#include "bn_memory.h"
 #include "bn_config_sprites.h"
 #include "bn_sprites_manager_item.h"
 
+static_assert(BN_CFG_SPRITES_SORTER == BN_SPRITES_SORTER_LAYERS ||
+              BN_CFG_SPRITES_SORTER == BN_SPRITES_SORTER_RADIX, "Invalid sprites sorter");
+
 namespace bn::sorted_sprites
 {
+    [[nodiscard]] inline bool y_sort_before(const sprites_manager_item& item, const sprites_manager_item& other)
+    {
+        return item.y_sort_enabled && other.y_sort_enabled && item.sprite_sort_key == other.sprite_sort_key &&
+                item.position.y() > other.position.y();
+    }
+
+#if BN_CFG_SPRITES_SORTER == BN_SPRITES_SORTER_LAYERS
     class layer : public intrusive_list_node_type
     {
 
@@ -54,36 +65,44 @@ namespace bn::sorted_sprites
             return _layer_ptrs;
         }
 
+        template<typename Function>
+        void for_each(const Function& function)
+        {
+            for(layer& layer : _layer_ptrs)
+            {
+                for(sprites_manager_item& item : layer.items())
+                {
+                    function(item);
+                }
+            }
+        }
+
         void insert(sprites_manager_item& item)
         {
-            layers_type& layer_ptrs = _layer_ptrs;
-            sort_key item_sort_key = item.sprite_sort_key;
-            layers_type::iterator layers_end = layer_ptrs.end();
-            layers_type::iterator layers_it = lower_bound(layer_ptrs.begin(), layers_end, item_sort_key,
-                    [](const layer& layer, sort_key sort_key) {
-                        return layer.layer_sort_key() < sort_key;
-                    });
+            layer& layer_ref = _find_or_create_layer(item.sprite_sort_key);
+            layer_ref.items().push_front(item);
+            item.sort_layer_ptr_diff = _layer_ptr_diff(layer_ref);
+        }
 
-            if(layers_it == layers_end)
+        template<typename GetItem>
+        void insert_many(int items_count, const GetItem& get_item)
+        {
+            if(items_count)
             {
-                BN_BASIC_ASSERT(! _layer_pool.full(), "No more sprite sort layers available");
+                sort_key item_sort_key = get_item(0).sprite_sort_key;
+                layer& layer_ref = _find_or_create_layer(item_sort_key);
+                intrusive_list<sprites_manager_item>& layer_items = layer_ref.items();
+                int16_t layer_ptr_diff = _layer_ptr_diff(layer_ref);
 
-                layer& pool_layer = _layer_pool.create(item_sort_key);
-                layers_it = layer_ptrs.insert(layers_end, pool_layer);
-            }
-            else if(item_sort_key != layers_it->layer_sort_key())
-            {
-                BN_BASIC_ASSERT(! _layer_pool.full(), "No more sprite sort layers available");
+                for(int index = 0; index < items_count; ++index)
+                {
+                    sprites_manager_item& item = get_item(index);
+                    BN_BASIC_ASSERT(item.sprite_sort_key == item_sort_key, "Items sort key mismatch");
 
-                layer& pool_layer = _layer_pool.create(item_sort_key);
-                layers_it = layer_ptrs.insert(layers_it, pool_layer);
+                    layer_items.push_front(item);
+                    item.sort_layer_ptr_diff = layer_ptr_diff;
+                }
             }
-
-            layer& layer_ref = *layers_it;
-            layer_ref.items().push_front(item);
-
-            int diff = &layer_ref - reinterpret_cast<layer*>(&layer_ptrs);
-            item.sort_layer_ptr_diff = int16_t(diff);
         }
 
         void erase(sprites_manager_item& item)
@@ -129,6 +148,68 @@ namespace bn::sorted_sprites
             return sort;
         }
 
+        [[nodiscard]] bool sort_by_y()
+        {
+            using items_iterator = intrusive_list<sprites_manager_item>::iterator;
+            bool sort = false;
+
+            for(layer& layer : _layer_ptrs)
+            {
+                // Insertion sort, since layer items should be almost sorted:
+
+                intrusive_list<sprites_manager_item>& layer_items = layer.items();
+                items_iterator previous_it = layer_items.begin();
+                items_iterator end = layer_items.end();
+
+                if(previous_it == end)
+                {
+                    continue;
+                }
+
+                items_iterator it = previous_it;
+                ++it;
+
+                while(it != end)
+                {
+                    sprites_manager_item& item = *it;
+                    items_iterator next_it = it;
+                    ++next_it;
+
+                    if(y_sort_before(item, *previous_it))
+                    {
+                        items_iterator begin = layer_items.begin();
+                        items_iterator insert_it = previous_it;
+
+                        while(insert_it != begin)
+                        {
+                            items_iterator candidate_it = insert_it;
+                            --candidate_it;
+
+                            if(! y_sort_before(item, *candidate_it))
+                            {
+                                break;
+                            }
+
+                            insert_it = candidate_it;
+                        }
+
+                        sprites_manager_item& insert_item = *insert_it;
+                        layer_items.erase(item);
+                        layer_items.insert(insert_item, item);
+                        sort = true;
+                    }
+                    else
+                    {
+                        previous_it = it;
+                    }
+
+                    it = next_it;
+                }
+            }
+
+            return sort;
+        }
+
     private:
         pool<layer, BN_CFG_SPRITES_MAX_SORT_LAYERS> _layer_pool;
         layers_type _layer_ptrs;
@@ -137,7 +218,298 @@ namespace bn::sorted_sprites
         {
             return reinterpret_cast<layer*>(&_layer_ptrs) + diff;
         }
+
+        [[nodiscard]] int16_t _layer_ptr_diff(layer& layer_ref)
+        {
+            int diff = &layer_ref - reinterpret_cast<layer*>(&_layer_ptrs);
+            return int16_t(diff);
+        }
+
+        [[nodiscard]] layer& _find_or_create_layer(sort_key item_sort_key)
+        {
+            layers_type& layer_ptrs = _layer_ptrs;
+            layers_type::iterator layers_end = layer_ptrs.end();
+            layers_type::iterator layers_it = lower_bound(layer_ptrs.begin(), layers_end, item_sort_key,
+                    [](const layer& layer, sort_key sort_key) {
+                        return layer.layer_sort_key() < sort_key;
+                    });
+
+            if(layers_it == layers_end)
+            {
+                BN_BASIC_ASSERT(! _layer_pool.full(), "No more sprite sort layers available");
+
+                layer& pool_layer = _layer_pool.create(item_sort_key);
+                layers_it = layer_ptrs.insert(layers_end, pool_layer);
+            }
+            else if(item_sort_key != layers_it->layer_sort_key())
+            {
+                BN_BASIC_ASSERT(! _layer_pool.full(), "No more sprite sort layers available");
+
+                layer& pool_layer = _layer_pool.create(item_sort_key);
+                layers_it = layer_ptrs.insert(layers_it, pool_layer);
+            }
+
+            return *layers_it;
+        }
+    };
+
+#else
+
+    class sorter
+    {
+
+    public:
+        void insert(sprites_manager_item& item)
+        {
+            _push_front(item);
+        }
+
+        template<typename GetItem>
+        void insert_many(int items_count, const GetItem& get_item)
+        {
+            for(int index = 0; index < items_count; ++index)
+            {
+                _push_front(get_item(index));
+            }
+        }
+
+        void erase(sprites_manager_item& item)
+        {
+            int index = item.sort_index;
+
+            if(index < max_items)
+            {
+                _items[index] = nullptr;
+            }
+            else
+            {
+                _pending_items[index - max_items] = nullptr;
+            }
+
+            _sort_required = true;
+        }
+
+        [[nodiscard]] bool put_in_front_of_layer(sprites_manager_item& item)
+        {
+            if(! _sort_required)
+            {
+                int index = item.sort_index;
+
+                if(index == 0 || _items[index - 1]->sprite_sort_key != item.sprite_sort_key)
+                {
+                    return false;
+                }
+            }
+
+            erase(item);
+            _push_front(item);
+            return true;
+        }
+
+        [[nodiscard]] bool put_in_back_of_layer(sprites_manager_item& item)
+        {
+            if(! _sort_required)
+            {
+                int index = item.sort_index;
+
+                if(index == _items_count - 1 || _items[index + 1]->sprite_sort_key != item.sprite_sort_key)
+                {
+                    return false;
+                }
+            }
+
+            erase(item);
+            _push_back(item);
+            return true;
+        }
+
+        [[nodiscard]] bool sort_by_y()
+        {
+            if(_sort_required)
+            {
+                _sort();
+            }
+
+            // Insertion sort, since items should be almost sorted:
+
+            sprites_manager_item** items = _items;
+            bool sort = false;
+
+            for(int index = 1, limit = _items_count; index < limit; ++index)
+            {
+                sprites_manager_item* item = items[index];
+
+                if(y_sort_before(*item, *items[index - 1]))
+                {
+                    int insert_index = index - 1;
+
+                    while(insert_index > 0 && y_sort_before(*item, *items[insert_index - 1]))
+                    {
+                        --insert_index;
+                    }
+
+                    for(int move_index = index; move_index > insert_index; --move_index)
+                    {
+                        sprites_manager_item* moved_item = items[move_index - 1];
+                        items[move_index] = moved_item;
+                        moved_item->sort_index = int16_t(move_index);
+                    }
+
+                    items[insert_index] = item;
+                    item->sort_index = int16_t(insert_index);
+                    sort = true;
+                }
+            }
+
+            return sort;
+        }
+
+        template<typename Function>
+        void for_each(const Function& function)
+        {
+            if(_sort_required)
+            {
+                _sort();
+            }
+
+            sprites_manager_item** items = _items;
+
+            for(int index = 0, limit = _items_count; index < limit; ++index)
+            {
+                function(*items[index]);
+            }
+        }
+
+    private:
+        static constexpr int max_items = BN_CFG_SPRITES_MAX_ITEMS;
+
+        sprites_manager_item* _items[max_items];
+        sprites_manager_item* _pending_items[max_items];
+        sprites_manager_item* _sort_buffer[max_items];
+        int _items_count = 0;
+        int _front_pending_items_count = 0;
+        int _back_pending_items_count = 0;
+        bool _sort_required = false;
+
+        void _push_front(sprites_manager_item& item)
+        {
+            if(_front_pending_items_count + _back_pending_items_count == max_items) [[unlikely]]
+            {
+                _sort();
+            }
+
+            int pending_index = _front_pending_items_count;
+            _front_pending_items_count = pending_index + 1;
+            _pending_items[pending_index] = &item;
+            item.sort_index = int16_t(max_items + pending_index);
+            _sort_required = true;
+        }
+
+        void _push_back(sprites_manager_item& item)
+        {
+            if(_front_pending_items_count + _back_pending_items_count == max_items) [[unlikely]]
+            {
+                _sort();
+            }
+
+            int pending_index = max_items - 1 - _back_pending_items_count;
+            ++_back_pending_items_count;
+            _pending_items[pending_index] = &item;
+            item.sort_index = int16_t(max_items + pending_index);
+            _sort_required = true;
+        }
+
+        void _sort()
+        {
+            // Front pending items are placed before the sorted ones and back pending items after them,
+            // so a stable sort keeps the same order as the layers sorter:
+
+            sprites_manager_item** input = _sort_buffer;
+            sprites_manager_item** output = _items;
+            int count = 0;
+
+            for(int index = _front_pending_items_count - 1; index >= 0; --index)
+            {
+                if(sprites_manager_item* item = _pending_items[index])
+                {
+                    input[count] = item;
+                    ++count;
+                }
+            }
+
+            for(int index = 0, limit = _items_count; index < limit; ++index)
+            {
+                if(sprites_manager_item* item = output[index])
+                {
+                    input[count] = item;
+                    ++count;
+                }
+            }
+
+            for(int index = max_items - 1, limit = max_items - _back_pending_items_count; index >= limit; --index)
+            {
+                if(sprites_manager_item* item = _pending_items[index])
+                {
+                    input[count] = item;
+                    ++count;
+                }
+            }
+
+            // LSD radix sort, skipping the digits shared by all items:
+
+            for(int shift = 0; shift < 32; shift += 8)
+            {
+                int offsets[256] = {};
+
+                for(int index = 0; index < count; ++index)
+                {
+                    ++offsets[(input[index]->sprite_sort_key.data() >> shift) & 0xFF];
+                }
+
+                if(count && offsets[(input[0]->sprite_sort_key.data() >> shift) & 0xFF] == count)
+                {
+                    continue;
+                }
+
+                int offset = 0;
+
+                for(int& digit_offset : offsets)
+                {
+                    int digit_count = digit_offset;
+                    digit_offset = offset;
+                    offset += digit_count;
+                }
+
+                for(int index = 0; index < count; ++index)
+                {
+                    sprites_manager_item* item = input[index];
+                    int& digit_offset = offsets[(item->sprite_sort_key.data() >> shift) & 0xFF];
+                    output[digit_offset] = item;
+                    ++digit_offset;
+                }
+
+                swap(input, output);
+            }
+
+            if(input != _items)
+            {
+                memory::copy(*input, count, *_items);
+            }
+
+            for(int index = 0; index < count; ++index)
+            {
+                _items[index]->sort_index = int16_t(index);
+            }
+
+            _items_count = count;
+            _front_pending_items_count = 0;
+            _back_pending_items_count = 0;
+            _sort_required = false;
+        }
     };
+
+#endif
+
 }
 
 #endif
@@ -5,8 +5,13 @@
 
 #include "bn_sound.h"
 
+#include "bn_math.h"
 #include "bn_assert.h"
+#include "bn_display.h"
+#include "bn_algorithm.h"
+#include "bn_camera_ptr.h"
 #include "bn_sound_item.h"
+#include "bn_fixed_point.h"
 #include "bn_audio_manager.h"
 
 namespace bn
@@ -25,6 +30,33 @@ namespace bn
 namespace bn::sound
 {
 
+namespace
+{
+    void _attenuate(const fixed_point& position, const camera_ptr& camera, fixed& volume, fixed& panning)
+    {
+        fixed_point camera_distance = position - camera.position();
+        fixed attenuation_distance = audio_manager::sound_attenuation_distance();
+        fixed abs_x = abs(camera_distance.x());
+        fixed abs_y = abs(camera_distance.y());
+
+        if(abs_x >= attenuation_distance || abs_y >= attenuation_distance)
+        {
+            volume = 0;
+            panning = 0;
+            return;
+        }
+
+        // Distances are in the range [0..4096), so their squares can't overflow an int:
+        int x = abs_x.right_shift_integer();
+        int y = abs_y.right_shift_integer();
+        fixed distance = sqrt(x * x + y * y);
+        volume *= max(1 - distance.safe_division(attenuation_distance), fixed(0));
+
+        constexpr int half_display_width = display::width() / 2;
+        panning = clamp(camera_distance.x() / half_display_width, fixed(-1), fixed(1));
+    }
+}
+
 sound_handle play(sound_item item)
 {
     uint16_t handle_id = audio_manager::play_sound(0, item);
@@ -49,6 +81,17 @@ sound_handle play(sound_item item, fixed volume, fixed speed, fixed panning)
     return sound_handle_generator().generate(handle_id);
 }
 
+sound_handle play(sound_item item, fixed volume, const fixed_point& position, const camera_ptr& camera)
+{
+    BN_BASIC_ASSERT(volume >= 0 && volume <= 1, "Volume range is [0..1]: ", volume);
+
+    fixed panning;
+    _attenuate(position, camera, volume, panning);
+
+    uint16_t handle_id = audio_manager::play_sound(0, item, volume, 1, panning);
+    return sound_handle_generator().generate(handle_id);
+}
+
 sound_handle play_with_priority(int priority, sound_item item)
 {
     BN_BASIC_ASSERT(priority >= -32767 && priority <= 32767, "Priority range is [-32767..32767]: ", priority);
@@ -77,6 +120,48 @@ sound_handle play_with_priority(int priority, sound_item item, fixed volume, fix
     return sound_handle_generator().generate(handle_id);
 }
 
+sound_handle play_with_priority(int priority, sound_item item, fixed volume, const fixed_point& position,
+                                const camera_ptr& camera)
+{
+    BN_BASIC_ASSERT(priority >= -32767 && priority <= 32767, "Priority range is [-32767..32767]: ", priority);
+    BN_BASIC_ASSERT(volume >= 0 && volume <= 1, "Volume range is [0..1]: ", volume);
+
+    fixed panning;
+    _attenuate(position, camera, volume, panning);
+
+    uint16_t handle_id = audio_manager::play_sound(priority, item, volume, 1, panning);
+    return sound_handle_generator().generate(handle_id);
+}
+
+int active_count()
+{
+    return audio_manager::active_sounds_count();
+}
+
+int deduplication_frames()
+{
+    return audio_manager::sound_deduplication_frames();
+}
+
+void set_deduplication_frames(int frames)
+{
+    BN_BASIC_ASSERT(frames >= 0 && frames <= 65535, "Frames range is [0..65535]: ", frames);
+
+    audio_manager::set_sound_deduplication_frames(frames);
+}
+
+fixed attenuation_distance()
+{
+    return audio_manager::sound_attenuation_distance();
+}
+
+void set_attenuation_distance(fixed distance)
+{
+    BN_BASIC_ASSERT(distance >= 1 && distance <= 4096, "Distance range is [1..4096]: ", distance);
+
+    audio_manager::set_sound_attenuation_distance(distance);
+}
+
 void stop_all()
 {
     audio_manager::stop_all_sounds();
@@ -25,6 +25,11 @@ sound_handle sound_item::play(fixed volume, fixed speed, fixed panning) const
     return sound::play(*this, volume, speed, panning);
 }
 
+sound_handle sound_item::play(fixed volume, const fixed_point& position, const camera_ptr& camera) const
+{
+    return sound::play(*this, volume, position, camera);
+}
+
 sound_handle sound_item::play_with_priority(int priority) const
 {
     return sound::play_with_priority(priority, *this);
@@ -40,4 +45,10 @@ sound_handle sound_item::play_with_priority(int priority, fixed volume, fixed sp
     return sound::play_with_priority(priority, *this, volume, speed, panning);
 }
 
+sound_handle sound_item::play_with_priority(int priority, fixed volume, const fixed_point& position,
+                                            const camera_ptr& camera) const
+{
+    return sound::play_with_priority(priority, *this, volume, position, camera);
+}
+
 }
@@ -240,4 +240,99 @@ void isprite_cached_animate_action::_assign_tiles_list(ivector<sprite_tiles_ptr>
     *_tiles_list_ref = move(tiles_list);
 }
 
+sprite_delta_animate_action::sprite_delta_animate_action(
+        const sprite_ptr& sprite, int wait_updates, const sprite_tiles_delta_item& delta_item, bool forever) :
+    _sprite(sprite),
+    _delta_item(delta_item),
+    _tiles(delta_item.create_tiles()),
+    _forever(forever)
+{
+    _init(wait_updates);
+}
+
+sprite_delta_animate_action::sprite_delta_animate_action(
+        sprite_ptr&& sprite, int wait_updates, const sprite_tiles_delta_item& delta_item, bool forever) :
+    _sprite(move(sprite)),
+    _delta_item(delta_item),
+    _tiles(delta_item.create_tiles()),
+    _forever(forever)
+{
+    _init(wait_updates);
+}
+
+void sprite_delta_animate_action::update()
+{
+    BN_ASSERT(! done(), "Action is done");
+
+    if(_current_wait_updates)
+    {
+        --_current_wait_updates;
+    }
+    else
+    {
+        int graphics_count = _delta_item.graphics_count();
+        int current_graphics_index = _current_graphics_index;
+        int vram_graphics_index = _vram_graphics_index;
+        _current_wait_updates = _wait_updates;
+
+        if(current_graphics_index != vram_graphics_index)
+        {
+            int next_vram_graphics_index = vram_graphics_index + 1;
+
+            if(next_vram_graphics_index == graphics_count)
+            {
+                next_vram_graphics_index = 0;
+            }
+
+            if(current_graphics_index == next_vram_graphics_index)
+            {
+                _tiles.apply_tiles_delta(_delta_item, current_graphics_index);
+            }
+            else
+            {
+                // The action has been reset, so the tile set is rebuilt from the first one:
+                _tiles.reload_tiles_delta(_delta_item);
+
+                for(int graphics_index = 1; graphics_index <= current_graphics_index; ++graphics_index)
+                {
+                    _tiles.apply_tiles_delta(_delta_item, graphics_index);
+                }
+            }
+
+            _vram_graphics_index = uint16_t(current_graphics_index);
+        }
+
+        if(_forever && current_graphics_index == graphics_count - 1)
+        {
+            _current_graphics_index = 0;
+        }
+        else
+        {
+            ++_current_graphics_index;
+        }
+    }
+}
+
+void sprite_delta_animate_action::set_wait_updates(int wait_updates)
+{
+    BN_ASSERT(wait_updates >= 0, "Invalid wait updates: ", wait_updates);
+    BN_ASSERT(wait_updates <= numeric_limits<decltype(_wait_updates)>::max(),
+              "Too many wait updates: ", wait_updates);
+
+    _wait_updates = uint16_t(wait_updates);
+
+    if(wait_updates < _current_wait_updates)
+    {
+        _current_wait_updates = uint16_t(wait_updates);
+    }
+}
+
+void sprite_delta_animate_action::_init(int wait_updates)
+{
+    BN_ASSERT(_delta_item.graphics_count() > 1, "Invalid graphics count: ", _delta_item.graphics_count());
+
+    set_wait_updates(wait_updates);
+    _sprite.set_tiles(_tiles);
+}
+
 }
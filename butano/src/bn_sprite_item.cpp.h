@@ -58,4 +58,15 @@ optional<sprite_ptr> sprite_item::create_sprite_optional(const fixed_point& posi
     return sprite_ptr::create_optional(position, *this, graphics_index);
 }
 
+void sprite_item::create_sprites(const span<const fixed_point>& positions, ivector<sprite_ptr>& output_sprites) const
+{
+    sprite_ptr::create_many(positions, *this, output_sprites);
+}
+
+void sprite_item::create_sprites(const span<const fixed_point>& positions, int graphics_index,
+                                 ivector<sprite_ptr>& output_sprites) const
+{
+    sprite_ptr::create_many(positions, *this, graphics_index, output_sprites);
+}
+
 }
@@ -6,6 +6,8 @@
 #include "bn_sprite_ptr.h"
 
 #include "bn_size.h"
+#include "bn_span.h"
+#include "bn_vector.h"
 #include "bn_sprite_builder.h"
 #include "bn_sprites_manager.h"
 #include "bn_affine_mat_attributes.h"
@@ -185,6 +187,56 @@ optional<sprite_ptr> sprite_ptr::create_optional(sprite_builder&& builder)
     return result;
 }
 
+void sprite_ptr::create_many(const span<const fixed_point>& positions, const sprite_item& item,
+                             ivector<sprite_ptr>& output_sprites)
+{
+    create_many(positions, item, 0, output_sprites);
+}
+
+void sprite_ptr::create_many(const span<const fixed_point>& positions, const sprite_item& item, int graphics_index,
+                             ivector<sprite_ptr>& output_sprites)
+{
+    int count = positions.size();
+    int output_size = output_sprites.size();
+    BN_ASSERT(count <= output_sprites.max_size() - output_size,
+              "Not enough space in output sprites vector: ", count, " - ",
+              output_sprites.max_size() - output_size);
+
+    if(count)
+    {
+        sprite_tiles_ptr tiles = item.tiles_item().create_tiles(graphics_index);
+        sprite_palette_ptr palette = item.palette_item().create_palette();
+        sprite_shape_size shape_size = item.shape_size();
+        const fixed_point* positions_data = positions.data();
+        handle_type handles[32];
+
+        while(count)
+        {
+            int chunk_count = min(count, int(sizeof(handles) / sizeof(handle_type)));
+            sprites_manager::create_many(positions_data, chunk_count, shape_size, tiles, palette, handles);
+
+            for(int index = 0; index < chunk_count; ++index)
+            {
+                output_sprites.push_back(sprite_ptr(handles[index]));
+            }
+
+            positions_data += chunk_count;
+            count -= chunk_count;
+        }
+    }
+}
+
+void sprite_ptr::set_positions(const span<sprite_ptr>& sprites, const span<const fixed_point>& positions)
+{
+    BN_ASSERT(sprites.size() == positions.size(), "Invalid positions count: ", sprites.size(), " - ",
+              positions.size());
+
+    static_assert(sizeof(sprite_ptr) == sizeof(handle_type));
+
+    auto handles = reinterpret_cast<const handle_type*>(sprites.data());
+    sprites_manager::set_positions(handles, positions.data(), sprites.size());
+}
+
 sprite_ptr::sprite_ptr(const sprite_ptr& other) :
     sprite_ptr(other._handle)
 {
@@ -692,6 +744,16 @@ void sprite_ptr::put_below()
     sprites_manager::put_below(_handle);
 }
 
+bool sprite_ptr::y_sort_enabled() const
+{
+    return sprites_manager::y_sort_enabled(_handle);
+}
+
+void sprite_ptr::set_y_sort_enabled(bool y_sort_enabled)
+{
+    sprites_manager::set_y_sort_enabled(_handle, y_sort_enabled);
+}
+
 bool sprite_ptr::horizontal_flip() const
 {
     return sprites_manager::horizontal_flip(_handle);
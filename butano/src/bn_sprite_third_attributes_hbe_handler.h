@@ -8,6 +8,7 @@
 
 #include "bn_sprite_third_attributes.h"
 #include "bn_sprites_manager.h"
+#include "bn_sprite_tiles_manager.h"
 #include "../hw/include/bn_hw_sprites.h"
 
 namespace bn
@@ -35,6 +36,12 @@ public:
         sprite_shape_size new_value = sprites_manager::shape_size(handle);
         bool updated = *last_value != new_value;
         *last_value = new_value;
+
+        #if BN_CFG_SPRITE_TILES_DEFRAG_MAX_TILES
+            // Tile indexes must be written again if tiles have been moved in VRAM:
+            updated |= sprite_tiles_manager::relocated();
+        #endif
+
         return updated;
     }
 
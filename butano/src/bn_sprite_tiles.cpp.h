@@ -30,6 +30,31 @@ int available_items_count()
     return sprite_tiles_manager::available_items_count();
 }
 
+fixed fragmentation()
+{
+    return sprite_tiles_manager::fragmentation();
+}
+
+int cached_tiles_count()
+{
+    return sprite_tiles_manager::cached_tiles_count();
+}
+
+int cache_hits_count()
+{
+    return sprite_tiles_manager::cache_hits_count();
+}
+
+int cache_misses_count()
+{
+    return sprite_tiles_manager::cache_misses_count();
+}
+
+void reset_cache_counters()
+{
+    sprite_tiles_manager::reset_cache_counters();
+}
+
 void log_status()
 {
     #if BN_CFG_LOG_ENABLED
@@ -0,0 +1,32 @@
+/*
+ * Copyright (c) 2020-2023 Gustavo Valiente gustavo.valiente@protonmail.com
+ * zlib License, see LICENSE file.
+ */
+
+#include "bn_sprite_tiles_delta_item.h"
+
+#include "bn_sprite_tiles_ptr.h"
+
+namespace bn
+{
+
+sprite_tiles_ptr sprite_tiles_delta_item::create_tiles() const
+{
+    sprite_tiles_ptr result = sprite_tiles_ptr::allocate(_tiles_count_per_graphic, _bpp);
+    result.reload_tiles_delta(*this);
+    return result;
+}
+
+optional<sprite_tiles_ptr> sprite_tiles_delta_item::create_tiles_optional() const
+{
+    optional<sprite_tiles_ptr> result = sprite_tiles_ptr::allocate_optional(_tiles_count_per_graphic, _bpp);
+
+    if(sprite_tiles_ptr* result_ptr = result.get())
+    {
+        result_ptr->reload_tiles_delta(*this);
+    }
+
+    return result;
+}
+
+}
@@ -9,12 +9,14 @@
 #include "bn_string_view.h"
 #include "bn_unordered_map.h"
 #include "bn_config_sprite_tiles.h"
+#include "bn_resumable_decompressor.h"
 #include "../hw/include/bn_hw_sprite_tiles.h"
 #include "../hw/include/bn_hw_sprite_tiles_constants.h"
 
 #include "bn_sprite_tiles.cpp.h"
 #include "bn_sprite_tiles_ptr.cpp.h"
 #include "bn_sprite_tiles_item.cpp.h"
+#include "bn_sprite_tiles_delta_item.cpp.h"
 
 #if BN_CFG_SPRITE_TILES_LOG_ENABLED
     #include "bn_log.h"
@@ -33,6 +35,7 @@ namespace
     static_assert(BN_CFG_SPRITE_TILES_MAX_ITEMS > 0 &&
                   BN_CFG_SPRITE_TILES_MAX_ITEMS <= hw::sprite_tiles::tiles_count());
     static_assert(power_of_two(BN_CFG_SPRITE_TILES_MAX_ITEMS));
+    static_assert(BN_CFG_SPRITE_TILES_MAX_DELTA_RUNS > 0);
 
 
     #if BN_CFG_LOG_ENABLED
@@ -69,12 +72,17 @@ namespace
     public:
         const tile* data = nullptr;
         unsigned usages = 0;
+
+        #if BN_CFG_SPRITE_TILES_CACHE_ENABLED
+            unsigned release_stamp = 0;
+        #endif
+
         unsigned start_tile: 12 = 0;
         unsigned tiles_count: 12 = 0;
 
     private:
         uint8_t _status: 2 = uint8_t(status_type::FREE);
-        uint8_t _compression: 2 = uint8_t(compression_type::NONE);
+        uint8_t _compression: 3 = uint8_t(compression_type::NONE);
 
     public:
         bool commit: 1 = false;
@@ -257,6 +265,17 @@ namespace
     };
 
 
+    class delta_run_type
+    {
+
+    public:
+        const tile* source_tiles_ptr;
+        uint16_t id;
+        uint8_t first_tile;
+        uint8_t tiles_count;
+    };
+
+
     class static_data
     {
 
@@ -267,6 +286,24 @@ namespace
         vector<uint16_t, max_items> to_remove_items;
         vector<uint16_t, max_items> to_commit_uncompressed_items;
         vector<uint16_t, max_items> to_commit_compressed_items;
+        vector<delta_run_type, BN_CFG_SPRITE_TILES_MAX_DELTA_RUNS> to_commit_delta_runs;
+        unsigned cache_hits = 0;
+        unsigned cache_misses = 0;
+
+        #if BN_CFG_SPRITE_TILES_CACHE_ENABLED
+            unsigned release_stamp = 0;
+            unsigned frame_release_stamp = 0;
+        #endif
+
+        #if BN_CFG_SPRITE_TILES_DEFRAG_MAX_TILES
+            relocation_data relocation;
+        #endif
+
+        #if BN_CFG_SPRITE_TILES_DECOMPRESSION_BYTES_PER_FRAME
+            resumable_decompressor decompressor;
+            int decompressing_id = -1;
+        #endif
+
         uint16_t free_tiles_count = 0;
         uint16_t to_remove_tiles_count = 0;
         bool delay_commit = false;
@@ -340,6 +377,7 @@ namespace
 
             BN_LOG("free_tiles_count: ", data.free_tiles_count);
             BN_LOG("to_remove_tiles_count: ", data.to_remove_tiles_count);
+            BN_LOG("cache_hits: ", data.cache_hits, " - cache_misses: ", data.cache_misses);
             BN_LOG("delay_commit: ", (data.delay_commit ? "true" : "false"));
         }
 
@@ -438,6 +476,13 @@ namespace
         {
             item.commit = false;
 
+            #if BN_CFG_SPRITE_TILES_DECOMPRESSION_BYTES_PER_FRAME
+                if(data.decompressing_id == id)
+                {
+                    data.decompressor.stop();
+                }
+            #endif
+
             vector<uint16_t, max_items>& to_commit_items =
                     item.compression() == compression_type::NONE ?
                         data.to_commit_uncompressed_items : data.to_commit_compressed_items;
@@ -479,6 +524,7 @@ namespace
                 item.set_status(status_type::USED);
                 _erase_to_remove_item(id);
                 data.to_remove_tiles_count -= item.tiles_count;
+                ++data.cache_hits;
 
                 if(item.commit_if_recovered)
                 {
@@ -525,6 +571,10 @@ namespace
             hw::decompress::huff(source_tiles_ptr, hw::sprite_tiles::tile_vram(index));
             break;
 
+        case compression_type::FAST_LZ:
+            hw::decompress::fast_lz(source_tiles_ptr, hw::sprite_tiles::tile_vram(index));
+            break;
+
         default:
             BN_ERROR("Unknown compression type: ", int(compression));
             break;
@@ -565,6 +615,14 @@ namespace
         item.usages = 1;
         item.set_status(status_type::USED);
 
+        #if BN_CFG_SPRITE_TILES_DECOMPRESSION_BYTES_PER_FRAME
+            // Compressed items are decompressed progressively:
+            if(compression != compression_type::NONE)
+            {
+                delay_commit = true;
+            }
+        #endif
+
         if(tiles_data)
         {
             if(delay_commit)
@@ -598,11 +656,126 @@ namespace
         return new_free_item_id;
     }
 
-    [[nodiscard]] int _create_impl(const tile* tiles_data, compression_type compression, int tiles_count)
+    void _remove_item(int id)
     {
-        int to_remove_tiles_count = data.to_remove_tiles_count;
+        auto end = data.items.end();
+        auto iterator = data.items.it(id);
+        item_type& item = *iterator;
+
+        if(item.data)
+        {
+            data.items_map.erase(item.data);
+            item.data = nullptr;
+        }
+
+        item.set_status(status_type::FREE);
+        item.commit_if_recovered = false;
+        data.free_tiles_count += item.tiles_count;
+
+        auto next_iterator = iterator;
+        ++next_iterator;
+
+        if(next_iterator != end)
+        {
+            const item_type& next_item = *next_iterator;
+
+            if(next_item.status() == status_type::FREE)
+            {
+                int next_id = next_iterator.id();
+                item.tiles_count += next_item.tiles_count;
+                _erase_free_item(next_id);
+                data.items.erase(next_id);
+            }
+        }
+
+        if(iterator != data.items.begin())
+        {
+            auto previous_iterator = iterator;
+            --previous_iterator;
+
+            const item_type& previous_item = *previous_iterator;
+
+            if(previous_item.status() == status_type::FREE)
+            {
+                int previous_id = previous_iterator.id();
+                item.start_tile = previous_item.start_tile;
+                item.tiles_count += previous_item.tiles_count;
+                _erase_free_item(previous_id);
+                data.items.erase(previous_id);
+            }
+        }
+
+        _insert_free_item(id);
+    }
+
+    #if BN_CFG_SPRITE_TILES_CACHE_ENABLED
+        [[nodiscard]] bool _released_in_this_frame(const item_type& item)
+        {
+            unsigned frame_release_stamp = data.frame_release_stamp;
+            return item.release_stamp - frame_release_stamp < data.release_stamp - frame_release_stamp;
+        }
+
+        [[nodiscard]] ivector<uint16_t>::iterator _oldest_to_remove_item(
+                ivector<uint16_t>::iterator first, ivector<uint16_t>::iterator last)
+        {
+            unsigned release_stamp = data.release_stamp;
+            auto result = last;
+            unsigned result_age = 0;
+
+            for(auto it = first; it != last; ++it)
+            {
+                unsigned age = release_stamp - data.items.item(*it).release_stamp;
+
+                if(result == last || age > result_age)
+                {
+                    result = it;
+                    result_age = age;
+                }
+            }
+
+            return result;
+        }
+
+        [[nodiscard]] bool _remove_oldest_cached_item(bool released_in_previous_frames_only)
+        {
+            auto to_remove_items_begin = data.to_remove_items.begin();
+            auto to_remove_items_end = data.to_remove_items.end();
+            auto to_remove_items_it = _oldest_to_remove_item(to_remove_items_begin, to_remove_items_end);
+
+            if(to_remove_items_it == to_remove_items_end)
+            {
+                return false;
+            }
+
+            int id = *to_remove_items_it;
+            const item_type& item = data.items.item(id);
+            bool released_in_this_frame = _released_in_this_frame(item);
+
+            if(released_in_this_frame && released_in_previous_frames_only)
+            {
+                return false;
+            }
 
-        if(tiles_count <= to_remove_tiles_count &&
+            BN_SPRITE_TILES_LOG("REMOVE CACHED. start_tile: ", item.start_tile);
+
+            data.to_remove_items.erase(to_remove_items_it);
+            data.to_remove_tiles_count -= item.tiles_count;
+            _remove_item(id);
+
+            if(released_in_this_frame)
+            {
+                // Its tiles can still be shown until the next commit:
+                data.delay_commit = true;
+            }
+
+            return true;
+        }
+    #endif
+
+    [[nodiscard]] int _create_from_to_remove_items(
+            const tile* tiles_data, compression_type compression, int tiles_count)
+    {
+        if(tiles_count <= data.to_remove_tiles_count &&
                 (data.delay_commit || compression == compression_type::NONE))
         {
             auto to_remove_items_end = data.to_remove_items.end();
@@ -610,6 +783,12 @@ namespace
                         data.to_remove_items.begin(), to_remove_items_end, tiles_count,
                         tiles_count_lower_bound_comparator);
 
+            #if BN_CFG_SPRITE_TILES_CACHE_ENABLED
+                to_remove_items_end = upper_bound(to_remove_items_it, to_remove_items_end, unsigned(tiles_count),
+                                                  tiles_count_upper_bound_comparator);
+                to_remove_items_it = _oldest_to_remove_item(to_remove_items_it, to_remove_items_end);
+            #endif
+
             if(to_remove_items_it != to_remove_items_end)
             {
                 int id = *to_remove_items_it;
@@ -631,6 +810,11 @@ namespace
             }
         }
 
+        return -1;
+    }
+
+    [[nodiscard]] int _create_from_free_items(const tile* tiles_data, compression_type compression, int tiles_count)
+    {
         if(tiles_count <= data.free_tiles_count)
         {
             auto free_items_end = data.free_items.end();
@@ -653,16 +837,43 @@ namespace
             }
         }
 
-        if(to_remove_tiles_count)
-        {
-            update();
-            data.delay_commit = true;
-            return _create_impl(tiles_data, compression, tiles_count);
-        }
-
         return -1;
     }
 
+    [[nodiscard]] int _create_impl(const tile* tiles_data, compression_type compression, int tiles_count)
+    {
+        #if BN_CFG_SPRITE_TILES_CACHE_ENABLED
+            // Free space is used first to keep released tiles in VRAM as long as possible:
+            int result = _create_from_free_items(tiles_data, compression, tiles_count);
+
+            if(result < 0)
+            {
+                result = _create_from_to_remove_items(tiles_data, compression, tiles_count);
+
+                if(result < 0 && _remove_oldest_cached_item(false))
+                {
+                    result = _create_impl(tiles_data, compression, tiles_count);
+                }
+            }
+        #else
+            int result = _create_from_to_remove_items(tiles_data, compression, tiles_count);
+
+            if(result < 0)
+            {
+                result = _create_from_free_items(tiles_data, compression, tiles_count);
+
+                if(result < 0 && data.to_remove_tiles_count)
+                {
+                    update();
+                    data.delay_commit = true;
+                    result = _create_impl(tiles_data, compression, tiles_count);
+                }
+            }
+        #endif
+
+        return result;
+    }
+
     [[nodiscard]] int _allocate_impl(int tiles_count)
     {
         if(data.delay_commit)
@@ -692,8 +903,35 @@ namespace
             }
         }
 
+        #if BN_CFG_SPRITE_TILES_CACHE_ENABLED
+            if(_remove_oldest_cached_item(true))
+            {
+                return _allocate_impl(tiles_count);
+            }
+        #endif
+
         return -1;
     }
+
+    void _commit_delta_runs(bool use_dma)
+    {
+        // Runs are committed in order, since later runs can overwrite the tiles of the previous ones:
+        for(const delta_run_type& delta_run : data.to_commit_delta_runs)
+        {
+            int start_tile = int(data.items.item(delta_run.id).start_tile) + delta_run.first_tile;
+
+            if(use_dma)
+            {
+                hw::sprite_tiles::commit_with_dma(delta_run.source_tiles_ptr, start_tile, delta_run.tiles_count);
+            }
+            else
+            {
+                hw::sprite_tiles::commit_with_cpu(delta_run.source_tiles_ptr, start_tile, delta_run.tiles_count);
+            }
+        }
+
+        data.to_commit_delta_runs.clear();
+    }
 }
 
 void init()
@@ -731,6 +969,40 @@ int available_items_count()
     return data.items.available();
 }
 
+fixed fragmentation()
+{
+    int free_tiles_count = data.free_tiles_count;
+
+    if(! free_tiles_count)
+    {
+        return 0;
+    }
+
+    int biggest_free_item_tiles_count = data.items.item(data.free_items.back()).tiles_count;
+    return 1 - (fixed(biggest_free_item_tiles_count) / free_tiles_count);
+}
+
+int cached_tiles_count()
+{
+    return data.to_remove_tiles_count;
+}
+
+int cache_hits_count()
+{
+    return int(data.cache_hits);
+}
+
+int cache_misses_count()
+{
+    return int(data.cache_misses);
+}
+
+void reset_cache_counters()
+{
+    data.cache_hits = 0;
+    data.cache_misses = 0;
+}
+
 #if BN_CFG_LOG_ENABLED
     void log_status()
     {
@@ -755,6 +1027,7 @@ int available_items_count()
 
             BN_LOG("free_tiles_count: ", data.free_tiles_count);
             BN_LOG("to_remove_tiles_count: ", data.to_remove_tiles_count);
+            BN_LOG("cache_hits: ", data.cache_hits, " - cache_misses: ", data.cache_misses);
         #endif
     }
 #endif
@@ -783,6 +1056,7 @@ int create(const span<const tile>& tiles_ref, compression_type compression)
         return result;
     }
 
+    ++data.cache_misses;
     result = _create_impl(tiles_data, compression, tiles_count);
 
     if(result >= 0)
@@ -855,6 +1129,7 @@ int create_optional(const span<const tile>& tiles_ref, compression_type compress
         return result;
     }
 
+    ++data.cache_misses;
     result = _create_impl(tiles_data, compression, tiles_count);
 
     if(result >= 0)
@@ -915,9 +1190,23 @@ void decrease_usages(int id)
 
     if(! item.usages)
     {
+        #if BN_CFG_SPRITE_TILES_CACHE_ENABLED
+            item.release_stamp = data.release_stamp;
+            ++data.release_stamp;
+        #endif
+
         item.set_status(status_type::TO_REMOVE);
         item.commit_if_recovered = item.commit;
         _erase_to_commit_item(id, item);
+
+        if(! item.data)
+        {
+            erase_if(data.to_commit_delta_runs, [id](const delta_run_type& delta_run)
+            {
+                return delta_run.id == id;
+            });
+        }
+
         _insert_to_remove_item(id);
         data.to_remove_tiles_count += item.tiles_count;
     }
@@ -1018,6 +1307,11 @@ void reload_tiles_ref(int id)
     BN_SPRITE_TILES_LOG_STATUS();
 }
 
+bool ready(int id)
+{
+    return ! data.items.item(id).commit;
+}
+
 optional<span<tile>> vram(int id)
 {
     const item_type& item = data.items.item(id);
@@ -1031,77 +1325,203 @@ optional<span<tile>> vram(int id)
     return result;
 }
 
-void update()
+void commit_delta(int id, const tile* source_tiles_ptr, int first_tile, int tiles_count)
 {
-    if(data.to_remove_tiles_count)
+    const item_type& item = data.items.item(id);
+
+    BN_SPRITE_TILES_LOG("sprite_tiles_manager - COMMIT_DELTA: ", item.start_tile, " - ", source_tiles_ptr,
+                        " - ", first_tile, " - ", tiles_count);
+
+    BN_BASIC_ASSERT(! item.data, "Item has data");
+    BN_BASIC_ASSERT(first_tile >= 0 && tiles_count > 0 && first_tile + tiles_count <= int(item.tiles_count),
+                    "Invalid delta run: ", first_tile, " - ", tiles_count, " - ", int(item.tiles_count));
+
+    if(data.to_commit_delta_runs.full())
     {
-        BN_SPRITE_TILES_LOG("sprite_tiles_manager - UPDATE");
+        // Pending runs are copied now instead of waiting for the next vertical blank,
+        // keeping their order (later runs can overwrite the tiles of the previous ones):
+        BN_SPRITE_TILES_LOG("sprite_tiles_manager - COMMIT_DELTA: FLUSH");
+        _commit_delta_runs(false);
+    }
+
+    data.to_commit_delta_runs.push_back(
+                delta_run_type{ source_tiles_ptr, uint16_t(id), uint8_t(first_tile), uint8_t(tiles_count) });
+}
+
+#if BN_CFG_SPRITE_TILES_DEFRAG_MAX_TILES
+    relocation_data defragment()
+    {
+        relocation_data& relocation = data.relocation;
+        BN_BASIC_ASSERT(! relocation.tiles_count, "Previous relocation not committed");
+
+        int free_items_count = data.free_items.size();
+
+        if(! free_items_count)
+        {
+            return relocation;
+        }
+
+        if(free_items_count == 1 && data.items.item(data.free_items[0]).next_index == data.items.end().id())
+        {
+            return relocation;
+        }
 
-        auto begin = data.items.begin();
         auto end = data.items.end();
 
-        for(int to_remove_item_index : data.to_remove_items)
+        for(auto it = data.items.begin(); it != end; ++it)
         {
-            auto iterator = data.items.it(to_remove_item_index);
-            item_type& item = *iterator;
+            const item_type& free_item = *it;
 
-            if(item.data)
+            if(free_item.status() != status_type::FREE)
             {
-                data.items_map.erase(item.data);
-                item.data = nullptr;
+                continue;
             }
 
-            item.set_status(status_type::FREE);
-            item.commit_if_recovered = false;
-            data.free_tiles_count += item.tiles_count;
+            // The tile sets placed after the free item are moved to its start:
+            auto first_moved_it = it;
+            ++first_moved_it;
 
-            auto next_iterator = iterator;
-            ++next_iterator;
+            auto last_moved_it = first_moved_it;
+            int moved_tiles_count = 0;
 
-            if(next_iterator != end)
+            while(last_moved_it != end)
             {
-                const item_type& next_item = *next_iterator;
+                const item_type& moved_item = *last_moved_it;
+                int next_moved_tiles_count = moved_tiles_count + int(moved_item.tiles_count);
 
-                if(next_item.status() == status_type::FREE)
+                if(moved_item.status() == status_type::FREE || ! moved_item.data ||
+                        next_moved_tiles_count > BN_CFG_SPRITE_TILES_DEFRAG_MAX_TILES)
                 {
-                    int next_id = next_iterator.id();
-                    item.tiles_count += next_item.tiles_count;
-                    _erase_free_item(next_id);
-                    data.items.erase(next_id);
+                    break;
                 }
+
+                moved_tiles_count = next_moved_tiles_count;
+                ++last_moved_it;
+            }
+
+            if(! moved_tiles_count)
+            {
+                continue;
             }
 
-            if(iterator != begin)
+            int free_id = it.id();
+            int free_tiles_count = free_item.tiles_count;
+            int destination_tile = free_item.start_tile;
+            int source_tile = destination_tile + free_tiles_count;
+
+            for(auto moved_it = first_moved_it; moved_it != last_moved_it; ++moved_it)
             {
-                auto previous_iterator = iterator;
-                --previous_iterator;
+                item_type& moved_item = *moved_it;
+                moved_item.start_tile = moved_item.start_tile - unsigned(free_tiles_count);
+            }
 
-                const item_type& previous_item = *previous_iterator;
+            // And the free item is moved after them:
+            _erase_free_item(free_id);
+            data.items.erase(free_id);
 
-                if(previous_item.status() == status_type::FREE)
+            item_type new_free_item;
+            new_free_item.start_tile = unsigned(destination_tile + moved_tiles_count);
+            new_free_item.tiles_count = unsigned(free_tiles_count);
+
+            if(last_moved_it != end)
+            {
+                const item_type& next_item = *last_moved_it;
+
+                if(next_item.status() == status_type::FREE)
                 {
-                    int previous_id = previous_iterator.id();
-                    item.start_tile = previous_item.start_tile;
-                    item.tiles_count += previous_item.tiles_count;
-                    _erase_free_item(previous_id);
-                    data.items.erase(previous_id);
+                    int next_id = last_moved_it.id();
+                    new_free_item.tiles_count = new_free_item.tiles_count + next_item.tiles_count;
+                    ++last_moved_it;
+                    _erase_free_item(next_id);
+                    data.items.erase(next_id);
                 }
             }
 
-            _insert_free_item(to_remove_item_index);
+            auto new_free_item_it = data.items.insert(last_moved_it.id(), new_free_item);
+            _insert_free_item(new_free_item_it.id());
+
+            relocation.source_tile = source_tile;
+            relocation.destination_tile = destination_tile;
+            relocation.tiles_count = moved_tiles_count;
+
+            BN_SPRITE_TILES_LOG("sprite_tiles_manager - DEFRAGMENT: ", source_tile, " - ", destination_tile,
+                                " - ", moved_tiles_count);
+            BN_SPRITE_TILES_LOG_STATUS();
+            break;
         }
 
-        data.to_remove_items.clear();
-        data.to_remove_tiles_count = 0;
+        return relocation;
+    }
+
+    bool relocated()
+    {
+        return data.relocation.tiles_count;
+    }
+#endif
+
+void update()
+{
+    if(data.to_remove_tiles_count)
+    {
+        BN_SPRITE_TILES_LOG("sprite_tiles_manager - UPDATE");
+
+        #if BN_CFG_SPRITE_TILES_CACHE_ENABLED
+            // Released tiles are kept in VRAM, except allocated ones:
+            ivector<uint16_t>& to_remove_items = data.to_remove_items;
+
+            for(int index = to_remove_items.size() - 1; index >= 0; --index)
+            {
+                int to_remove_item_index = to_remove_items[index];
+                const item_type& item = data.items.item(to_remove_item_index);
+
+                if(! item.data)
+                {
+                    data.to_remove_tiles_count -= item.tiles_count;
+                    to_remove_items.erase(to_remove_items.begin() + index);
+                    _remove_item(to_remove_item_index);
+                }
+            }
+        #else
+            for(int to_remove_item_index : data.to_remove_items)
+            {
+                _remove_item(to_remove_item_index);
+            }
+
+            data.to_remove_items.clear();
+            data.to_remove_tiles_count = 0;
+        #endif
 
         BN_SPRITE_TILES_LOG_STATUS();
     }
 
+    #if BN_CFG_SPRITE_TILES_CACHE_ENABLED
+        data.frame_release_stamp = data.release_stamp;
+    #endif
+
     data.delay_commit = false;
 }
 
 void commit_uncompressed(bool use_dma)
 {
+    #if BN_CFG_SPRITE_TILES_DEFRAG_MAX_TILES
+        // Tiles must be moved before committing other tiles to the free space:
+        relocation_data& relocation = data.relocation;
+
+        if(int tiles_count = relocation.tiles_count)
+        {
+            if(use_dma)
+            {
+                hw::sprite_tiles::move_with_dma(relocation.source_tile, tiles_count, relocation.destination_tile);
+            }
+            else
+            {
+                hw::sprite_tiles::move_with_cpu(relocation.source_tile, tiles_count, relocation.destination_tile);
+            }
+
+            relocation.tiles_count = 0;
+        }
+    #endif
+
     if(! data.to_commit_uncompressed_items.empty())
     {
         BN_SPRITE_TILES_LOG("sprite_tiles_manager - COMMIT UNCOMPRESSED");
@@ -1129,6 +1549,13 @@ void commit_uncompressed(bool use_dma)
 
         BN_SPRITE_TILES_LOG_STATUS();
     }
+
+    if(! data.to_commit_delta_runs.empty())
+    {
+        BN_SPRITE_TILES_LOG("sprite_tiles_manager - COMMIT DELTA RUNS");
+
+        _commit_delta_runs(use_dma);
+    }
 }
 
 void commit_compressed()
@@ -1137,14 +1564,62 @@ void commit_compressed()
     {
         BN_SPRITE_TILES_LOG("sprite_tiles_manager - COMMIT COMPRESSED");
 
-        for(int item_index : data.to_commit_compressed_items)
-        {
-            item_type& item = data.items.item(item_index);
-            _hw_commit(item.data, item.compression(), int(item.start_tile), int(item.tiles_count));
-            item.commit = false;
-        }
+        #if BN_CFG_SPRITE_TILES_DECOMPRESSION_BYTES_PER_FRAME
+            vector<uint16_t, max_items>& to_commit_items = data.to_commit_compressed_items;
+            resumable_decompressor& decompressor = data.decompressor;
+            int max_bytes = BN_CFG_SPRITE_TILES_DECOMPRESSION_BYTES_PER_FRAME;
+            int committed_items_count = 0;
 
-        data.to_commit_compressed_items.clear();
+            // The item being decompressed is committed first:
+            if(decompressor.source_ptr())
+            {
+                auto decompressing_it = bn::find(to_commit_items.begin(), to_commit_items.end(),
+                                                 uint16_t(data.decompressing_id));
+
+                if(decompressing_it != to_commit_items.end())
+                {
+                    swap(*to_commit_items.begin(), *decompressing_it);
+                }
+            }
+
+            for(int item_index : to_commit_items)
+            {
+                if(max_bytes <= 0)
+                {
+                    break;
+                }
+
+                item_type& item = data.items.item(item_index);
+
+                if(data.decompressing_id != item_index || decompressor.source_ptr() != item.data)
+                {
+                    decompressor.start(item.data, item.compression());
+                    data.decompressing_id = item_index;
+                }
+
+                max_bytes -= decompressor.decompress(hw::sprite_tiles::tile_vram(int(item.start_tile)), max_bytes);
+
+                if(! decompressor.finished())
+                {
+                    break;
+                }
+
+                decompressor.stop();
+                item.commit = false;
+                ++committed_items_count;
+            }
+
+            to_commit_items.erase(to_commit_items.begin(), to_commit_items.begin() + committed_items_count);
+        #else
+            for(int item_index : data.to_commit_compressed_items)
+            {
+                item_type& item = data.items.item(item_index);
+                _hw_commit(item.data, item.compression(), int(item.start_tile), int(item.tiles_count));
+                item.commit = false;
+            }
+
+            data.to_commit_compressed_items.clear();
+        #endif
 
         BN_SPRITE_TILES_LOG_STATUS();
     }
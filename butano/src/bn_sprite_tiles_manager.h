@@ -7,8 +7,10 @@
 #define BN_SPRITE_TILES_MANAGER_H
 
 #include "bn_span.h"
+#include "bn_fixed.h"
 #include "bn_optional.h"
 #include "bn_config_log.h"
+#include "bn_config_sprite_tiles.h"
 
 namespace bn
 {
@@ -19,6 +21,17 @@ namespace bn
 
 namespace bn::sprite_tiles_manager
 {
+    #if BN_CFG_SPRITE_TILES_DEFRAG_MAX_TILES
+        class relocation_data
+        {
+
+        public:
+            int source_tile = 0;
+            int destination_tile = 0;
+            int tiles_count = 0;
+        };
+    #endif
+
     void init();
 
     [[nodiscard]] int used_tiles_count();
@@ -29,6 +42,16 @@ namespace bn::sprite_tiles_manager
 
     [[nodiscard]] int available_items_count();
 
+    [[nodiscard]] fixed fragmentation();
+
+    [[nodiscard]] int cached_tiles_count();
+
+    [[nodiscard]] int cache_hits_count();
+
+    [[nodiscard]] int cache_misses_count();
+
+    void reset_cache_counters();
+
     #if BN_CFG_LOG_ENABLED
         void log_status();
     #endif
@@ -59,8 +82,18 @@ namespace bn::sprite_tiles_manager
 
     void reload_tiles_ref(int id);
 
+    [[nodiscard]] bool ready(int id);
+
     [[nodiscard]] optional<span<tile>> vram(int id);
 
+    void commit_delta(int id, const tile* source_tiles_ptr, int first_tile, int tiles_count);
+
+    #if BN_CFG_SPRITE_TILES_DEFRAG_MAX_TILES
+        [[nodiscard]] relocation_data defragment();
+
+        [[nodiscard]] bool relocated();
+    #endif
+
     void update();
 
     void commit_uncompressed(bool use_dma);
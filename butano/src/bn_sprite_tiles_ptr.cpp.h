@@ -7,6 +7,7 @@
 
 #include "bn_sprite_tiles_item.h"
 #include "bn_sprite_tiles_manager.h"
+#include "bn_sprite_tiles_delta_item.h"
 
 namespace bn
 {
@@ -142,6 +143,11 @@ compression_type sprite_tiles_ptr::compression() const
     return sprite_tiles_manager::compression(_handle);
 }
 
+bool sprite_tiles_ptr::ready() const
+{
+    return sprite_tiles_manager::ready(_handle);
+}
+
 optional<span<const tile>> sprite_tiles_ptr::tiles_ref() const
 {
     return sprite_tiles_manager::tiles_ref(_handle);
@@ -163,6 +169,27 @@ void sprite_tiles_ptr::reload_tiles_ref()
     sprite_tiles_manager::reload_tiles_ref(_handle);
 }
 
+void sprite_tiles_ptr::reload_tiles_delta(const sprite_tiles_delta_item& delta_item)
+{
+    BN_ASSERT(delta_item.tiles_count_per_graphic() == tiles_count(),
+              "Invalid tiles count: ", delta_item.tiles_count_per_graphic(), " - ", tiles_count());
+
+    sprite_tiles_manager::commit_delta(_handle, delta_item.tiles_ref().data(), 0, tiles_count());
+}
+
+void sprite_tiles_ptr::apply_tiles_delta(const sprite_tiles_delta_item& delta_item, int graphics_index)
+{
+    BN_ASSERT(delta_item.tiles_count_per_graphic() == tiles_count(),
+              "Invalid tiles count: ", delta_item.tiles_count_per_graphic(), " - ", tiles_count());
+
+    const tile* tiles_data = delta_item.tiles_ref().data();
+
+    for(uint32_t run : delta_item.graphics_runs_ref(graphics_index))
+    {
+        sprite_tiles_manager::commit_delta(_handle, tiles_data + (run >> 16), int(run & 0xFF), int((run >> 8) & 0xFF));
+    }
+}
+
 optional<span<tile>> sprite_tiles_ptr::vram()
 {
     return sprite_tiles_manager::vram(_handle);
@@ -51,6 +51,16 @@ void set_reserved_handles_count(int reserved_handles_count)
     return sprites_manager::set_reserved_handles_count(reserved_handles_count);
 }
 
+int last_committed_bytes()
+{
+    return sprites_manager::last_committed_bytes();
+}
+
+int multiplexed_items_count(int band)
+{
+    return sprites_manager::multiplexed_items_count(band);
+}
+
 void reload()
 {
     sprites_manager::reload_all();
@@ -0,0 +1,211 @@
+/*
+ * Copyright (c) 2020-2023 Gustavo Valiente gustavo.valiente@protonmail.com
+ * zlib License, see LICENSE file.
+ */
+
+#ifndef BN_SPRITES_CULLING_GRID_H
+#define BN_SPRITES_CULLING_GRID_H
+
+#include "bn_config_cameras.h"
+#include "bn_cameras_manager.h"
+#include "bn_sprites_manager_item.h"
+
+namespace bn
+{
+
+class sprites_culling_grid
+{
+
+public:
+    static constexpr int cell_shift = 7;
+    static constexpr int columns_shift = 4;
+    static constexpr int columns = 1 << columns_shift;
+    static constexpr int buckets_count = columns * columns;
+    static constexpr int buckets_words = buckets_count / 32;
+
+    // Max half dimension of a double size sprite:
+    static constexpr int viewport_margin = 64;
+
+    void insert(sprites_manager_item& item)
+    {
+        int camera_id = item.camera->id();
+        camera_data& camera = _cameras[camera_id];
+
+        if(! camera.items_count)
+        {
+            camera.position = _camera_position(camera_id);
+        }
+
+        ++camera.items_count;
+        item.camera_revision = camera.revision;
+        _link(item, _bucket(item.position));
+    }
+
+    void erase(sprites_manager_item& item)
+    {
+        _unlink(item);
+        --_cameras[item.camera->id()].items_count;
+    }
+
+    void update_position(sprites_manager_item& item)
+    {
+        int bucket = _bucket(item.position);
+
+        if(bucket != item.grid_bucket)
+        {
+            _unlink(item);
+            _link(item, bucket);
+        }
+    }
+
+    void refresh(sprites_manager_item& item) const
+    {
+        if(const camera_ptr* camera = item.camera.get())
+        {
+            unsigned revision = _cameras[camera->id()].revision;
+
+            if(item.camera_revision != revision)
+            {
+                item.camera_revision = revision;
+                item.update_hw_position();
+            }
+        }
+    }
+
+    template<typename Function>
+    void for_each_moved_camera_item(const Function& function)
+    {
+        for(int camera_id = 0; camera_id < BN_CFG_CAMERA_MAX_ITEMS; ++camera_id)
+        {
+            camera_data& camera = _cameras[camera_id];
+
+            if(camera.items_count)
+            {
+                point position = _camera_position(camera_id);
+
+                if(position != camera.position)
+                {
+                    unsigned buckets_mask[buckets_words] = {};
+                    _add_viewport_buckets(camera.position, buckets_mask);
+                    _add_viewport_buckets(position, buckets_mask);
+                    camera.position = position;
+
+                    unsigned revision = camera.revision + 1;
+                    camera.revision = revision;
+
+                    for(int word_index = 0; word_index < buckets_words; ++word_index)
+                    {
+                        unsigned word = buckets_mask[word_index];
+
+                        while(word)
+                        {
+                            int bit_index = __builtin_ctz(word);
+                            word &= word - 1;
+
+                            sprites_manager_item* item = _buckets[(word_index * 32) + bit_index];
+
+                            while(item)
+                            {
+                                if(item->camera->id() == camera_id)
+                                {
+                                    item->camera_revision = revision;
+                                    function(*item);
+                                }
+
+                                item = item->grid_next;
+                            }
+                        }
+                    }
+                }
+            }
+        }
+    }
+
+private:
+    class camera_data
+    {
+
+    public:
+        point position;
+        unsigned revision = 0;
+        int items_count = 0;
+    };
+
+    sprites_manager_item* _buckets[buckets_count] = {};
+    camera_data _cameras[BN_CFG_CAMERA_MAX_ITEMS];
+
+    [[nodiscard]] static point _camera_position(int camera_id)
+    {
+        const fixed_point& position = cameras_manager::position(camera_id);
+        return point(position.x().right_shift_integer(), position.y().right_shift_integer());
+    }
+
+    [[nodiscard]] static int _bucket(const fixed_point& position)
+    {
+        int column = (position.x().right_shift_integer() >> cell_shift) & (columns - 1);
+        int row = (position.y().right_shift_integer() >> cell_shift) & (columns - 1);
+        return (row << columns_shift) + column;
+    }
+
+    static void _add_viewport_buckets(const point& camera_position, unsigned* buckets_mask)
+    {
+        int first_x = camera_position.x() - (display::width() / 2) - viewport_margin;
+        int first_y = camera_position.y() - (display::height() / 2) - viewport_margin;
+        int first_column = first_x >> cell_shift;
+        int first_row = first_y >> cell_shift;
+        int last_column = (first_x + display::width() + (viewport_margin * 2)) >> cell_shift;
+        int last_row = (first_y + display::height() + (viewport_margin * 2)) >> cell_shift;
+        last_column = min(last_column, first_column + columns - 1);
+        last_row = min(last_row, first_row + columns - 1);
+
+        for(int row = first_row; row <= last_row; ++row)
+        {
+            int row_bucket = (row & (columns - 1)) << columns_shift;
+
+            for(int column = first_column; column <= last_column; ++column)
+            {
+                int bucket = row_bucket + (column & (columns - 1));
+                buckets_mask[bucket / 32] |= 1U << (bucket % 32);
+            }
+        }
+    }
+
+    void _link(sprites_manager_item& item, int bucket)
+    {
+        sprites_manager_item*& first_item = _buckets[bucket];
+        item.grid_prev = nullptr;
+        item.grid_next = first_item;
+
+        if(first_item)
+        {
+            first_item->grid_prev = &item;
+        }
+
+        first_item = &item;
+        item.grid_bucket = int16_t(bucket);
+    }
+
+    void _unlink(sprites_manager_item& item)
+    {
+        sprites_manager_item* prev = item.grid_prev;
+        sprites_manager_item* next = item.grid_next;
+
+        if(prev)
+        {
+            prev->grid_next = next;
+        }
+        else
+        {
+            _buckets[item.grid_bucket] = next;
+        }
+
+        if(next)
+        {
+            next->grid_prev = prev;
+        }
+    }
+};
+
+}
+
+#endif
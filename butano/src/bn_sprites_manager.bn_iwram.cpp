@@ -8,95 +8,131 @@
 #include "bn_sorted_sprites.h"
 #include "../hw/include/bn_hw_sprites_constants.h"
 
+#if BN_CFG_SPRITES_CULLING_GRID_ENABLED
+    #include "bn_sprites_culling_grid.h"
+#endif
+
 namespace bn::sprites_manager
 {
 
-void _check_items_on_screen(intrusive_list<sorted_sprites::layer>& layers)
+#if BN_CFG_SPRITES_CULLING_GRID_ENABLED
+    void _check_items_on_screen(sorted_sprites::sorter& sorter, sprites_culling_grid& culling_grid)
+#else
+    void _check_items_on_screen(sorted_sprites::sorter& sorter)
+#endif
 {
-    for(sorted_sprites::layer& layer : layers)
+    sorter.for_each([&](sprites_manager_item& item)
     {
-        for(sprites_manager_item& item : layer.items())
+        if(item.check_on_screen) [[likely]]
         {
-            if(item.check_on_screen) [[likely]]
+            #if BN_CFG_SPRITES_CULLING_GRID_ENABLED
+                culling_grid.refresh(item);
+            #endif
+
+            int x = item.hw_position.x();
+            bool on_screen = false;
+            item.check_on_screen = false;
+
+            if(x < display::width() && x + (item.half_width * 2) > 0)
             {
-                int x = item.hw_position.x();
-                bool on_screen = false;
-                item.check_on_screen = false;
+                int y = item.hw_position.y();
 
-                if(x < display::width() && x + (item.half_width * 2) > 0)
+                if(y < display::height() && y + (item.half_height * 2) > 0)
                 {
-                    int y = item.hw_position.y();
-
-                    if(y < display::height() && y + (item.half_height * 2) > 0)
-                    {
-                        on_screen = true;
-                    }
+                    on_screen = true;
                 }
+            }
 
-                if(item.on_screen != on_screen) [[unlikely]]
-                {
-                    item.on_screen = on_screen;
+            if(item.on_screen != on_screen) [[unlikely]]
+            {
+                item.on_screen = on_screen;
 
-                    if(on_screen)
+                if(on_screen)
+                {
+                    if(item.affine_mat)
                     {
-                        if(item.affine_mat)
-                        {
-                            hw::sprites::show_affine(item.double_size, item.handle);
-                        }
-                        else
-                        {
-                            hw::sprites::show_regular(item.handle);
-                        }
+                        hw::sprites::show_affine(item.double_size, item.handle);
                     }
                     else
                     {
-                        hw::sprites::hide(item.handle);
+                        hw::sprites::show_regular(item.handle);
                     }
                 }
+                else
+                {
+                    hw::sprites::hide(item.handle);
+                }
             }
         }
-    }
+    });
 }
 
-int _rebuild_handles_impl(int reserved_handles_count, void* hw_handles, intrusive_list<sorted_sprites::layer>& layers)
+int _rebuild_handles_impl(int reserved_handles_count, int max_handles_count, void* hw_handles,
+                          unsigned* handles_to_commit, sorted_sprites::sorter& sorter, bool& too_many_items)
 {
     auto handles = reinterpret_cast<hw::sprites::handle_type*>(hw_handles);
     int visible_items_count = reserved_handles_count;
+    too_many_items = false;
 
-    for(sorted_sprites::layer& layer : layers)
+    sorter.for_each([handles, max_handles_count, handles_to_commit, &visible_items_count, &too_many_items](
+                    sprites_manager_item& item)
     {
-        for(sprites_manager_item& item : layer.items())
+        if(item.on_screen)
         {
-            if(item.on_screen)
+            if(visible_items_count == max_handles_count) [[unlikely]]
             {
-                #if BN_CFG_ASSERT_ENABLED
-                    if(visible_items_count == hw::sprites::count()) [[unlikely]]
-                    {
-                        return -1;
-                    }
-                #endif
-
-                hw::sprites::copy_handle(item.handle, handles[visible_items_count]);
-                item.handles_index = int8_t(visible_items_count);
-                ++visible_items_count;
+                item.handles_index = -1;
+                too_many_items = true;
             }
             else
             {
-                item.handles_index = -1;
+                const hw::sprites::handle_type& item_handle = item.handle;
+                hw::sprites::handle_type& handle = handles[visible_items_count];
+
+                if(item_handle.attr0 != handle.attr0 || item_handle.attr1 != handle.attr1 ||
+                        item_handle.attr2 != handle.attr2)
+                {
+                    hw::sprites::copy_handle(item_handle, handle);
+                    handles_to_commit[visible_items_count / 32] |= 1U << (visible_items_count % 32);
+                }
+
+                item.handles_index = int8_t(visible_items_count);
+                ++visible_items_count;
             }
         }
-    }
+        else
+        {
+            item.handles_index = -1;
+        }
+    });
 
     return visible_items_count;
 }
 
-bool _update_cameras_impl(intrusive_list<sorted_sprites::layer>& layers)
-{
-    bool check_items_on_screen = false;
+#if BN_CFG_SPRITES_CULLING_GRID_ENABLED
+    bool _update_cameras_impl(sprites_culling_grid& culling_grid)
+    {
+        bool check_items_on_screen = false;
+
+        culling_grid.for_each_moved_camera_item([&check_items_on_screen](sprites_manager_item& item)
+        {
+            item.update_hw_position();
+
+            if(item.visible)
+            {
+                item.check_on_screen = true;
+                check_items_on_screen = true;
+            }
+        });
 
-    for(sorted_sprites::layer& layer : layers)
+        return check_items_on_screen;
+    }
+#else
+    bool _update_cameras_impl(sorted_sprites::sorter& sorter)
     {
-        for(sprites_manager_item& item : layer.items())
+        bool check_items_on_screen = false;
+
+        sorter.for_each([&check_items_on_screen](sprites_manager_item& item)
         {
             if(item.camera)
             {
@@ -108,10 +144,143 @@ bool _update_cameras_impl(intrusive_list<sorted_sprites::layer>& layers)
                     check_items_on_screen = true;
                 }
             }
+        });
+
+        return check_items_on_screen;
+    }
+#endif
+
+bool _set_positions_impl(const id_type* ids, const fixed_point* positions, int count, bool& sort_items_by_y)
+{
+    bool check_items_on_screen = false;
+    bool sort_by_y = false;
+
+    for(int index = 0; index < count; ++index)
+    {
+        auto item = static_cast<sprites_manager_item*>(ids[index]);
+        const fixed_point& position = positions[index];
+        fixed_point old_position = item->position;
+        item->position = position;
+
+        sort_by_y |= item->y_sort_enabled && position.y() != old_position.y();
+
+        int diff_x = position.x().right_shift_integer() - old_position.x().right_shift_integer();
+        int diff_y = position.y().right_shift_integer() - old_position.y().right_shift_integer();
+
+        if(diff_x || diff_y)
+        {
+            point new_hw_position(item->hw_position.x() + diff_x, item->hw_position.y() + diff_y);
+            item->hw_position = new_hw_position;
+
+            hw::sprites::handle_type& handle = item->handle;
+            hw::sprites::set_x(new_hw_position.x(), handle);
+            hw::sprites::set_y(new_hw_position.y(), handle);
+
+            if(item->visible)
+            {
+                item->check_on_screen = true;
+                check_items_on_screen = true;
+            }
         }
     }
 
+    sort_items_by_y = sort_by_y;
     return check_items_on_screen;
 }
 
+
+int _update_particles_impl(particles_update_data& update_data, void* hw_handles)
+{
+    auto handles = reinterpret_cast<hw::sprites::handle_type*>(hw_handles);
+    fixed* xs = update_data.xs;
+    fixed* ys = update_data.ys;
+    fixed* x_velocities = update_data.x_velocities;
+    fixed* y_velocities = update_data.y_velocities;
+    uint16_t* lifetimes = update_data.lifetimes;
+    uint8_t* graphics_indexes = update_data.graphics_indexes;
+    uint8_t* wait_counters = update_data.wait_counters;
+    const uint16_t* third_attributes = update_data.third_attributes;
+    int size = update_data.size;
+    int last_graphics_index = update_data.graphics_count - 1;
+    int wait_updates = update_data.wait_updates;
+    int gravity_x_data = update_data.gravity_x_data;
+    int gravity_y_data = update_data.gravity_y_data;
+    int width = update_data.width;
+    int height = update_data.height;
+    int half_width = width / 2;
+    int half_height = height / 2;
+    unsigned first_attributes = update_data.first_attributes;
+    unsigned second_attributes = update_data.second_attributes;
+    int index = 0;
+
+    while(index < size)
+    {
+        int lifetime = lifetimes[index] - 1;
+
+        if(lifetime <= 0) [[unlikely]]
+        {
+            --size;
+            xs[index] = xs[size];
+            ys[index] = ys[size];
+            x_velocities[index] = x_velocities[size];
+            y_velocities[index] = y_velocities[size];
+            lifetimes[index] = lifetimes[size];
+            graphics_indexes[index] = graphics_indexes[size];
+            wait_counters[index] = wait_counters[size];
+            continue;
+        }
+
+        lifetimes[index] = uint16_t(lifetime);
+
+        fixed x_velocity = fixed::from_data(x_velocities[index].data() + gravity_x_data);
+        fixed y_velocity = fixed::from_data(y_velocities[index].data() + gravity_y_data);
+        x_velocities[index] = x_velocity;
+        y_velocities[index] = y_velocity;
+
+        fixed x = xs[index] + x_velocity;
+        fixed y = ys[index] + y_velocity;
+        xs[index] = x;
+        ys[index] = y;
+
+        int graphics_index = graphics_indexes[index];
+
+        if(wait_updates)
+        {
+            int wait_counter = wait_counters[index] + 1;
+
+            if(wait_counter >= wait_updates)
+            {
+                wait_counter = 0;
+
+                if(graphics_index < last_graphics_index)
+                {
+                    ++graphics_index;
+                    graphics_indexes[index] = uint8_t(graphics_index);
+                }
+            }
+
+            wait_counters[index] = uint8_t(wait_counter);
+        }
+
+        hw::sprites::handle_type& handle = handles[index];
+        int hw_x = x.right_shift_integer() - half_width;
+        int hw_y = y.right_shift_integer() - half_height;
+
+        if(hw_x < display::width() && hw_x + width > 0 && hw_y < display::height() && hw_y + height > 0)
+        {
+            handle.attr0 = uint16_t(first_attributes | (hw_y & 255));
+            handle.attr1 = uint16_t(second_attributes | (hw_x & 511));
+            handle.attr2 = third_attributes[graphics_index];
+        }
+        else
+        {
+            hw::sprites::hide_and_destroy(handle.attr0);
+        }
+
+        ++index;
+    }
+
+    return size;
+}
+
 }
@@ -11,10 +11,19 @@
 #include "bn_sorted_sprites.h"
 #include "../hw/include/bn_hw_sprite_affine_mats_constants.h"
 
+#if BN_CFG_SPRITES_MULTIPLEXER_HANDLES
+    #include "bn_sprites_multiplexer.h"
+#endif
+
+#if BN_CFG_SPRITES_CULLING_GRID_ENABLED
+    #include "bn_sprites_culling_grid.h"
+#endif
+
 #include "bn_sprites.cpp.h"
 #include "bn_sprite_ptr.cpp.h"
 #include "bn_sprite_item.cpp.h"
 #include "bn_sprite_builder.cpp.h"
+#include "bn_particle_system.cpp.h"
 #include "bn_sprite_third_attributes.cpp.h"
 #include "bn_sprite_affine_second_attributes.cpp.h"
 
@@ -28,6 +37,17 @@ namespace
     using item_type = sprites_manager_item;
     using sorted_items_type = vector<item_type*, BN_CFG_SPRITES_MAX_ITEMS>;
 
+    #if BN_CFG_SPRITES_MULTIPLEXER_HANDLES
+        constexpr int max_handles_count = sprites_multiplexer::first_handle_index;
+    #else
+        constexpr int max_handles_count = hw::sprites::count();
+    #endif
+
+    constexpr int handles_to_commit_words = hw::sprites::count() / 32;
+
+    // Copying a few unmodified handles is faster than starting a new copy:
+    constexpr int max_handles_to_commit_gap = 2;
+
     class static_data
     {
 
@@ -35,34 +55,129 @@ namespace
         pool<item_type, BN_CFG_SPRITES_MAX_ITEMS> items_pool;
         hw::sprites::handle_type handles[hw::sprites::count()];
         sorted_sprites::sorter sorter;
+
+        #if BN_CFG_SPRITES_MULTIPLEXER_HANDLES
+            sprites_multiplexer multiplexer;
+        #endif
+
+        #if BN_CFG_SPRITES_CULLING_GRID_ENABLED
+            sprites_culling_grid culling_grid;
+        #endif
+
+        unsigned handles_to_commit[handles_to_commit_words] = {};
+        unsigned particle_handles[handles_to_commit_words] = {};
         int reserved_handles_count = 0;
-        int first_index_to_commit = 0;
-        int last_index_to_commit = hw::sprites::count() - 1;
+        int particle_handles_end = 0;
         int last_visible_items_count = 0;
+        int last_committed_bytes = 0;
         bool check_items_on_screen = false;
+        bool sort_items_by_y = false;
         bool rebuild_handles = false;
         bool reload_all_handles = false;
+        bool commit_all_rebuilt_handles = false;
     };
 
     BN_DATA_EWRAM_BSS static_data data;
 
-    void _always_update_indexes_to_commit(const item_type& item)
+    void _set_handles_to_commit(int first_index, int count)
     {
-        int handles_index = item.handles_index;
+        unsigned* handles_to_commit = data.handles_to_commit;
+        int last_index = first_index + count;
 
-        if(handles_index >= 0)
+        for(int index = first_index; index < last_index; ++index)
         {
-            hw::sprites::copy_handle(item.handle, data.handles[handles_index]);
+            handles_to_commit[index / 32] |= 1U << (index % 32);
+        }
+    }
 
-            if(handles_index < data.first_index_to_commit)
+    [[nodiscard]] int _first_item_handle_index()
+    {
+        return max(data.reserved_handles_count, data.particle_handles_end);
+    }
+
+    [[nodiscard]] bool _particle_handle_reserved(int index)
+    {
+        return data.particle_handles[index / 32] & (1U << (index % 32));
+    }
+
+    void _set_particle_handles_reserved(int first_index, int count, bool reserved)
+    {
+        unsigned* particle_handles = data.particle_handles;
+        hw::sprites::handle_type* handles = data.handles;
+        int last_index = first_index + count;
+
+        for(int index = first_index; index < last_index; ++index)
+        {
+            if(reserved)
             {
-                data.first_index_to_commit = handles_index;
+                particle_handles[index / 32] |= 1U << (index % 32);
             }
+            else
+            {
+                particle_handles[index / 32] &= ~(1U << (index % 32));
+            }
+
+            hw::sprites::hide_and_destroy(handles[index]);
+        }
 
-            if(handles_index > data.last_index_to_commit)
+        _set_handles_to_commit(first_index, count);
+    }
+
+    void _set_particle_handles_end(int particle_handles_end)
+    {
+        int old_first_item_handle_index = _first_item_handle_index();
+        data.particle_handles_end = particle_handles_end;
+
+        if(_first_item_handle_index() != old_first_item_handle_index)
+        {
+            data.sorter.for_each([](item_type& item)
+            {
+                item.handles_index = -1;
+            });
+
+            data.rebuild_handles = true;
+            data.commit_all_rebuilt_handles = true;
+        }
+    }
+
+    void _culling_grid_insert([[maybe_unused]] item_type& item)
+    {
+        #if BN_CFG_SPRITES_CULLING_GRID_ENABLED
+            if(item.camera)
+            {
+                data.culling_grid.insert(item);
+            }
+        #endif
+    }
+
+    void _culling_grid_erase([[maybe_unused]] item_type& item)
+    {
+        #if BN_CFG_SPRITES_CULLING_GRID_ENABLED
+            if(item.camera)
+            {
+                data.culling_grid.erase(item);
+            }
+        #endif
+    }
+
+    void _culling_grid_update_position([[maybe_unused]] item_type& item)
+    {
+        #if BN_CFG_SPRITES_CULLING_GRID_ENABLED
+            if(item.camera)
             {
-                data.last_index_to_commit = handles_index;
+                data.culling_grid.update_position(item);
             }
+        #endif
+    }
+
+    void _always_update_indexes_to_commit(const item_type& item)
+    {
+        int handles_index = item.handles_index;
+
+        if(handles_index >= 0)
+        {
+            hw::sprites::copy_handle(item.handle, data.handles[handles_index]);
+            data.handles_to_commit[handles_index / 32] |= 1U << (handles_index % 32);
         }
     }
 
@@ -168,12 +283,41 @@ namespace
         }
     }
 
+    #if BN_CFG_SPRITES_MULTIPLEXER_HANDLES
+        void _rebuild_multiplexer(bool too_many_items)
+        {
+            sprites_multiplexer& multiplexer = data.multiplexer;
+            multiplexer.clear();
+
+            if(too_many_items)
+            {
+                data.sorter.for_each([&multiplexer](item_type& item)
+                {
+                    if(item.on_screen && item.handles_index < 0)
+                    {
+                        [[maybe_unused]] bool added = multiplexer.add(item);
+                        BN_BASIC_ASSERT(added, "Too many on screen sprites");
+                    }
+                });
+            }
+        }
+
+        void _update_multiplexer()
+        {
+            if(data.multiplexer.update(data.handles))
+            {
+                _set_handles_to_commit(sprites_multiplexer::first_handle_index, sprites_multiplexer::handles_count);
+            }
+        }
+    #endif
+
     void _rebuild_handles()
     {
         if(data.rebuild_handles)
         {
             hw::sprites::handle_type* handles = data.handles;
             int reserved_count = data.reserved_handles_count;
+            int first_item_index = _first_item_handle_index();
             bool reload_all_handles = data.reload_all_handles;
 
             if(reload_all_handles) [[unlikely]]
@@ -186,8 +330,16 @@ namespace
                 }
             }
 
-            int visible_items_count = _rebuild_handles_impl(reserved_count, handles, data.sorter.layers());
-            BN_BASIC_ASSERT(visible_items_count >= 0, "Too many on screen sprites");
+            bool too_many_items;
+            int visible_items_count = _rebuild_handles_impl(
+                        first_item_index, max_handles_count, handles, data.handles_to_commit, data.sorter,
+                        too_many_items);
+
+            #if BN_CFG_SPRITES_MULTIPLEXER_HANDLES
+                _rebuild_multiplexer(too_many_items);
+            #else
+                BN_BASIC_ASSERT(! too_many_items, "Too many on screen sprites");
+            #endif
 
             int last_visible_items_count = data.last_visible_items_count;
             data.rebuild_handles = false;
@@ -195,37 +347,26 @@ namespace
 
             for(int index = visible_items_count; index < last_visible_items_count; ++index)
             {
-                hw::sprites::hide_and_destroy(handles[index]);
+                hw::sprites::handle_type& handle = handles[index];
+                unsigned old_attr0 = handle.attr0;
+                hw::sprites::hide_and_destroy(handle);
+
+                if(handle.attr0 != old_attr0)
+                {
+                    data.handles_to_commit[index / 32] |= 1U << (index % 32);
+                }
             }
 
             if(reload_all_handles) [[unlikely]]
             {
-                data.first_index_to_commit = 0;
-                data.last_index_to_commit = hw::sprites::count() - 1;
+                data.commit_all_rebuilt_handles = false;
+                _set_handles_to_commit(0, hw::sprites::count());
             }
-            else
+            else if(data.commit_all_rebuilt_handles) [[unlikely]]
             {
-                int to_commit_items_count;
-
-                if(visible_items_count < last_visible_items_count)
-                {
-                    to_commit_items_count = min(last_visible_items_count, hw::sprites::count() - reserved_count);
-                }
-                else
-                {
-                    to_commit_items_count = visible_items_count;
-                }
-
-                if(to_commit_items_count)
-                {
-                    data.first_index_to_commit = reserved_count;
-                    data.last_index_to_commit = reserved_count + to_commit_items_count - 1;
-                }
-                else
-                {
-                    data.first_index_to_commit = hw::sprites::count();
-                    data.last_index_to_commit = 0;
-                }
+                data.commit_all_rebuilt_handles = false;
+                int rebuilt_handles_count = max(visible_items_count, last_visible_items_count) - first_item_index;
+                _set_handles_to_commit(first_item_index, rebuilt_handles_count);
             }
         }
     }
@@ -240,6 +381,8 @@ void init()
         hw::sprites::hide_and_destroy(handle);
     }
 
+    _set_handles_to_commit(0, hw::sprites::count());
+
     sprite_affine_mats_manager::init(data.handles);
 }
 
@@ -286,6 +429,7 @@ id_type create(sprite_builder&& builder)
 
     item_type& new_item = data.items_pool.create(move(builder));
     data.sorter.insert(new_item);
+    _culling_grid_insert(new_item);
 
     if(new_item.visible)
     {
@@ -321,6 +465,7 @@ id_type create_optional(sprite_builder&& builder)
 
     item_type& new_item = data.items_pool.create(move(builder), move(*tiles_ptr), move(*palette_ptr));
     data.sorter.insert(new_item);
+    _culling_grid_insert(new_item);
 
     if(new_item.visible)
     {
@@ -331,6 +476,32 @@ id_type create_optional(sprite_builder&& builder)
     return &new_item;
 }
 
+void create_many(const fixed_point* positions, int count, const sprite_shape_size& shape_size,
+                 const sprite_tiles_ptr& tiles, const sprite_palette_ptr& palette, id_type* output_ids)
+{
+    BN_ASSERT(count >= 0, "Invalid count: ", count);
+    BN_BASIC_ASSERT(count <= available_items_count(), "No more sprite items available");
+
+    if(! count)
+    {
+        return;
+    }
+
+    for(int index = 0; index < count; ++index)
+    {
+        item_type& new_item = data.items_pool.create(positions[index], shape_size, sprite_tiles_ptr(tiles),
+                                                     sprite_palette_ptr(palette));
+        output_ids[index] = &new_item;
+    }
+
+    data.sorter.insert_many(count, [output_ids](int index) -> item_type& {
+        return *static_cast<item_type*>(output_ids[index]);
+    });
+
+    data.check_items_on_screen = true;
+    data.rebuild_handles = true;
+}
+
 void increase_usages(id_type id)
 {
     auto item = static_cast<item_type*>(id);
@@ -345,6 +516,7 @@ void decrease_usages(id_type id)
     if(! item->usages) [[likely]]
     {
         data.sorter.erase(*item);
+        _culling_grid_erase(*item);
 
         if(const sprite_affine_mat_ptr* item_affine_mat = item->affine_mat.get())
         {
@@ -576,7 +748,12 @@ const fixed_point& position(id_type id)
 
 const point& hw_position(id_type id)
 {
-    auto item = static_cast<const item_type*>(id);
+    auto item = static_cast<item_type*>(id);
+
+    #if BN_CFG_SPRITES_CULLING_GRID_ENABLED
+        data.culling_grid.refresh(*item);
+    #endif
+
     return item->hw_position;
 }
 
@@ -595,6 +772,7 @@ void set_x(id_type id, fixed x)
         int hw_x = item->hw_position.x() + diff;
         item->hw_position.set_x(hw_x);
         hw::sprites::set_x(hw_x, item->handle);
+        _culling_grid_update_position(*item);
 
         if(item->visible)
         {
@@ -611,6 +789,11 @@ void set_y(id_type id, fixed y)
     fixed old_y = item->position.y();
     item->position.set_y(y);
 
+    if(item->y_sort_enabled && y != old_y)
+    {
+        data.sort_items_by_y = true;
+    }
+
     int old_integer_y = old_y.right_shift_integer();
     int new_integer_y = y.right_shift_integer();
     int diff = new_integer_y - old_integer_y;
@@ -620,6 +803,7 @@ void set_y(id_type id, fixed y)
         int hw_y = item->hw_position.y() + diff;
         item->hw_position.set_y(hw_y);
         hw::sprites::set_y(hw_y, item->handle);
+        _culling_grid_update_position(*item);
 
         if(item->visible)
         {
@@ -636,6 +820,11 @@ void set_position(id_type id, const fixed_point& position)
     fixed_point old_position = item->position;
     item->position = position;
 
+    if(item->y_sort_enabled && position.y() != old_position.y())
+    {
+        data.sort_items_by_y = true;
+    }
+
     point old_integer_position(old_position.x().right_shift_integer(), old_position.y().right_shift_integer());
     point new_integer_position(position.x().right_shift_integer(), position.y().right_shift_integer());
     point diff = new_integer_position - old_integer_position;
@@ -648,6 +837,7 @@ void set_position(id_type id, const fixed_point& position)
         hw::sprites::handle_type& handle = item->handle;
         hw::sprites::set_x(new_hw_position.x(), handle);
         hw::sprites::set_y(new_hw_position.y(), handle);
+        _culling_grid_update_position(*item);
 
         if(item->visible)
         {
@@ -658,6 +848,28 @@ void set_position(id_type id, const fixed_point& position)
     }
 }
 
+void set_positions(const id_type* ids, const fixed_point* positions, int count)
+{
+    BN_ASSERT(count >= 0, "Invalid count: ", count);
+
+    bool sort_items_by_y = false;
+
+    if(_set_positions_impl(ids, positions, count, sort_items_by_y))
+    {
+        data.check_items_on_screen = true;
+        data.rebuild_handles = true;
+    }
+
+    #if BN_CFG_SPRITES_CULLING_GRID_ENABLED
+        for(int index = 0; index < count; ++index)
+        {
+            _culling_grid_update_position(*static_cast<item_type*>(ids[index]));
+        }
+    #endif
+
+    data.sort_items_by_y |= sort_items_by_y;
+}
+
 int bg_priority(id_type id)
 {
     auto item = static_cast<const item_type*>(id);
@@ -677,6 +889,7 @@ void set_bg_priority(id_type id, int bg_priority)
         data.sorter.erase(*item);
         item->set_bg_priority(bg_priority);
         data.sorter.insert(*item);
+        data.sort_items_by_y |= item->y_sort_enabled;
         data.rebuild_handles = true;
     }
 }
@@ -699,6 +912,7 @@ void set_z_order(id_type id, int z_order)
         data.sorter.erase(*item);
         item->set_z_order(z_order);
         data.sorter.insert(*item);
+        data.sort_items_by_y |= item->y_sort_enabled;
         data.rebuild_handles = true;
     }
 }
@@ -723,6 +937,23 @@ void put_below(id_type id)
     }
 }
 
+bool y_sort_enabled(id_type id)
+{
+    auto item = static_cast<const item_type*>(id);
+    return item->y_sort_enabled;
+}
+
+void set_y_sort_enabled(id_type id, bool y_sort_enabled)
+{
+    auto item = static_cast<item_type*>(id);
+    item->y_sort_enabled = y_sort_enabled;
+
+    if(y_sort_enabled)
+    {
+        data.sort_items_by_y = true;
+    }
+}
+
 bool horizontal_flip(id_type id)
 {
     auto item = static_cast<const item_type*>(id);
@@ -934,8 +1165,10 @@ void set_camera(id_type id, camera_ptr&& camera)
 
     if(camera != item->camera)
     {
+        _culling_grid_erase(*item);
         item->camera = move(camera);
         item->update_hw_position();
+        _culling_grid_insert(*item);
 
         if(item->visible)
         {
@@ -952,6 +1185,7 @@ void remove_camera(id_type id)
 
     if(item->camera)
     {
+        _culling_grid_erase(*item);
         item->camera.reset();
         item->update_hw_position();
 
@@ -1099,20 +1333,19 @@ void set_reserved_handles_count(int reserved_handles_count)
 
     if(reserved_handles_count != old_reserved_handles_count)
     {
-        BN_ASSERT(reserved_handles_count >= 0 && reserved_handles_count < hw::sprites::count(),
+        BN_BASIC_ASSERT(! data.particle_handles_end, "Reserved handles can't change while particle systems exist");
+
+        BN_ASSERT(reserved_handles_count >= 0 && reserved_handles_count < max_handles_count,
                   "Invalid reserved handles count: ", reserved_handles_count);
 
         if(reserved_handles_count > old_reserved_handles_count)
         {
             sprite_affine_mats_manager::reserve_sprite_handles(reserved_handles_count);
 
-            for(sorted_sprites::layer& layer : data.sorter.layers())
+            data.sorter.for_each([](item_type& item)
             {
-                for(item_type& item : layer.items())
-                {
-                    item.handles_index = -1;
-                }
-            }
+                item.handles_index = -1;
+            });
         }
 
         data.reserved_handles_count = reserved_handles_count;
@@ -1120,10 +1353,104 @@ void set_reserved_handles_count(int reserved_handles_count)
     }
 }
 
+int reserve_particle_handles(int count)
+{
+    BN_ASSERT(count > 0, "Invalid count: ", count);
+
+    int first_index = data.reserved_handles_count;
+    int particle_handles_end = data.particle_handles_end;
+    int free_count = 0;
+
+    for(int index = first_index; index < particle_handles_end && free_count < count; ++index)
+    {
+        if(_particle_handle_reserved(index))
+        {
+            first_index = index + 1;
+            free_count = 0;
+        }
+        else
+        {
+            ++free_count;
+        }
+    }
+
+    int last_index = first_index + count;
+    BN_BASIC_ASSERT(last_index < max_handles_count, "No more particle handles available: ", count);
+
+    _set_particle_handles_reserved(first_index, count, true);
+
+    if(last_index > particle_handles_end)
+    {
+        _set_particle_handles_end(last_index);
+    }
+
+    return first_index;
+}
+
+void release_particle_handles(int first_index, int count)
+{
+    _set_particle_handles_reserved(first_index, count, false);
+
+    int particle_handles_end = data.particle_handles_end;
+    int reserved_handles_count = data.reserved_handles_count;
+
+    while(particle_handles_end > reserved_handles_count && ! _particle_handle_reserved(particle_handles_end - 1))
+    {
+        --particle_handles_end;
+    }
+
+    if(particle_handles_end == reserved_handles_count)
+    {
+        particle_handles_end = 0;
+    }
+
+    _set_particle_handles_end(particle_handles_end);
+}
+
+int update_particle_handles(int first_index, int written_count, particles_update_data& update_data)
+{
+    hw::sprites::handle_type* handles = data.handles + first_index;
+    int result = _update_particles_impl(update_data, handles);
+
+    for(int index = result; index < written_count; ++index)
+    {
+        hw::sprites::hide_and_destroy(handles[index]);
+    }
+
+    _set_handles_to_commit(first_index, max(result, written_count));
+    return result;
+}
+
+int last_committed_bytes()
+{
+    return data.last_committed_bytes;
+}
+
+int multiplexed_items_count([[maybe_unused]] int band)
+{
+    BN_ASSERT(band >= 0 && band < BN_CFG_SPRITES_MULTIPLEXER_BANDS, "Invalid band: ", band);
+
+    #if BN_CFG_SPRITES_MULTIPLEXER_HANDLES
+        return data.multiplexer.band_items_count(band);
+    #else
+        return 0;
+    #endif
+}
+
 void reload(id_type id)
 {
     auto item = static_cast<item_type*>(id);
-    _update_indexes_to_commit(*item);
+
+    if(data.rebuild_handles)
+    {
+        // Rebuilt handles are committed only if they have changed,
+        // so the reloaded one would be ignored:
+        data.commit_all_rebuilt_handles = true;
+    }
+    else
+    {
+        _always_update_indexes_to_commit(*item);
+    }
 }
 
 void reload_blending()
@@ -1132,24 +1459,18 @@ void reload_blending()
 
     if(data.rebuild_handles)
     {
-        for(sorted_sprites::layer& layer : data.sorter.layers())
+        data.sorter.for_each([fade_enabled](item_type& item)
         {
-            for(item_type& item : layer.items())
-            {
-                hw::sprites::set_blending_enabled(item.blending_enabled, fade_enabled, item.handle);
-            }
-        }
+            hw::sprites::set_blending_enabled(item.blending_enabled, fade_enabled, item.handle);
+        });
     }
     else
     {
-        for(sorted_sprites::layer& layer : data.sorter.layers())
+        data.sorter.for_each([fade_enabled](item_type& item)
         {
-            for(item_type& item : layer.items())
-            {
-                hw::sprites::set_blending_enabled(item.blending_enabled, fade_enabled, item.handle);
-                _always_update_indexes_to_commit(item);
-            }
-        }
+            hw::sprites::set_blending_enabled(item.blending_enabled, fade_enabled, item.handle);
+            _always_update_indexes_to_commit(item);
+        });
     }
 }
 
@@ -1324,7 +1645,13 @@ void fill_hblank_effect_third_attributes([[maybe_unused]] sprite_shape_size shap
 
 void update_cameras()
 {
-    if(_update_cameras_impl(data.sorter.layers()))
+    #if BN_CFG_SPRITES_CULLING_GRID_ENABLED
+        bool check_items_on_screen = _update_cameras_impl(data.culling_grid);
+    #else
+        bool check_items_on_screen = _update_cameras_impl(data.sorter);
+    #endif
+
+    if(check_items_on_screen)
     {
         data.check_items_on_screen = true;
         data.rebuild_handles = true;
@@ -1349,42 +1676,127 @@ void update_auto_double_size(id_type id)
     _update_item_dimensions(*item);
 }
 
+#if BN_CFG_SPRITE_TILES_DEFRAG_MAX_TILES
+    void relocate_tiles(int source_tile, int destination_tile, int tiles_count)
+    {
+        int last_source_tile = source_tile + tiles_count;
+        int offset = source_tile - destination_tile;
+
+        auto relocate_handle = [=](hw::sprites::handle_type& handle)
+        {
+            int tiles_id = hw::sprites::tiles_id(handle);
+
+            if(tiles_id >= source_tile && tiles_id < last_source_tile)
+            {
+                hw::sprites::set_tiles(tiles_id - offset, handle);
+                return true;
+            }
+
+            return false;
+        };
+
+        data.sorter.for_each([&relocate_handle](item_type& item)
+        {
+            if(relocate_handle(item.handle) && item.on_screen)
+            {
+                data.rebuild_handles = true;
+            }
+        });
+
+        // Reserved and particle handles are not rebuilt from sprite items:
+        for(int index = 0, limit = _first_item_handle_index(); index < limit; ++index)
+        {
+            if(relocate_handle(data.handles[index]))
+            {
+                data.handles_to_commit[index / 32] |= 1U << (index % 32);
+            }
+        }
+    }
+#endif
+
 void update()
 {
     sprite_affine_mats_manager::update();
 
+    if(data.sort_items_by_y)
+    {
+        data.sort_items_by_y = false;
+
+        if(data.sorter.sort_by_y())
+        {
+            data.rebuild_handles = true;
+        }
+    }
+
     if(data.check_items_on_screen)
     {
         data.check_items_on_screen = false;
-        _check_items_on_screen(data.sorter.layers());
+        #if BN_CFG_SPRITES_CULLING_GRID_ENABLED
+            _check_items_on_screen(data.sorter, data.culling_grid);
+        #else
+            _check_items_on_screen(data.sorter);
+        #endif
     }
 
     _rebuild_handles();
+
+    #if BN_CFG_SPRITES_MULTIPLEXER_HANDLES
+        _update_multiplexer();
+    #endif
 }
 
 void commit(bool use_dma)
 {
     sprite_affine_mats_manager::commit_data affine_mats_commit_data =
             sprite_affine_mats_manager::retrieve_commit_data();
-    int first_index_to_commit = data.first_index_to_commit;
-    int last_index_to_commit = data.last_index_to_commit;
 
     if(int count = affine_mats_commit_data.count)
     {
         int multiplier = hw::sprites::count() / hw::sprite_affine_mats::count();
-        int first_mat_index_to_commit = affine_mats_commit_data.offset * multiplier;
-        int last_mat_index_to_commit = first_mat_index_to_commit + (count * multiplier) - 1;
-        first_index_to_commit = min(first_index_to_commit, first_mat_index_to_commit);
-        last_index_to_commit = max(last_index_to_commit, last_mat_index_to_commit);
+        _set_handles_to_commit(affine_mats_commit_data.offset * multiplier, count * multiplier);
+    }
+
+    unsigned* handles_to_commit = data.handles_to_commit;
+    int committed_handles_count = 0;
+    int first_index_to_commit = -1;
+    int last_index_to_commit = -1;
+
+    for(int words_index = 0; words_index < handles_to_commit_words; ++words_index)
+    {
+        if(unsigned word = handles_to_commit[words_index])
+        {
+            handles_to_commit[words_index] = 0;
+
+            for(int index = words_index * 32; word; word >>= 1, ++index)
+            {
+                if(word & 1)
+                {
+                    if(first_index_to_commit < 0)
+                    {
+                        first_index_to_commit = index;
+                    }
+                    else if(index - last_index_to_commit > max_handles_to_commit_gap + 1)
+                    {
+                        int commit_items_count = last_index_to_commit - first_index_to_commit + 1;
+                        hw::sprites::commit(data.handles[0], first_index_to_commit, commit_items_count, use_dma);
+                        committed_handles_count += commit_items_count;
+                        first_index_to_commit = index;
+                    }
+
+                    last_index_to_commit = index;
+                }
+            }
+        }
     }
 
-    if(first_index_to_commit < hw::sprites::count())
+    if(first_index_to_commit >= 0)
     {
         int commit_items_count = last_index_to_commit - first_index_to_commit + 1;
         hw::sprites::commit(data.handles[0], first_index_to_commit, commit_items_count, use_dma);
-        data.first_index_to_commit = hw::sprites::count();
-        data.last_index_to_commit = 0;
+        committed_handles_count += commit_items_count;
     }
+
+    data.last_committed_bytes = committed_handles_count * int(sizeof(hw::sprites::handle_type));
 }
 
 }
@@ -8,8 +8,9 @@
 
 #include "bn_fixed_fwd.h"
 #include "bn_optional_fwd.h"
+#include "bn_config_sprites.h"
 #include "bn_fixed_point_fwd.h"
-#include "bn_intrusive_list_fwd.h"
+#include "bn_config_sprite_tiles.h"
 
 namespace bn
 {
@@ -34,13 +35,38 @@ enum class sprite_double_size_mode : uint8_t;
 
 namespace sorted_sprites
 {
-    class layer;
+    class sorter;
 }
 
+class sprites_culling_grid;
+
 namespace sprites_manager
 {
     using id_type = void*;
 
+    class particles_update_data
+    {
+
+    public:
+        fixed* xs;
+        fixed* ys;
+        fixed* x_velocities;
+        fixed* y_velocities;
+        uint16_t* lifetimes;
+        uint8_t* graphics_indexes;
+        uint8_t* wait_counters;
+        const uint16_t* third_attributes;
+        int size;
+        int graphics_count;
+        int wait_updates;
+        int gravity_x_data;
+        int gravity_y_data;
+        int width;
+        int height;
+        unsigned first_attributes;
+        unsigned second_attributes;
+    };
+
     void init();
 
     [[nodiscard]] int used_items_count();
@@ -57,6 +83,9 @@ namespace sprites_manager
 
     [[nodiscard]] id_type create_optional(sprite_builder&& builder);
 
+    void create_many(const fixed_point* positions, int count, const sprite_shape_size& shape_size,
+                     const sprite_tiles_ptr& tiles, const sprite_palette_ptr& palette, id_type* output_ids);
+
     void increase_usages(id_type id);
 
     void decrease_usages(id_type id);
@@ -104,6 +133,8 @@ namespace sprites_manager
 
     void set_position(id_type id, const fixed_point& position);
 
+    void set_positions(const id_type* ids, const fixed_point* positions, int count);
+
     [[nodiscard]] int bg_priority(id_type id);
 
     void set_bg_priority(id_type id, int bg_priority);
@@ -116,6 +147,10 @@ namespace sprites_manager
 
     void put_below(id_type id);
 
+    [[nodiscard]] bool y_sort_enabled(id_type id);
+
+    void set_y_sort_enabled(id_type id, bool y_sort_enabled);
+
     [[nodiscard]] bool horizontal_flip(id_type id);
 
     void set_horizontal_flip(id_type id, bool horizontal_flip);
@@ -188,6 +223,16 @@ namespace sprites_manager
 
     void set_reserved_handles_count(int reserved_handles_count);
 
+    [[nodiscard]] int reserve_particle_handles(int count);
+
+    void release_particle_handles(int first_index, int count);
+
+    [[nodiscard]] int update_particle_handles(int first_index, int written_count, particles_update_data& update_data);
+
+    [[nodiscard]] int last_committed_bytes();
+
+    [[nodiscard]] int multiplexed_items_count(int band);
+
     void reload(id_type id);
 
     void reload_blending();
@@ -218,16 +263,34 @@ namespace sprites_manager
 
     void update_auto_double_size(id_type id);
 
+    #if BN_CFG_SPRITE_TILES_DEFRAG_MAX_TILES
+        void relocate_tiles(int source_tile, int destination_tile, int tiles_count);
+    #endif
+
     void update();
 
     void commit(bool use_dma);
 
-    BN_CODE_IWRAM void _check_items_on_screen(intrusive_list<sorted_sprites::layer>& layers);
+    #if BN_CFG_SPRITES_CULLING_GRID_ENABLED
+        BN_CODE_IWRAM void _check_items_on_screen(sorted_sprites::sorter& sorter, sprites_culling_grid& culling_grid);
+    #else
+        BN_CODE_IWRAM void _check_items_on_screen(sorted_sprites::sorter& sorter);
+    #endif
 
     [[nodiscard]] BN_CODE_IWRAM int _rebuild_handles_impl(
-            int reserved_handles_count, void* hw_handles, intrusive_list<sorted_sprites::layer>& layers);
+            int reserved_handles_count, int max_handles_count, void* hw_handles, unsigned* handles_to_commit,
+            sorted_sprites::sorter& sorter, bool& too_many_items);
+
+    #if BN_CFG_SPRITES_CULLING_GRID_ENABLED
+        [[nodiscard]] BN_CODE_IWRAM bool _update_cameras_impl(sprites_culling_grid& culling_grid);
+    #else
+        [[nodiscard]] BN_CODE_IWRAM bool _update_cameras_impl(sorted_sprites::sorter& sorter);
+    #endif
+
+    [[nodiscard]] BN_CODE_IWRAM int _update_particles_impl(particles_update_data& update_data, void* hw_handles);
 
-    [[nodiscard]] BN_CODE_IWRAM bool _update_cameras_impl(intrusive_list<sorted_sprites::layer>& layers);
+    [[nodiscard]] BN_CODE_IWRAM bool _set_positions_impl(const id_type* ids, const fixed_point* positions, int count,
+                                                         bool& sort_items_by_y);
 }
 
 }
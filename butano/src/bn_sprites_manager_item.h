@@ -9,6 +9,7 @@
 #include "bn_display.h"
 #include "bn_sort_key.h"
 #include "bn_camera_ptr.h"
+#include "bn_config_sprites.h"
 #include "bn_intrusive_list.h"
 #include "bn_display_manager.h"
 #include "bn_sprites_manager.h"
@@ -47,7 +48,17 @@ public:
     optional<sprite_palette_ptr> palette;
     optional<sprite_affine_mat_ptr> affine_mat;
     optional<camera_ptr> camera;
-    int16_t sort_layer_ptr_diff;
+    #if BN_CFG_SPRITES_CULLING_GRID_ENABLED
+        sprites_manager_item* grid_prev = nullptr;
+        sprites_manager_item* grid_next = nullptr;
+        unsigned camera_revision = 0;
+        int16_t grid_bucket = -1;
+    #endif
+    #if BN_CFG_SPRITES_SORTER == BN_SPRITES_SORTER_LAYERS
+        int16_t sort_layer_ptr_diff;
+    #else
+        int16_t sort_index;
+    #endif
     int8_t handles_index = -1;
     int8_t half_width;
     int8_t half_height;
@@ -58,6 +69,7 @@ public:
     bool remove_affine_mat_when_not_needed: 1;
     bool on_screen: 1;
     bool check_on_screen: 1;
+    bool y_sort_enabled: 1;
 
     [[nodiscard]] static sprites_manager_item& affine_mat_attach_node_item(
             sprite_affine_mat_attach_node_type& attach_node)
@@ -81,7 +93,8 @@ public:
         visible(true),
         remove_affine_mat_when_not_needed(true),
         on_screen(false),
-        check_on_screen(true)
+        check_on_screen(true),
+        y_sort_enabled(false)
     {
         const sprite_palette_ptr& palette_ref = *palette;
         hw::sprites::setup_regular(shape_size, tiles->id(), palette_ref.id(), palette_ref.bpp(),
@@ -102,7 +115,8 @@ public:
         visible(builder.visible()),
         remove_affine_mat_when_not_needed(builder.remove_affine_mat_when_not_needed()),
         on_screen(false),
-        check_on_screen(builder.visible())
+        check_on_screen(builder.visible()),
+        y_sort_enabled(false)
     {
         _builder_init(builder);
     }
@@ -120,7 +134,8 @@ public:
         visible(builder.visible()),
         remove_affine_mat_when_not_needed(builder.remove_affine_mat_when_not_needed()),
         on_screen(false),
-        check_on_screen(builder.visible())
+        check_on_screen(builder.visible()),
+        y_sort_enabled(false)
     {
         _builder_init(builder);
     }
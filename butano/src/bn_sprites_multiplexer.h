@@ -0,0 +1,162 @@
+/*
+ * Copyright (c) 2020-2023 Gustavo Valiente gustavo.valiente@protonmail.com
+ * zlib License, see LICENSE file.
+ */
+
+#ifndef BN_SPRITES_MULTIPLEXER_H
+#define BN_SPRITES_MULTIPLEXER_H
+
+#include "bn_memory.h"
+#include "bn_hdma_manager.h"
+#include "bn_sprites_manager_item.h"
+#include "../hw/include/bn_hw_sprites_constants.h"
+
+namespace bn
+{
+
+class sprites_multiplexer
+{
+
+public:
+    static constexpr int handles_count = BN_CFG_SPRITES_MULTIPLEXER_HANDLES;
+    static constexpr int bands_count = BN_CFG_SPRITES_MULTIPLEXER_BANDS;
+    static constexpr int band_height = display::height() / bands_count;
+    static constexpr int first_handle_index = hw::sprites::count() - handles_count;
+    static constexpr int lines_offset = 2;
+
+    static_assert(handles_count > 0 && handles_count < hw::sprites::count());
+    static_assert(bands_count > 0 && display::height() % bands_count == 0);
+    static_assert(band_height > lines_offset);
+
+    [[nodiscard]] int items_count() const
+    {
+        return _items_count;
+    }
+
+    [[nodiscard]] int band_items_count(int band) const
+    {
+        return _band_items_counts[band];
+    }
+
+    void clear()
+    {
+        if(_items_count)
+        {
+            memory::clear(bands_count * handles_count, _band_items[0][0]);
+            memory::clear(bands_count, _band_items_counts[0]);
+            _items_count = 0;
+        }
+    }
+
+    [[nodiscard]] bool add(sprites_manager_item& item)
+    {
+        int y = item.hw_position.y();
+        int first_band = max(y, 0) / band_height;
+        int last_band = (min(y + (item.half_height * 2), display::height()) - 1) / band_height;
+
+        for(int handle_index = 0; handle_index < handles_count; ++handle_index)
+        {
+            bool available = true;
+
+            for(int band = first_band; band <= last_band; ++band)
+            {
+                if(_band_items[band][handle_index])
+                {
+                    available = false;
+                    break;
+                }
+            }
+
+            if(available)
+            {
+                for(int band = first_band; band <= last_band; ++band)
+                {
+                    _band_items[band][handle_index] = &item;
+                    ++_band_items_counts[band];
+                }
+
+                ++_items_count;
+                return true;
+            }
+        }
+
+        return false;
+    }
+
+    // Returns true if multiplexing has been stopped, so reserved handles must be committed again:
+    [[nodiscard]] bool update(const hw::sprites::handle_type* handles)
+    {
+        if(! _items_count)
+        {
+            if(_running)
+            {
+                _running = false;
+                hdma_manager::low_priority_stop();
+                return true;
+            }
+
+            return false;
+        }
+
+        BN_BASIC_ASSERT(_running || ! hdma_manager::low_priority_running(),
+                        "Sprites can't be multiplexed while HDMA is running");
+
+        // HDMA values of each line are copied in the H-Blank of the previous one,
+        // and sprites are fetched one line in advance, so tables must be built lines_offset lines ahead:
+
+        hw::sprites::handle_type* table = _tables[_table_index];
+        const hw::sprites::handle_type* reserved_handles = handles + first_handle_index;
+        int previous_band = -1;
+
+        for(int line = 0; line < display::height(); ++line)
+        {
+            hw::sprites::handle_type* row = table + (line * handles_count);
+            int band = ((line + lines_offset) % display::height()) / band_height;
+
+            if(band == previous_band)
+            {
+                memory::copy(*(row - handles_count), handles_count, *row);
+            }
+            else
+            {
+                sprites_manager_item* const* band_items = _band_items[band];
+                previous_band = band;
+
+                for(int handle_index = 0; handle_index < handles_count; ++handle_index)
+                {
+                    hw::sprites::handle_type& row_handle = row[handle_index];
+
+                    if(const sprites_manager_item* item = band_items[handle_index])
+                    {
+                        hw::sprites::copy_handle(item->handle, row_handle);
+                    }
+                    else
+                    {
+                        hw::sprites::hide_and_destroy(row_handle);
+                    }
+
+                    // Affine mats are stored in the unused sprite attributes:
+                    row_handle.fill = reserved_handles[handle_index].fill;
+                }
+            }
+        }
+
+        hdma_manager::low_priority_start(table->attr0, handles_count * int(sizeof(hw::sprites::handle_type) / 2),
+                                         *hw::sprites::first_attributes_register(first_handle_index));
+        _table_index = (_table_index + 1) % 2;
+        _running = true;
+        return false;
+    }
+
+private:
+    hw::sprites::handle_type _tables[2][display::height() * handles_count];
+    sprites_manager_item* _band_items[bands_count][handles_count] = {};
+    int _band_items_counts[bands_count] = {};
+    int _items_count = 0;
+    int _table_index = 0;
+    bool _running = false;
+};
+
+}
+
+#endif
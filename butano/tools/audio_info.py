@@ -0,0 +1,210 @@
+"""
+Copyright (c) 2020-2023 Gustavo Valiente gustavo.valiente@protonmail.com
+zlib License, see LICENSE file.
+"""
+
+import os
+import struct
+import wave
+
+
+class AudioSampleInfo:
+
+    def __init__(self, name, frames, sample_rate, bits, channels):
+        self.name = name
+        self.frames = frames
+        self.sample_rate = sample_rate
+        self.bits = bits
+        self.channels = channels
+
+    def soundbank_size(self):
+        # mmutil stores GBA samples as 8-bit mono:
+        return self.frames
+
+
+class AudioInfo:
+
+    def __init__(self, file_path):
+        self.file_size = os.path.getsize(file_path)
+        self.channels = None
+        self.samples = []
+
+        with open(file_path, 'rb') as file:
+            self.__data = file.read()
+
+        file_name_ext = os.path.splitext(file_path)[1]
+
+        if file_name_ext == '.wav':
+            self.__read_wav(file_path)
+        elif file_name_ext == '.mod':
+            self.__read_mod()
+        elif file_name_ext == '.s3m':
+            self.__read_s3m()
+        elif file_name_ext == '.xm':
+            self.__read_xm()
+        elif file_name_ext == '.it':
+            self.__read_it()
+        else:
+            raise ValueError('Unknown audio file extension: ' + file_name_ext)
+
+        self.__data = None
+
+    def __read(self, fmt, offset):
+        return struct.unpack_from('<' + fmt, self.__data, offset)[0]
+
+    def __read_name(self, offset, size):
+        return self.__data[offset:offset + size].split(b'\0')[0].decode('latin-1').strip()
+
+    def __read_wav(self, file_path):
+        with wave.open(file_path, 'rb') as wav_file:
+            self.channels = wav_file.getnchannels()
+            self.samples.append(AudioSampleInfo('', wav_file.getnframes(), wav_file.getframerate(),
+                                                wav_file.getsampwidth() * 8, self.channels))
+
+    def __read_mod(self):
+        signature = self.__data[1080:1084].decode('latin-1')
+
+        if signature in ('M.K.', 'M!K!', 'FLT4', '4CHN'):
+            self.channels = 4
+        elif signature in ('FLT8', 'OCTA', 'CD81'):
+            self.channels = 8
+        elif signature[1:] == 'CHN' and signature[0].isdigit():
+            self.channels = int(signature[0])
+        elif signature[2:] in ('CH', 'CN') and signature[:2].isdigit():
+            self.channels = int(signature[:2])
+        else:
+            raise ValueError('Invalid MOD signature: ' + signature)
+
+        for sample_index in range(31):
+            offset = 20 + (sample_index * 30)
+            frames = struct.unpack_from('>H', self.__data, offset + 22)[0] * 2
+
+            if frames > 2:
+                finetune = self.__data[offset + 24] & 0x0F
+
+                if finetune > 7:
+                    finetune -= 16
+
+                sample_rate = int(round(8363 * pow(2, finetune / 96)))
+                self.samples.append(AudioSampleInfo(self.__read_name(offset, 22), frames, sample_rate, 8, 1))
+
+    def __read_s3m(self):
+        if self.__data[44:48] != b'SCRM':
+            raise ValueError('Invalid S3M signature')
+
+        orders_count = self.__read('H', 32)
+        instruments_count = self.__read('H', 34)
+        self.channels = sum(1 for channel in self.__data[64:96] if channel < 16)
+
+        for instrument_index in range(instruments_count):
+            offset = self.__read('H', 96 + orders_count + (instrument_index * 2)) * 16
+
+            if self.__data[offset] == 1:
+                frames = self.__read('I', offset + 16)
+
+                if frames > 0:
+                    flags = self.__data[offset + 31]
+                    bits = 16 if flags & 4 else 8
+                    channels = 2 if flags & 2 else 1
+                    sample_rate = self.__read('I', offset + 32)
+                    self.samples.append(AudioSampleInfo(self.__read_name(offset + 48, 28), frames, sample_rate,
+                                                        bits, channels))
+
+    def __read_xm(self):
+        if self.__data[0:17] != b'Extended Module: ':
+            raise ValueError('Invalid XM signature')
+
+        header_size = self.__read('I', 60)
+        self.channels = self.__read('H', 68)
+        patterns_count = self.__read('H', 70)
+        instruments_count = self.__read('H', 72)
+        offset = 60 + header_size
+
+        for pattern_index in range(patterns_count):
+            offset += self.__read('I', offset) + self.__read('H', offset + 7)
+
+        for instrument_index in range(instruments_count):
+            instrument_size = self.__read('I', offset)
+            samples_count = self.__read('H', offset + 27)
+
+            if samples_count == 0:
+                offset += instrument_size
+                continue
+
+            sample_header_size = self.__read('I', offset + 29)
+            offset += instrument_size
+            sample_datas_size = 0
+
+            for sample_index in range(samples_count):
+                size = self.__read('I', offset)
+                finetune = self.__read('b', offset + 13)
+                sample_type = self.__data[offset + 14]
+                relative_note = self.__read('b', offset + 16)
+                bits = 16 if sample_type & 16 else 8
+                frames = size // (bits // 8)
+
+                if frames > 0:
+                    sample_rate = int(round(8363 * pow(2, ((relative_note * 128) + finetune) / (12 * 128))))
+                    self.samples.append(AudioSampleInfo(self.__read_name(offset + 18, 22), frames, sample_rate,
+                                                        bits, 1))
+
+                sample_datas_size += size
+                offset += sample_header_size
+
+            offset += sample_datas_size
+
+    def __read_it(self):
+        if self.__data[0:4] != b'IMPM':
+            raise ValueError('Invalid IT signature')
+
+        orders_count = self.__read('H', 32)
+        instruments_count = self.__read('H', 34)
+        samples_count = self.__read('H', 36)
+        patterns_count = self.__read('H', 38)
+        samples_offset = 192 + orders_count + (instruments_count * 4)
+        patterns_offset = samples_offset + (samples_count * 4)
+
+        for sample_index in range(samples_count):
+            offset = self.__read('I', samples_offset + (sample_index * 4))
+            flags = self.__data[offset + 18]
+            frames = self.__read('I', offset + 48)
+
+            if flags & 1 and frames > 0:
+                bits = 16 if flags & 2 else 8
+                channels = 2 if flags & 4 else 1
+                sample_rate = self.__read('I', offset + 60)
+                self.samples.append(AudioSampleInfo(self.__read_name(offset + 20, 26), frames, sample_rate,
+                                                    bits, channels))
+
+        # IT files usually have all channels enabled, so only the ones used by the patterns are counted:
+        used_channels = set()
+
+        for pattern_index in range(patterns_count):
+            offset = self.__read('I', patterns_offset + (pattern_index * 4))
+
+            if offset == 0:
+                continue
+
+            data_offset = offset + 8
+            data_end = data_offset + self.__read('H', offset)
+            masks = [0] * 64
+
+            while data_offset < data_end:
+                channel_variable = self.__data[data_offset]
+                data_offset += 1
+
+                if channel_variable == 0:
+                    continue
+
+                channel = (channel_variable - 1) & 63
+                used_channels.add(channel)
+
+                if channel_variable & 128:
+                    masks[channel] = self.__data[data_offset]
+                    data_offset += 1
+
+                mask = masks[channel]
+                data_offset += (1 if mask & 1 else 0) + (1 if mask & 2 else 0) + (1 if mask & 4 else 0) + \
+                    (2 if mask & 8 else 0)
+
+        self.channels = len(used_channels)
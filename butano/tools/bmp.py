@@ -49,6 +49,8 @@ class BMP:
             if bits_per_pixel != 4 and bits_per_pixel != 8:
                 raise ValueError('Invalid bits per pixel: ' + str(bits_per_pixel))
 
+            self.__bits_per_pixel = bits_per_pixel
+
             compression_method = read_int()
 
             if compression_method != 0:
@@ -92,6 +94,38 @@ class BMP:
 
             self.colors_count = colors_count
 
+    def crop(self, x, y, width, height, output_file_path):
+        if x < 0 or y < 0 or x % 8 != 0 or y % 8 != 0 or width <= 0 or height <= 0 or width % 8 != 0 or \
+                height % 8 != 0 or x + width > self.width or y + height > self.height:
+            raise ValueError('Invalid crop area: ' + str(x) + ' - ' + str(y) + ' - ' + str(width) + ' - ' +
+                             str(height))
+
+        bits_per_pixel = self.__bits_per_pixel
+        input_row_size = int(((self.width * bits_per_pixel) + 31) / 32) * 4
+        output_row_size = int(((width * bits_per_pixel) + 31) / 32) * 4
+        row_offset = int((x * bits_per_pixel) / 8)
+        row_size = int((width * bits_per_pixel) / 8)
+
+        with open(self.__file_path, 'rb') as input_file:
+            input_file_content = input_file.read()
+
+        output_file_content = bytearray(input_file_content[:self.__pixels_offset])
+
+        # Rows are stored bottom-up:
+        for output_row in range(height - 1, -1, -1):
+            input_row = self.height - 1 - (y + output_row)
+            input_row_start = self.__pixels_offset + (input_row * input_row_size) + row_offset
+            output_file_content.extend(input_file_content[input_row_start:input_row_start + row_size])
+            output_file_content.extend(bytes(output_row_size - row_size))
+
+        struct.pack_into('I', output_file_content, 2, len(output_file_content))
+        struct.pack_into('I', output_file_content, 18, width)
+        struct.pack_into('I', output_file_content, 22, height)
+        struct.pack_into('I', output_file_content, 34, output_row_size * height)
+
+        with open(output_file_path, 'wb') as output_file:
+            output_file.write(output_file_content)
+
     def quantize(self, output_file_path):
         if self.colors_count == 16:
             shutil.copyfile(self.__file_path, output_file_path)
@@ -12,13 +12,18 @@ if __name__ == "__main__":
     parser.add_argument('--grit', required=True, help='git executable path')
     parser.add_argument('--mmutil', required=True, help='mmutil executable path')
     parser.add_argument('--audio', required=True, help='audio folder and file paths')
+    parser.add_argument('--audio_mixing_rate', default='', help='audio mixing rate (BN_CFG_AUDIO_MIXING_RATE)')
+    parser.add_argument('--audio_max_music_channels', default='',
+                        help='audio max music channels (BN_CFG_AUDIO_MAX_MUSIC_CHANNELS)')
+    parser.add_argument('--audio_resample', default='', help='resample sound effects above the audio mixing rate')
     parser.add_argument('--dmg_audio', required=True, help='dmg audio folder and file paths')
     parser.add_argument('--graphics', required=True, help='graphics folder and file paths')
     parser.add_argument('--build', required=True, help='build folder path')
 
     try:
         args = parser.parse_args()
-        process_audio(args.mmutil, args.audio, args.build)
+        process_audio(args.mmutil, args.audio, args.audio_mixing_rate, args.audio_max_music_channels,
+                      args.audio_resample, args.build)
         process_dmg_audio(args.dmg_audio, args.build)
         process_graphics(args.grit, args.graphics, args.build)
     except Exception as ex:
@@ -4,10 +4,329 @@ zlib License, see LICENSE file.
 """
 
 import os
+import re
+import json
+import math
+import wave
+import struct
 import subprocess
 import sys
+from multiprocessing import Pool
 
 from file_info import FileInfo
+from audio_info import AudioInfo
+
+
+ADPCM_STEPS = [
+    7, 8, 9, 10, 11, 12, 13, 14, 16, 17, 19, 21, 23, 25, 28, 31, 34, 37, 41, 45, 50, 55, 60, 66, 73, 80, 88, 97, 107,
+    118, 130, 143, 157, 173, 190, 209, 230, 253, 279, 307, 337, 371, 408, 449, 494, 544, 598, 658, 724, 796, 876, 963,
+    1060, 1166, 1282, 1411, 1552, 1707, 1878, 2066, 2272, 2499, 2749, 3024, 3327, 3660, 4026, 4428, 4871, 5358, 5894,
+    6484, 7132, 7845, 8630, 9493, 10442, 11487, 12635, 13899, 15289, 16818, 18500, 20350, 22385, 24623, 27086, 29794,
+    32767]
+
+ADPCM_INDEX_ADJUSTS = [-1, -1, -1, -1, 2, 4, 6, 8]
+
+ADPCM_SAMPLES_PER_BLOCK = 1024
+
+# Zero crossings of each side of the resampling low-pass filter:
+RESAMPLE_FILTER_ZERO_CROSSINGS = 16
+
+# Mixing rates and their frequencies are read from the engine header, so they are defined only once:
+MIXING_RATE_HEADER_PATH = os.path.join(os.path.dirname(os.path.abspath(__file__)), '..', 'include',
+                                       'bn_audio_mixing_rate.h')
+
+DEFAULT_MIXING_RATE = 'BN_AUDIO_MIXING_RATE_16_KHZ'
+
+DEFAULT_MAX_MUSIC_CHANNELS = 16
+
+
+def read_mixing_rates():
+    # Returns the mixing rate names indexed by value and the frequency in Hz of each name:
+    with open(MIXING_RATE_HEADER_PATH) as header_file:
+        header = header_file.read()
+
+    names = {}
+    frequencies = {}
+
+    for name, value in re.findall(r'#define (BN_AUDIO_MIXING_RATE_[0-9]+_KHZ)\s+([0-9]+)', header):
+        names[int(value)] = name
+
+    for name, frequency in re.findall(r'#define (BN_AUDIO_MIXING_RATE_[0-9]+_KHZ)_FREQUENCY\s+([0-9]+)', header):
+        frequencies[name] = int(frequency)
+
+    return names, frequencies
+
+
+def parse_mixing_rate(mixing_rate):
+    if len(mixing_rate) == 0:
+        mixing_rate = DEFAULT_MIXING_RATE
+
+    names, frequencies = read_mixing_rates()
+
+    if mixing_rate.isdigit() and int(mixing_rate) in names:
+        mixing_rate = names[int(mixing_rate)]
+
+    if mixing_rate in frequencies:
+        return frequencies[mixing_rate]
+
+    raise ValueError('Invalid audio mixing rate: ' + mixing_rate)
+
+
+def parse_max_music_channels(max_music_channels):
+    if len(max_music_channels) == 0:
+        return DEFAULT_MAX_MUSIC_CHANNELS
+
+    if not max_music_channels.isdigit() or int(max_music_channels) < 1:
+        raise ValueError('Invalid audio max music channels: ' + max_music_channels)
+
+    return int(max_music_channels)
+
+
+def read_wav_file(file_path):
+    with wave.open(file_path, 'rb') as wav_file:
+        channels = wav_file.getnchannels()
+        sample_width = wav_file.getsampwidth()
+        sample_rate = wav_file.getframerate()
+        frames = wav_file.readframes(wav_file.getnframes())
+
+    if sample_width == 1:
+        values = [(value - 128) << 8 for value in frames]
+    elif sample_width == 2:
+        values = list(struct.unpack('<' + str(len(frames) // 2) + 'h', frames))
+    else:
+        raise ValueError('Invalid sample width: ' + str(sample_width * 8) + ' bits (8 or 16 expected)')
+
+    if channels > 1:
+        values = [sum(values[index:index + channels]) // channels for index in range(0, len(values), channels)]
+
+    if len(values) == 0:
+        raise ValueError('Empty WAV file')
+
+    return values, sample_rate, sample_width
+
+
+def resample(samples, input_sample_rate, output_sample_rate):
+    if input_sample_rate == output_sample_rate:
+        return samples
+
+    output_samples_count = max((len(samples) * output_sample_rate) // input_sample_rate, 1)
+    last_index = len(samples) - 1
+    result = []
+
+    if output_sample_rate > input_sample_rate:
+        # Upsampling doesn't add aliasing, so linear interpolation is enough:
+        for output_index in range(output_samples_count):
+            position = (output_index * input_sample_rate) / output_sample_rate
+            index = int(position)
+
+            if index >= last_index:
+                result.append(samples[last_index])
+            else:
+                fraction = position - index
+                result.append(int(round(samples[index] + ((samples[index + 1] - samples[index]) * fraction))))
+
+        return result
+
+    # Downsampling interpolates with a windowed sinc low-pass filter at the output Nyquist frequency,
+    # so frequencies above it are removed instead of being aliased:
+    ratio = output_sample_rate / input_sample_rate
+    half_width = RESAMPLE_FILTER_ZERO_CROSSINGS / ratio
+
+    for output_index in range(output_samples_count):
+        position = output_index / ratio
+        first_index = max(int(math.ceil(position - half_width)), 0)
+        last_filter_index = min(int(math.floor(position + half_width)), last_index)
+        value = 0
+        weights = 0
+
+        for index in range(first_index, last_filter_index + 1):
+            distance = (index - position) * ratio
+            window = 0.5 + (0.5 * math.cos(math.pi * distance / RESAMPLE_FILTER_ZERO_CROSSINGS))
+            weight = window if distance == 0 else window * math.sin(math.pi * distance) / (math.pi * distance)
+            value += samples[index] * weight
+            weights += weight
+
+        result.append(min(max(int(round(value / weights)), -32768), 32767))
+
+    return result
+
+
+def read_adpcm_music_sample_rate(json_file_path):
+    try:
+        with open(json_file_path) as json_file:
+            info = json.load(json_file)
+    except Exception as exception:
+        raise ValueError(json_file_path + ' audio json file parse failed: ' + str(exception))
+
+    try:
+        audio_type = str(info['type'])
+    except KeyError:
+        raise ValueError('type field not found in audio json file: ' + json_file_path)
+
+    if audio_type != 'adpcm_music':
+        raise ValueError('Invalid audio type: ' + audio_type)
+
+    try:
+        sample_rate = int(info['sample_rate'])
+    except KeyError:
+        return None
+
+    if sample_rate < 1 or sample_rate > 65535:
+        raise ValueError('Invalid sample rate: ' + str(sample_rate))
+
+    return sample_rate
+
+
+def adpcm_music_size(samples_count):
+    blocks_count = (samples_count + ADPCM_SAMPLES_PER_BLOCK - 1) // ADPCM_SAMPLES_PER_BLOCK
+    return 12 + (blocks_count * (4 + (ADPCM_SAMPLES_PER_BLOCK // 2)))
+
+
+class AdpcmMusicFileInfo:
+
+    def __init__(self, json_file_path, file_path, file_name, file_name_no_ext, file_info_path, mixing_rate):
+        self.__json_file_path = json_file_path
+        self.__file_path = file_path
+        self.__file_name = file_name
+        self.__file_name_no_ext = file_name_no_ext
+        self.__file_info_path = file_info_path
+        self.__mixing_rate = mixing_rate
+
+    def print_file_name(self):
+        print(self.__file_name)
+
+    def process(self, build_folder_path):
+        output_tag = self.__file_name_no_ext + '_bn_adpcm'
+        output_file_path = build_folder_path + '/' + output_tag + '.c'
+
+        try:
+            sample_rate = read_adpcm_music_sample_rate(self.__json_file_path)
+            samples, wav_sample_rate, _ = read_wav_file(self.__file_path)
+
+            if sample_rate is None:
+                sample_rate = min(wav_sample_rate, self.__mixing_rate)
+
+            samples = resample(samples, wav_sample_rate, sample_rate)
+            output_data = AdpcmMusicFileInfo.__encode(samples, sample_rate)
+            self.__write_data(output_data, output_tag, output_file_path)
+            header_file_path = self.__write_header(build_folder_path, output_tag)
+
+            # Default sample rate depends on the mixing rate, so it is stored to rebuild if it changes:
+            with open(self.__file_info_path, 'w') as file_info:
+                file_info.write(str(self.__mixing_rate))
+
+            return [self.__file_name, header_file_path, len(output_data)]
+        except Exception as exc:
+            if os.path.exists(output_file_path):
+                os.remove(output_file_path)
+
+            return [self.__file_name, exc]
+
+    @staticmethod
+    def __encode(samples, sample_rate):
+        samples_count = len(samples)
+        samples_per_block = ADPCM_SAMPLES_PER_BLOCK
+        result = bytearray(struct.pack('<III', sample_rate, samples_count, samples_per_block))
+        step_index = 0
+
+        for block_start in range(0, samples_count, samples_per_block):
+            block_samples = samples[block_start:block_start + samples_per_block]
+            block_samples += [block_samples[-1]] * (samples_per_block - len(block_samples))
+
+            # Each block starts from its first sample, so encoding errors are not carried between blocks:
+            predictor = min(max(block_samples[0], -32768), 32767)
+            result += struct.pack('<hBB', predictor, step_index, 0)
+            nibbles = []
+
+            for sample in block_samples:
+                step = ADPCM_STEPS[step_index]
+                difference = sample - predictor
+                nibble = 0
+
+                if difference < 0:
+                    nibble = 8
+                    difference = -difference
+
+                if difference >= step:
+                    nibble |= 4
+                    difference -= step
+
+                if difference >= step >> 1:
+                    nibble |= 2
+                    difference -= step >> 1
+
+                if difference >= step >> 2:
+                    nibble |= 1
+
+                # Predictor is updated as the decoder does, so both stay in sync:
+                decoded_difference = step >> 3
+
+                if nibble & 4:
+                    decoded_difference += step
+
+                if nibble & 2:
+                    decoded_difference += step >> 1
+
+                if nibble & 1:
+                    decoded_difference += step >> 2
+
+                if nibble & 8:
+                    decoded_difference = -decoded_difference
+
+                predictor = min(max(predictor + decoded_difference, -32768), 32767)
+                step_index = min(max(step_index + ADPCM_INDEX_ADJUSTS[nibble & 7], 0), len(ADPCM_STEPS) - 1)
+                nibbles.append(nibble)
+
+            for index in range(0, samples_per_block, 2):
+                result.append(nibbles[index] | (nibbles[index + 1] << 4))
+
+        return result
+
+    @staticmethod
+    def __write_data(output_data, output_tag, output_file_path):
+        with open(output_file_path, 'w') as output_file:
+            output_file.write('#include <stdint.h>' + '\n')
+            output_file.write('\n')
+            output_file.write('__attribute__((aligned(4))) const uint8_t ' + output_tag + '[] = {' + '\n')
+
+            for index in range(0, len(output_data), 16):
+                line_data = output_data[index:index + 16]
+                output_file.write('    ' + ', '.join('0x%02x' % value for value in line_data) + ',' + '\n')
+
+            output_file.write('};' + '\n')
+            output_file.write('\n')
+
+    def __write_header(self, build_folder_path, output_tag):
+        name = self.__file_name_no_ext
+        header_file_path = build_folder_path + '/bn_adpcm_music_items_' + name + '.h'
+
+        with open(header_file_path, 'w') as header_file:
+            include_guard = 'BN_ADPCM_MUSIC_ITEMS_' + name.upper() + '_H'
+            header_file.write('#ifndef ' + include_guard + '\n')
+            header_file.write('#define ' + include_guard + '\n')
+            header_file.write('\n')
+            header_file.write('#include "bn_adpcm_music_item.h"' + '\n')
+            header_file.write('\n')
+            header_file.write('extern const uint8_t ' + output_tag + '[];' + '\n')
+            header_file.write('\n')
+            header_file.write('namespace bn::adpcm_music_items' + '\n')
+            header_file.write('{' + '\n')
+            header_file.write('    constexpr inline adpcm_music_item ' + name + '(*' + output_tag + ');' + '\n')
+            header_file.write('}' + '\n')
+            header_file.write('\n')
+            header_file.write('#endif' + '\n')
+            header_file.write('\n')
+
+        return header_file_path
+
+
+class AdpcmMusicFileInfoProcessor:
+
+    def __init__(self, build_folder_path):
+        self.__build_folder_path = build_folder_path
+
+    def __call__(self, adpcm_music_file_info):
+        return adpcm_music_file_info.process(self.__build_folder_path)
 
 
 def list_audio_files(audio_paths):
@@ -28,18 +347,281 @@ def list_audio_files(audio_paths):
     audio_file_names = []
     audio_file_names_no_ext = []
     audio_file_paths = []
+    adpcm_music_file_paths = []
+    temp_audio_file_paths = sorted(temp_audio_file_paths)
+
+    # WAV files with a json file are streamed as ADPCM music instead of being added to the soundbank:
+    for audio_file_path in temp_audio_file_paths:
+        audio_file_name = os.path.basename(audio_file_path)
+
+        if FileInfo.validate(audio_file_name) and audio_file_name.endswith('.json'):
+            wav_file_path = audio_file_path[:-len('.json')] + '.wav'
 
-    for audio_file_path in sorted(temp_audio_file_paths):
+            if wav_file_path not in temp_audio_file_paths:
+                raise ValueError('WAV file not found for audio json file: ' + audio_file_path)
+
+            adpcm_music_file_paths.append([wav_file_path, audio_file_path])
+
+    adpcm_music_wav_file_paths = set(adpcm_music_file_path[0] for adpcm_music_file_path in adpcm_music_file_paths)
+
+    for audio_file_path in temp_audio_file_paths:
         audio_file_name = os.path.basename(audio_file_path)
 
-        if FileInfo.validate(audio_file_name):
+        if FileInfo.validate(audio_file_name) and not audio_file_name.endswith('.json') and \
+                audio_file_path not in adpcm_music_wav_file_paths:
             audio_file_name_split = os.path.splitext(audio_file_name)
             audio_file_name_no_ext = audio_file_name_split[0]
             audio_file_names.append(audio_file_name)
             audio_file_names_no_ext.append(audio_file_name_no_ext)
             audio_file_paths.append(audio_file_path)
 
-    return audio_file_names, audio_file_names_no_ext, audio_file_paths
+    return audio_file_names, audio_file_names_no_ext, audio_file_paths, adpcm_music_file_paths
+
+
+def list_adpcm_music_file_infos(adpcm_music_file_paths, mixing_rate, build_folder_path):
+    adpcm_music_file_infos = []
+
+    for wav_file_path, json_file_path in adpcm_music_file_paths:
+        wav_file_name = os.path.basename(wav_file_path)
+        wav_file_name_no_ext = os.path.splitext(wav_file_name)[0]
+        file_info_path = build_folder_path + '/_bn_' + wav_file_name_no_ext + '_adpcm_music_file_info.txt'
+
+        if FileInfo.read(file_info_path) != FileInfo(str(mixing_rate), False):
+            build = True
+        else:
+            file_info_mtime = os.path.getmtime(file_info_path)
+            build = file_info_mtime < os.path.getmtime(wav_file_path) or \
+                file_info_mtime < os.path.getmtime(json_file_path)
+
+        if build:
+            adpcm_music_file_infos.append(AdpcmMusicFileInfo(
+                json_file_path, wav_file_path, wav_file_name, wav_file_name_no_ext, file_info_path, mixing_rate))
+
+    return adpcm_music_file_infos
+
+
+def process_adpcm_music_files(adpcm_music_file_paths, mixing_rate, build_folder_path):
+    adpcm_music_file_infos = list_adpcm_music_file_infos(adpcm_music_file_paths, mixing_rate, build_folder_path)
+
+    if len(adpcm_music_file_infos) > 0:
+        for adpcm_music_file_info in adpcm_music_file_infos:
+            adpcm_music_file_info.print_file_name()
+
+        sys.stdout.flush()
+
+        pool = Pool()
+        process_results = pool.map(AdpcmMusicFileInfoProcessor(build_folder_path), adpcm_music_file_infos)
+        pool.close()
+
+        process_excs = []
+
+        for process_result in process_results:
+            if len(process_result) == 3:
+                print('    ' + str(process_result[0]) + ' item header written in ' + str(process_result[1]) +
+                      ' (music size: ' + str(process_result[2]) + ' bytes)')
+            else:
+                process_excs.append(process_result)
+
+        sys.stdout.flush()
+
+        if len(process_excs) > 0:
+            for process_exc in process_excs:
+                sys.stderr.write(str(process_exc[0]) + ' error: ' + str(process_exc[1]) + '\n')
+
+            exit(-1)
+
+    return len(adpcm_music_file_infos) > 0
+
+
+def write_wav_file(samples, sample_rate, sample_width, file_path):
+    if sample_width == 1:
+        frames = bytes(min(max((sample >> 8) + 128, 0), 255) for sample in samples)
+    else:
+        frames = struct.pack('<' + str(len(samples)) + 'h', *samples)
+
+    with wave.open(file_path, 'wb') as wav_file:
+        wav_file.setnchannels(1)
+        wav_file.setsampwidth(sample_width)
+        wav_file.setframerate(sample_rate)
+        wav_file.writeframes(frames)
+
+
+def resample_sound_files(audio_file_paths, mixing_rate, build_folder_path):
+    resampled_folder_path = build_folder_path + '/_bn_resampled_audio'
+    result = []
+
+    for audio_file_path in audio_file_paths:
+        if audio_file_path.endswith('.wav'):
+            with wave.open(audio_file_path, 'rb') as wav_file:
+                sample_rate = wav_file.getframerate()
+
+            # Samples played above the mixing rate waste ROM, since Maxmod skips the extra ones:
+            if sample_rate > mixing_rate:
+                samples, sample_rate, sample_width = read_wav_file(audio_file_path)
+                samples = resample(samples, sample_rate, mixing_rate)
+
+                if not os.path.isdir(resampled_folder_path):
+                    os.makedirs(resampled_folder_path)
+
+                resampled_file_path = resampled_folder_path + '/' + os.path.basename(audio_file_path)
+                write_wav_file(samples, mixing_rate, sample_width, resampled_file_path)
+                print('    ' + os.path.basename(audio_file_path) + ' resampled from ' + str(sample_rate) + ' Hz to ' +
+                      str(mixing_rate) + ' Hz')
+                result.append(resampled_file_path)
+                continue
+
+        result.append(audio_file_path)
+
+    return result
+
+
+def oversampled_warning(sample, mixing_rate, sample_description):
+    saved_bytes = sample.soundbank_size() - ((sample.frames * mixing_rate) // sample.sample_rate)
+    return sample_description + ' (' + str(sample.sample_rate) + ' Hz) is higher than the mixing rate (' + \
+        str(mixing_rate) + ' Hz): resampling it would save ' + str(saved_bytes) + ' bytes'
+
+
+def sample_rate_ratio(sample_rate, mixing_rate):
+    return round(sample_rate / mixing_rate, 3)
+
+
+def build_audio_report_item(audio_file_path, mixing_rate, max_music_channels, resample_sounds):
+    audio_file_name = os.path.basename(audio_file_path)
+    audio_file_name_split = os.path.splitext(audio_file_name)
+    item = {'name': audio_file_name_split[0], 'file': audio_file_path}
+    warnings = []
+
+    try:
+        audio_info = AudioInfo(audio_file_path)
+    except Exception as exception:
+        item['warnings'] = ['Audio file parse failed: ' + str(exception)]
+        return item
+
+    item['file_size'] = audio_info.file_size
+    item['channels'] = audio_info.channels
+
+    if audio_file_name_split[1] == '.wav':
+        sample = audio_info.samples[0]
+        item['sample_rate'] = sample.sample_rate
+        item['sample_rate_ratio'] = sample_rate_ratio(sample.sample_rate, mixing_rate)
+        item['bits'] = sample.bits
+        item['size'] = sample.soundbank_size()
+
+        if sample.sample_rate > mixing_rate:
+            if resample_sounds:
+                item['resampled_sample_rate'] = mixing_rate
+                item['size'] = max((sample.frames * mixing_rate) // sample.sample_rate, 1)
+            else:
+                warnings.append(oversampled_warning(sample, mixing_rate, 'Sample rate'))
+    else:
+        samples = []
+        size = 0
+
+        for sample_index, sample in enumerate(audio_info.samples):
+            samples.append({
+                'name': sample.name,
+                'sample_rate': sample.sample_rate,
+                'sample_rate_ratio': sample_rate_ratio(sample.sample_rate, mixing_rate),
+                'bits': sample.bits,
+                'channels': sample.channels,
+                'size': sample.soundbank_size(),
+            })
+
+            size += sample.soundbank_size()
+
+            if sample.sample_rate > mixing_rate:
+                sample_description = 'Sample "' + sample.name + '"' if sample.name else 'Sample ' + str(sample_index)
+                warnings.append(oversampled_warning(sample, mixing_rate, sample_description + ' C-5 rate'))
+
+        item['size'] = size
+        item['samples'] = samples
+
+        if audio_info.channels > max_music_channels:
+            warnings.append('Channels count (' + str(audio_info.channels) + ') is higher than ' +
+                            'the max music channels (' + str(max_music_channels) + ')')
+
+    item['warnings'] = warnings
+    return item
+
+
+def build_adpcm_music_report_item(wav_file_path, json_file_path, mixing_rate):
+    item = {'name': os.path.splitext(os.path.basename(wav_file_path))[0], 'file': wav_file_path}
+    warnings = []
+
+    try:
+        sample_rate = read_adpcm_music_sample_rate(json_file_path)
+
+        with wave.open(wav_file_path, 'rb') as wav_file:
+            wav_sample_rate = wav_file.getframerate()
+            samples_count = wav_file.getnframes()
+            item['file_size'] = os.path.getsize(wav_file_path)
+            item['channels'] = wav_file.getnchannels()
+    except Exception as exception:
+        item['warnings'] = ['Audio file parse failed: ' + str(exception)]
+        return item
+
+    if sample_rate is None:
+        sample_rate = min(wav_sample_rate, mixing_rate)
+    elif sample_rate > mixing_rate:
+        warnings.append('Sample rate (' + str(sample_rate) + ' Hz) is higher than the mixing rate (' +
+                        str(mixing_rate) + ' Hz): it wastes ROM and CPU')
+
+    if sample_rate != wav_sample_rate:
+        samples_count = max((samples_count * sample_rate) // wav_sample_rate, 1)
+
+    item['sample_rate'] = sample_rate
+    item['sample_rate_ratio'] = sample_rate_ratio(sample_rate, mixing_rate)
+    item['size'] = adpcm_music_size(samples_count)
+    item['warnings'] = warnings
+    return item
+
+
+def write_audio_report(audio_file_paths, adpcm_music_file_paths, mixing_rate, max_music_channels, resample_sounds,
+                       build_folder_path):
+    music_items = []
+    sound_items = []
+    adpcm_music_items = []
+
+    for audio_file_path in audio_file_paths:
+        item = build_audio_report_item(audio_file_path, mixing_rate, max_music_channels, resample_sounds)
+
+        if audio_file_path.endswith('.wav'):
+            sound_items.append(item)
+        else:
+            music_items.append(item)
+
+    for wav_file_path, json_file_path in adpcm_music_file_paths:
+        adpcm_music_items.append(build_adpcm_music_report_item(wav_file_path, json_file_path, mixing_rate))
+
+    soundbank_bin_path = build_folder_path + '/_bn_audio_soundbank.bin'
+    soundbank_size = os.path.getsize(soundbank_bin_path) if os.path.isfile(soundbank_bin_path) else 0
+    report = {
+        'mixing_rate': mixing_rate,
+        'max_music_channels': max_music_channels,
+        'resample_sounds': resample_sounds,
+        'soundbank_size': soundbank_size,
+        'adpcm_music_size': sum(item.get('size', 0) for item in adpcm_music_items),
+        'music': music_items,
+        'sounds': sound_items,
+        'adpcm_music': adpcm_music_items,
+    }
+
+    report_file_path = build_folder_path + '/_bn_audio_report.json'
+
+    with open(report_file_path, 'w') as report_file:
+        json.dump(report, report_file, indent=4)
+        report_file.write('\n')
+
+    warnings_count = 0
+
+    for item in music_items + sound_items + adpcm_music_items:
+        item_warnings_count = len(item['warnings'])
+
+        if item_warnings_count > 0:
+            print('    ' + os.path.basename(item['file']) + ' warnings: ' + str(item_warnings_count))
+            warnings_count += item_warnings_count
+
+    print('    Audio report written in ' + report_file_path + ' (' + str(warnings_count) + ' warnings)')
 
 
 def process_audio_files(mmutil, audio_file_paths, soundbank_bin_path, soundbank_header_path, build_folder_path):
@@ -171,13 +753,22 @@ def write_output_files(audio_file_names_no_ext, soundbank_header_path, build_fol
                            'sound_item', build_folder_path + '/bn_sound_items_info.h')
 
 
-def process_audio(mmutil, audio_paths, build_folder_path):
-    audio_file_names, audio_file_names_no_ext, audio_file_paths = list_audio_files(audio_paths)
+def process_audio(mmutil, audio_paths, mixing_rate, max_music_channels, resample_sounds, build_folder_path):
+    mixing_rate = parse_mixing_rate(mixing_rate)
+    max_music_channels = parse_max_music_channels(max_music_channels)
+    resample_sounds = resample_sounds.lower() in ('true', 'yes', '1')
+    audio_file_names, audio_file_names_no_ext, audio_file_paths, adpcm_music_file_paths = list_audio_files(audio_paths)
+    adpcm_music_processed = process_adpcm_music_files(adpcm_music_file_paths, mixing_rate, build_folder_path)
     file_info_path = build_folder_path + '/_bn_audio_files_info.txt'
     old_file_info = FileInfo.read(file_info_path)
-    new_file_info = FileInfo.build_from_files(audio_file_paths)
+    new_file_info = FileInfo.build_from_files(audio_file_paths,
+                                              [str(mixing_rate), str(max_music_channels), str(resample_sounds)])
 
     if old_file_info == new_file_info:
+        if adpcm_music_processed:
+            write_audio_report(audio_file_paths, adpcm_music_file_paths, mixing_rate, max_music_channels,
+                               resample_sounds, build_folder_path)
+
         return
 
     for audio_file_name in audio_file_names:
@@ -185,11 +776,18 @@ def process_audio(mmutil, audio_paths, build_folder_path):
 
     sys.stdout.flush()
 
+    if resample_sounds:
+        mmutil_file_paths = resample_sound_files(audio_file_paths, mixing_rate, build_folder_path)
+    else:
+        mmutil_file_paths = audio_file_paths
+
     soundbank_bin_path = build_folder_path + '/_bn_audio_soundbank.bin'
     soundbank_header_path = build_folder_path + '/_bn_audio_soundbank.h'
-    total_size = process_audio_files(mmutil, audio_file_paths, soundbank_bin_path, soundbank_header_path,
+    total_size = process_audio_files(mmutil, mmutil_file_paths, soundbank_bin_path, soundbank_header_path,
                                      build_folder_path)
     write_output_files(audio_file_names_no_ext, soundbank_header_path, build_folder_path)
     print('    Processed audio size: ' + str(total_size) + ' bytes')
     os.remove(soundbank_header_path)
+    write_audio_report(audio_file_paths, adpcm_music_file_paths, mixing_rate, max_music_channels, resample_sounds,
+                       build_folder_path)
     new_file_info.write(file_info_path)
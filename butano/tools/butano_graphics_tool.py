@@ -63,24 +63,32 @@ def parse_bg_bpp_mode(info, file_name_no_ext):
         raise ValueError('Invalid BPP mode: ' + bpp_mode)
 
 
-def validate_palette_item(palette_item):
-    if len(palette_item) == 0:
-        raise ValueError('Empty palette item')
+def validate_item_name(item_name, item_label):
+    if len(item_name) == 0:
+        raise ValueError('Empty ' + item_label)
 
-    if palette_item[0] not in string.ascii_lowercase:
-        raise ValueError('Invalid palette item: ' + palette_item +
-                         ' (invalid character: \'' + palette_item[0] + '\')')
+    if item_name[0] not in string.ascii_lowercase:
+        raise ValueError('Invalid ' + item_label + ': ' + item_name +
+                         ' (invalid character: \'' + item_name[0] + '\')')
 
     valid_characters = '_%s%s' % (string.ascii_lowercase, string.digits)
 
-    for palette_item_character in palette_item:
-        if palette_item_character not in valid_characters:
-            raise ValueError('Invalid palette item: ' + palette_item +
-                             ' (invalid character: \'' + palette_item_character + '\')')
+    for item_name_character in item_name:
+        if item_name_character not in valid_characters:
+            raise ValueError('Invalid ' + item_label + ': ' + item_name +
+                             ' (invalid character: \'' + item_name_character + '\')')
+
+
+def validate_palette_item(palette_item):
+    validate_item_name(palette_item, 'palette item')
+
+
+def validate_tiles_group(tiles_group):
+    validate_item_name(tiles_group, 'tiles group')
 
 
 def validate_compression(compression):
-    if compression not in ['none', 'lz77', 'run_length', 'huffman', 'auto', 'auto_no_huffman']:
+    if compression not in ['none', 'lz77', 'run_length', 'huffman', 'fast_lz', 'auto', 'auto_no_huffman']:
         raise ValueError('Unknown compression: ' + str(compression))
 
 
@@ -97,6 +105,9 @@ def compression_label(compression):
     if compression == 'huffman':
         return 'compression_type::HUFFMAN'
 
+    if compression == 'fast_lz':
+        return 'compression_type::FAST_LZ'
+
     raise ValueError('Unknown compression: ' + str(compression))
 
 
@@ -108,12 +119,529 @@ def append_compression_command(tag, compression, command):
     elif compression == 'huffman':
         command.append('-' + tag + 'zh')
 
+    # Fast LZ data is not generated by grit, but compressed later by fast_lz_compress_grit_arrays.
+
+
+def better_compression(best_compression, best_file_size, new_compression, new_file_size, uncompressed_file_size):
+    if best_file_size is None or new_file_size < best_file_size:
+        return True
+
+    # Fast LZ is preferred over slower to decompress formats if it's not much bigger,
+    # but never if it's bigger than the uncompressed data:
+    if new_compression == 'fast_lz' and best_compression in ['lz77', 'huffman']:
+        return new_file_size <= best_file_size * 1.125 and new_file_size <= uncompressed_file_size
+
+    return False
+
 
 def remove_file(file_path):
     if os.path.exists(file_path):
         os.remove(file_path)
 
 
+def lz77_compress(data):
+    # GBA BIOS LZ77 format. Displacements of 1 byte are not used, so it can be decompressed 16 bits at a time:
+    result = bytearray([0x10, len(data) & 0xFF, (len(data) >> 8) & 0xFF, (len(data) >> 16) & 0xFF])
+    index = 0
+
+    while index < len(data):
+        flags_index = len(result)
+        result.append(0)
+
+        for block in range(8):
+            if index >= len(data):
+                break
+
+            best_length = 0
+            best_displacement = 0
+
+            for displacement in range(2, min(index, 4096) + 1):
+                length = 0
+
+                while length < 18 and index + length < len(data) and \
+                        data[index + length] == data[index + length - displacement]:
+                    length += 1
+
+                if length > best_length:
+                    best_length = length
+                    best_displacement = displacement
+
+            if best_length >= 3:
+                result[flags_index] |= 0x80 >> block
+                result.append(((best_length - 3) << 4) | ((best_displacement - 1) >> 8))
+                result.append((best_displacement - 1) & 0xFF)
+                index += best_length
+            else:
+                result.append(data[index])
+                index += 1
+
+    return result
+
+
+def run_length_compress(data):
+    # GBA BIOS run-length format:
+    result = bytearray([0x30, len(data) & 0xFF, (len(data) >> 8) & 0xFF, (len(data) >> 16) & 0xFF])
+    literals = bytearray()
+    index = 0
+
+    def flush_literals():
+        if len(literals) > 0:
+            result.append(len(literals) - 1)
+            result.extend(literals)
+            literals.clear()
+
+    while index < len(data):
+        length = 1
+
+        while length < 130 and index + length < len(data) and data[index + length] == data[index]:
+            length += 1
+
+        if length >= 3:
+            flush_literals()
+            result.append(0x80 | (length - 3))
+            result.append(data[index])
+            index += length
+        else:
+            literals.append(data[index])
+            index += 1
+
+            if len(literals) == 128:
+                flush_literals()
+
+    flush_literals()
+    return result
+
+
+def fast_lz_compress(data):
+    # LZ4 like format with 16-bit units, so it can be decompressed fast and without 8-bit writes:
+    # * Header: 0x40 and the decompressed size in bytes, like GBA BIOS formats.
+    # * Sequences of a token (literals count in the low byte, match length minus 3 in the high byte),
+    #   the literals count extension (if the count is 255 or more), the literals,
+    #   the match offset and the match length extension (if the length minus 3 is 255 or more).
+    #   The last sequence has no match.
+    if len(data) % 2:
+        raise ValueError('Fast LZ data size is not even: ' + str(len(data)))
+
+    units = [data[index] | (data[index + 1] << 8) for index in range(0, len(data), 2)]
+    units_count = len(units)
+    result = [0x40 | ((len(data) & 0xFF) << 8), len(data) >> 8]
+    min_match_length = 3
+    max_literals_count = 255 + 0xFFFF
+    max_match_length = 255 + 0xFFFF + min_match_length
+    max_offset = 0xFFFF
+    max_candidates = 64
+    chains = {}
+    literals_index = 0
+    index = 0
+
+    def find_match(match_index):
+        key = tuple(units[match_index:match_index + min_match_length])
+        best_length = 0
+        best_offset = 0
+
+        if len(key) == min_match_length:
+            max_length = min(units_count - match_index, max_match_length)
+
+            for candidate_index in reversed(chains.get(key, [])[-max_candidates:]):
+                offset = match_index - candidate_index
+
+                if offset > max_offset:
+                    break
+
+                length = min_match_length
+
+                while length < max_length and units[candidate_index + length] == units[match_index + length]:
+                    length += 1
+
+                if length > best_length:
+                    best_length = length
+                    best_offset = offset
+
+                    if length == max_length:
+                        break
+
+        return best_length, best_offset
+
+    def insert(insert_index):
+        key = tuple(units[insert_index:insert_index + min_match_length])
+
+        if len(key) == min_match_length:
+            chains.setdefault(key, []).append(insert_index)
+
+    def append_sequence(literals_end, match_offset, match_length):
+        literals_count = literals_end - literals_index
+
+        if literals_count > max_literals_count:
+            raise ValueError('Too many fast LZ literals: ' + str(literals_count))
+
+        token_match_length = max(match_length - min_match_length, 0)
+        result.append(min(literals_count, 255) | (min(token_match_length, 255) << 8))
+
+        if literals_count >= 255:
+            result.append(literals_count - 255)
+
+        result.extend(units[literals_index:literals_end])
+
+        if match_length:
+            result.append(match_offset)
+
+            if token_match_length >= 255:
+                result.append(token_match_length - 255)
+
+    while index < units_count:
+        match_length, match_offset = find_match(index)
+
+        if match_length:
+            # Lazy matching:
+            insert(index)
+            next_match_length, next_match_offset = find_match(index + 1)
+
+            if next_match_length > match_length + 1:
+                index += 1
+                match_length = next_match_length
+                match_offset = next_match_offset
+            else:
+                chains[tuple(units[index:index + min_match_length])].pop()
+
+            append_sequence(index, match_offset, match_length)
+
+            for match_index in range(index, index + match_length):
+                insert(match_index)
+
+            index += match_length
+            literals_index = index
+        else:
+            insert(index)
+            index += 1
+
+    if literals_index < units_count or units_count == 0:
+        append_sequence(units_count, 0, 0)
+
+    compressed_data = bytearray()
+
+    for unit in result:
+        compressed_data.append(unit & 0xFF)
+        compressed_data.append(unit >> 8)
+
+    return compressed_data
+
+
+def compress_data(data, compression):
+    if compression == 'lz77':
+        return lz77_compress(data)
+
+    if compression == 'run_length':
+        return run_length_compress(data)
+
+    if compression == 'fast_lz':
+        return fast_lz_compress(data)
+
+    raise ValueError('Compression not supported: ' + str(compression))
+
+
+def sprite_tiles_deltas(tiles_data, graphics, max_runs):
+    # Splits the tile sets of an animation in the first tile set and the runs of changed tiles of each tile set
+    # with respect to the previous one (the last one for the first tile set).
+    # Each run is stored in 32 bits: first tile in the tile set, tiles count and first tile in the tiles array.
+    # The runs count of each tile set is limited to max_runs, and the maximum runs count is returned too.
+    tiles = [tuple(tiles_data[index:index + 8]) for index in range(0, len(tiles_data), 8)]
+    tiles_per_graphic = int(len(tiles) / graphics)
+    graphics_tiles = [tiles[index:index + tiles_per_graphic] for index in range(0, len(tiles), tiles_per_graphic)]
+    delta_tiles = list(graphics_tiles[0])
+    delta_tiles_indexes = {}
+    runs = []
+    runs_indexes = []
+    max_graphics_runs = 0
+
+    for tile_index, tile in enumerate(delta_tiles):
+        delta_tiles_indexes.setdefault(tile, []).append(tile_index)
+
+    def find_run_tiles(run_tiles):
+        for tile_index in delta_tiles_indexes.get(run_tiles[0], []):
+            if tuple(delta_tiles[tile_index:tile_index + len(run_tiles)]) == run_tiles:
+                return tile_index
+
+        return None
+
+    for graphics_index in range(graphics):
+        previous_tiles = graphics_tiles[graphics_index - 1]
+        current_tiles = graphics_tiles[graphics_index]
+        runs_indexes.append(len(runs))
+        ranges = []
+
+        for tile_index in range(tiles_per_graphic):
+            if current_tiles[tile_index] != previous_tiles[tile_index]:
+                # Runs separated by only one unchanged tile are joined to reduce the runs count:
+                if len(ranges) > 0 and tile_index <= ranges[-1][1] + 1:
+                    ranges[-1][1] = tile_index + 1
+                else:
+                    ranges.append([tile_index, tile_index + 1])
+
+        # The nearest runs are joined until they fit in the runs per frame limit
+        # (the unchanged tiles between them are uploaded again):
+        while len(ranges) > max_runs:
+            gap_index = min(range(len(ranges) - 1), key=lambda index: ranges[index + 1][0] - ranges[index][1])
+            ranges[gap_index][1] = ranges[gap_index + 1][1]
+            del ranges[gap_index + 1]
+
+        max_graphics_runs = max(max_graphics_runs, len(ranges))
+
+        for first_tile, last_tile in ranges:
+            run_tiles = tuple(current_tiles[first_tile:last_tile])
+            source_tile = find_run_tiles(run_tiles)
+
+            if source_tile is None:
+                source_tile = len(delta_tiles)
+
+                for tile in run_tiles:
+                    delta_tiles_indexes.setdefault(tile, []).append(len(delta_tiles))
+                    delta_tiles.append(tile)
+
+            if source_tile > 0xFFFF:
+                raise ValueError('Too many delta tiles: ' + str(source_tile))
+
+            runs.append(first_tile | ((last_tile - first_tile) << 8) | (source_tile << 16))
+
+    runs_indexes.append(len(runs))
+    return [word for tile in delta_tiles for word in tile], runs, runs_indexes, max_graphics_runs
+
+
+def flip_tile(tile, horizontal_flip, vertical_flip):
+    # Each tile row is stored in 1 word with 4BPP and in 2 words with 8BPP:
+    row_words = int(len(tile) / 8)
+    pixel_bits = row_words * 4
+    pixel_mask = (1 << pixel_bits) - 1
+    rows = [tile[index:index + row_words] for index in range(0, len(tile), row_words)]
+
+    if vertical_flip:
+        rows.reverse()
+
+    result = []
+
+    for row in rows:
+        if horizontal_flip:
+            row_value = 0
+
+            for word_index, word in enumerate(row):
+                row_value |= word << (word_index * 32)
+
+            flipped_row_value = 0
+
+            for pixel_index in range(8):
+                pixel = (row_value >> (pixel_index * pixel_bits)) & pixel_mask
+                flipped_row_value |= pixel << ((7 - pixel_index) * pixel_bits)
+
+            row = [(flipped_row_value >> (word_index * 32)) & 0xFFFFFFFF for word_index in range(row_words)]
+
+        result.extend(row)
+
+    return tuple(result)
+
+
+def tiles_group_reduce(members_tiles, members_cells, members_flipped_tiles_reduction):
+    # Merges the tiles of several regular BGs in a shared tile set without repeated tiles,
+    # and updates the map cells of each BG to reference the shared tile set.
+    # Map cells store the tile index in bits 0-9, the horizontal flip in bit 10 and the vertical flip in bit 11.
+    shared_tiles = []
+    tiles_indexes = {}
+    flipped_tiles_indexes = {}
+    members_shared_cells = []
+
+    for tiles, cells, flipped_tiles_reduction in zip(members_tiles, members_cells, members_flipped_tiles_reduction):
+        tiles_cells = []
+
+        for tile in tiles:
+            tile_cell = tiles_indexes.get(tile)
+
+            if tile_cell is None and flipped_tiles_reduction:
+                tile_cell = flipped_tiles_indexes.get(tile)
+
+            if tile_cell is None:
+                tile_cell = len(shared_tiles)
+                tiles_indexes[tile] = tile_cell
+                shared_tiles.append(tile)
+
+                for flip in range(1, 4):
+                    flipped_tile = flip_tile(tile, flip & 1, flip & 2)
+                    flipped_tiles_indexes.setdefault(flipped_tile, tile_cell | (flip << 10))
+
+            tiles_cells.append(tile_cell)
+
+        shared_cells = []
+
+        for cell in cells:
+            tile_cell = tiles_cells[cell & 0x3FF]
+            shared_cells.append((cell & 0xF000) | ((cell ^ tile_cell) & 0x0C00) | (tile_cell & 0x3FF))
+
+        members_shared_cells.append(shared_cells)
+
+    if len(shared_tiles) > 1024:
+        raise ValueError('Tiles groups with more than 1024 tiles not supported: ' + str(len(shared_tiles)))
+
+    return shared_tiles, members_shared_cells
+
+
+def big_map_chunks_compress(cells, width, height, compression):
+    # Splits a big map in 8x8 cells chunks that can be decompressed independently.
+    # Layout: a table with the byte offset of each chunk, followed by each chunk data aligned to 4 bytes.
+    chunks_columns = width // 8
+    chunks_rows = height // 8
+    chunks = []
+
+    for chunk_y in range(chunks_rows):
+        for chunk_x in range(chunks_columns):
+            chunk_data = bytearray()
+
+            for row in range(8):
+                row_index = ((chunk_y * 8) + row) * width + (chunk_x * 8)
+
+                for cell in cells[row_index:row_index + 8]:
+                    chunk_data.append(cell & 0xFF)
+                    chunk_data.append(cell >> 8)
+
+            best_chunk = bytearray([0x00, len(chunk_data) & 0xFF, len(chunk_data) >> 8, 0]) + chunk_data
+
+            if compression == 'fast_lz':
+                fast_lz_chunk = fast_lz_compress(chunk_data)
+
+                if len(fast_lz_chunk) < len(best_chunk):
+                    best_chunk = fast_lz_chunk
+            else:
+                if compression != 'lz77':
+                    run_length_chunk = run_length_compress(chunk_data)
+
+                    if len(run_length_chunk) < len(best_chunk):
+                        best_chunk = run_length_chunk
+
+                if compression != 'run_length':
+                    lz77_chunk = lz77_compress(chunk_data)
+
+                    if len(lz77_chunk) < len(best_chunk):
+                        best_chunk = lz77_chunk
+
+            while len(best_chunk) % 4 != 0:
+                best_chunk.append(0)
+
+            chunks.append(best_chunk)
+
+    result = bytearray()
+    offset = len(chunks) * 4
+
+    for chunk in chunks:
+        result.extend(offset.to_bytes(4, 'little'))
+        offset += len(chunk)
+
+    for chunk in chunks:
+        result.extend(chunk)
+
+    return [result[index] | (result[index + 1] << 8) for index in range(0, len(result), 2)]
+
+
+def parse_grit_array(grit_data, array_name):
+    array_match = re.search(array_name + r'\[[0-9]+][^{]*\{([^}]*)}', grit_data)
+
+    if array_match is None:
+        raise ValueError('Array not found in grit output: ' + array_name)
+
+    return [int(value, 16) for value in array_match.group(1).replace(',', ' ').split()]
+
+
+def replace_grit_array_values(grit_data, array_name, values, digits):
+    array_match = re.search('(' + array_name + r'\[)([0-9]+)(][^{]*\{)([^}]*)(})', grit_data)
+
+    if array_match is None:
+        raise ValueError('Array not found in grit output: ' + array_name)
+
+    lines = []
+
+    for index in range(0, len(values), 8):
+        line_values = values[index:index + 8]
+        lines.append('\t' + ','.join(('0x{:0' + str(digits) + 'X}').format(value) for value in line_values) + ',')
+
+    return grit_data[:array_match.start()] + array_match.group(1) + str(len(values)) + array_match.group(3) + \
+        '\n' + '\n'.join(lines) + '\n' + array_match.group(5) + grit_data[array_match.end():]
+
+
+def fast_lz_compress_grit_arrays(grit_data, name, arrays, check_sizes=True):
+    # Replaces the specified uncompressed grit arrays with fast LZ compressed ones:
+    return compress_grit_arrays(grit_data, name, [array for array in arrays if array[1] == 'fast_lz'], check_sizes)
+
+
+def compress_grit_arrays(grit_data, name, arrays, check_sizes=False):
+    # Replaces the specified uncompressed grit arrays with compressed ones (huffman is not supported):
+    for array_suffix, compression in arrays:
+        if compression == 'none':
+            continue
+
+        array_name = name + '_bn_gfx' + array_suffix
+        array_match = re.search('(' + array_name + r'\[)([0-9]+)(][^{]*\{)([^}]*)(})', grit_data)
+
+        if array_match is None:
+            raise ValueError('Array not found in grit output: ' + array_name)
+
+        values = array_match.group(4).replace(',', ' ').split()
+
+        if len(values) == 0:
+            continue
+
+        value_size = int((len(values[0]) - 2) / 2)
+        data = bytearray()
+
+        for value in values:
+            data.extend(int(value, 16).to_bytes(value_size, 'little'))
+
+        compressed_data = compress_data(data, compression)
+
+        # Tiles and palette arrays keep their uncompressed size in the generated headers,
+        # so bigger compressed data doesn't fit in them (and it's not worth it for the other arrays either):
+        if check_sizes and len(compressed_data) > len(data):
+            raise ValueError('Compressed ' + array_suffix.lower() + ' data is bigger than the uncompressed one (' +
+                             str(len(compressed_data)) + ' > ' + str(len(data)) + ' bytes): ' + compression +
+                             ' compression is not valid for it')
+
+        while len(compressed_data) % value_size != 0:
+            compressed_data.append(0)
+
+        compressed_values = [int.from_bytes(compressed_data[index:index + value_size], 'little')
+                             for index in range(0, len(compressed_data), value_size)]
+        lines = []
+
+        for index in range(0, len(compressed_values), 8):
+            line_values = compressed_values[index:index + 8]
+            lines.append('\t' + ','.join(('0x{:0' + str(value_size * 2) + 'X}').format(value)
+                                         for value in line_values) + ',')
+
+        grit_data = grit_data[:array_match.start()] + array_match.group(1) + str(len(compressed_values)) + \
+            array_match.group(3) + '\n' + '\n'.join(lines) + '\n' + array_match.group(5) + \
+            grit_data[array_match.end():]
+
+        grit_data = re.sub('(' + array_name + r'Len )([0-9]+)', r'\g<1>' + str(len(compressed_data)), grit_data)
+
+        # Only the last number of the total size line is parsed:
+        size_delta = len(compressed_data) - len(data)
+        total_size_match = re.search(r'Total size:.*?([0-9]+)\s*$', grit_data, re.MULTILINE)
+
+        if total_size_match is not None:
+            total_size = int(total_size_match.group(1)) + size_delta
+            grit_data = grit_data[:total_size_match.start(1)] + str(total_size) + \
+                grit_data[total_size_match.end(1):]
+
+    return grit_data
+
+
+def write_array(type_name, array_name, array_size, values, digits, inline_array=False):
+    # Inline arrays have the same address in all translation units:
+    lines = []
+
+    for index in range(0, len(values), 8):
+        line_values = values[index:index + 8]
+        lines.append('\t' + ','.join(('0x{:0' + str(digits) + 'X}').format(value) for value in line_values) + ',')
+
+    qualifiers = 'inline const ' if inline_array else 'const '
+    return qualifiers + type_name + ' ' + array_name + '[' + str(array_size) + '] __attribute__((aligned(4))) ' + \
+        '__attribute__((visibility("hidden")))=\n{\n' + '\n'.join(lines) + '\n};\n'
+
+
 class SpriteItem:
 
     @staticmethod
@@ -215,6 +743,26 @@ class SpriteItem:
             except KeyError:
                 self.__palette_compression = 'none'
 
+        try:
+            self.__delta_frames = bool(info['delta_frames'])
+        except KeyError:
+            self.__delta_frames = False
+
+        try:
+            self.__delta_frames_max_runs = int(info['delta_frames_max_runs'])
+
+            if self.__delta_frames_max_runs < 1:
+                raise ValueError('Invalid delta frames max runs: ' + str(self.__delta_frames_max_runs))
+        except KeyError:
+            self.__delta_frames_max_runs = 32
+
+        if self.__delta_frames:
+            if self.__graphics == 1:
+                raise ValueError('Delta frames require more than one sprite image')
+
+            if self.__tiles_compression != 'none':
+                raise ValueError('Delta frames with compressed tiles not supported: ' + self.__tiles_compression)
+
     def process(self, grit):
         tiles_compression = self.__tiles_compression
         palette_compression = self.__palette_compression
@@ -230,6 +778,8 @@ class SpriteItem:
                 tiles_compression, file_size = self.__test_tiles_compression(grit, tiles_compression, 'huffman',
                                                                              file_size)
 
+            tiles_compression, file_size = self.__test_tiles_compression(grit, tiles_compression, 'fast_lz', file_size)
+
         if palette_compression.startswith('auto'):
             test_huffman = palette_compression == 'auto'
             palette_compression, file_size = self.__test_palette_compression(grit, palette_compression, 'none', None)
@@ -242,6 +792,9 @@ class SpriteItem:
                 palette_compression, file_size = self.__test_palette_compression(grit, palette_compression, 'huffman',
                                                                                  file_size)
 
+            palette_compression, file_size = self.__test_palette_compression(grit, palette_compression, 'fast_lz',
+                                                                             file_size)
+
         self.__execute_command(grit, tiles_compression, palette_compression)
         return self.__write_header(tiles_compression, palette_compression, False)
 
@@ -249,7 +802,11 @@ class SpriteItem:
         self.__execute_command(grit, new_tiles_compression, 'none')
         new_file_size = self.__write_header(new_tiles_compression, 'none', True)
 
-        if best_file_size is None or new_file_size < best_file_size:
+        if new_tiles_compression == 'none':
+            self.__uncompressed_file_size = new_file_size
+
+        if better_compression(best_tiles_compression, best_file_size, new_tiles_compression, new_file_size,
+                              self.__uncompressed_file_size):
             return new_tiles_compression, new_file_size
 
         return best_tiles_compression, best_file_size
@@ -258,7 +815,11 @@ class SpriteItem:
         self.__execute_command(grit, 'none', new_palette_compression)
         new_file_size = self.__write_header('none', new_palette_compression, True)
 
-        if best_file_size is None or new_file_size < best_file_size:
+        if new_palette_compression == 'none':
+            self.__uncompressed_file_size = new_file_size
+
+        if better_compression(best_palette_compression, best_file_size, new_palette_compression, new_file_size,
+                              self.__uncompressed_file_size):
             return new_palette_compression, new_file_size
 
         return best_palette_compression, best_file_size
@@ -270,6 +831,9 @@ class SpriteItem:
 
         with open(grit_file_path, 'r') as grit_file:
             grit_data = grit_file.read()
+            grit_data = fast_lz_compress_grit_arrays(grit_data, name, [('Tiles', tiles_compression),
+                                                                       ('Pal', palette_compression)],
+                                                     not skip_write)
             grit_data = grit_data.replace('unsigned int', 'bn::tile')
             grit_data = grit_data.replace('unsigned short', 'bn::color')
 
@@ -300,6 +864,26 @@ class SpriteItem:
 
         grit_data = re.sub(r'Tiles\[([0-9]+)]', 'Tiles[' + str(tiles_count) + ']', grit_data)
         grit_data = re.sub(r'Pal\[([0-9]+)]', 'Pal[' + str(self.__colors_count) + ']', grit_data)
+        graphics = self.__graphics
+        tiles_item_count = tiles_count
+
+        if self.__delta_frames:
+            # Only the first tile set and the changed tiles of each tile set are stored:
+            tiles_data = parse_grit_array(grit_data, name + '_bn_gfxTiles')
+            delta_tiles_data, runs, runs_indexes, max_graphics_runs = sprite_tiles_deltas(
+                tiles_data, graphics, self.__delta_frames_max_runs)
+            delta_tiles_count = int(len(delta_tiles_data) / 8)
+            tiles_array = write_array('bn::tile', name + '_bn_gfxTiles', delta_tiles_count, delta_tiles_data, 8)
+            grit_data = re.sub(r'const bn::tile ' + name + r'_bn_gfxTiles\[[0-9]+][^;]*;\n', lambda _: tiles_array,
+                               grit_data)
+            grit_data = re.sub(r'(' + name + r'_bn_gfxTilesLen )([0-9]+)', r'\g<1>' + str(delta_tiles_count * 32),
+                               grit_data)
+            grit_data += '\n' + write_array('uint32_t', name + '_bn_gfxDeltaRuns', max(len(runs), 1),
+                                            runs if len(runs) > 0 else [0], 8)
+            grit_data += '\n' + write_array('uint16_t', name + '_bn_gfxDeltaRunsIndexes', len(runs_indexes),
+                                            runs_indexes, 4)
+            tiles_item_count = int(tiles_count / graphics)
+            graphics = 1
 
         with open(header_file_path, 'w') as header_file:
             include_guard = 'BN_SPRITE_ITEMS_' + name.upper() + '_H'
@@ -307,6 +891,11 @@ class SpriteItem:
             header_file.write('#define ' + include_guard + '\n')
             header_file.write('\n')
             header_file.write('#include "bn_sprite_item.h"' + '\n')
+
+            if self.__delta_frames:
+                header_file.write('#include "bn_config_sprite_tiles.h"' + '\n')
+                header_file.write('#include "bn_sprite_tiles_delta_item.h"' + '\n')
+
             header_file.write(grit_data)
             header_file.write('\n')
             header_file.write('namespace bn::sprite_items' + '\n')
@@ -315,13 +904,33 @@ class SpriteItem:
                               'sprite_shape_size(sprite_shape::' + self.__shape + ', ' +
                               'sprite_size::' + self.__size + '), ' + '\n            ' +
                               'sprite_tiles_item(span<const tile>(' + name + '_bn_gfxTiles, ' +
-                              str(tiles_count) + '), ' + bpp_mode_label + ', ' + compression_label(tiles_compression) +
-                              ', ' + str(self.__graphics) + '), ' + '\n            ' +
+                              str(tiles_item_count) + '), ' + bpp_mode_label + ', ' +
+                              compression_label(tiles_compression) + ', ' + str(graphics) + '), ' + '\n            ' +
                               'sprite_palette_item(span<const color>(' + name + '_bn_gfxPal, ' +
                               str(self.__colors_count) + '), ' + bpp_mode_label + ', ' +
                               compression_label(palette_compression) + '));\n')
             header_file.write('}' + '\n')
             header_file.write('\n')
+
+            if self.__delta_frames:
+                header_file.write('namespace bn::sprite_tiles_delta_items' + '\n')
+                header_file.write('{' + '\n')
+                header_file.write('    constexpr inline sprite_tiles_delta_item ' + name + '(' +
+                                  'span<const tile>(' + name + '_bn_gfxTiles, ' + str(delta_tiles_count) + '), ' +
+                                  '\n            ' +
+                                  'span<const uint32_t>(' + name + '_bn_gfxDeltaRuns, ' + str(len(runs)) + '), ' +
+                                  'span<const uint16_t>(' + name + '_bn_gfxDeltaRunsIndexes, ' +
+                                  str(len(runs_indexes)) + '), ' + '\n            ' +
+                                  bpp_mode_label + ', ' + str(tiles_item_count) + ', ' + str(max_graphics_runs) +
+                                  ');\n')
+                header_file.write('\n')
+                header_file.write('    static_assert(' + str(max_graphics_runs) + ' <= ' +
+                                  'BN_CFG_SPRITE_TILES_MAX_DELTA_RUNS, "' + name + ' delta frames need more runs ' +
+                                  'per frame than BN_CFG_SPRITE_TILES_MAX_DELTA_RUNS ' +
+                                  '(reduce delta_frames_max_runs)");\n')
+                header_file.write('}' + '\n')
+                header_file.write('\n')
+
             header_file.write('#endif' + '\n')
             header_file.write('\n')
 
@@ -392,6 +1001,8 @@ class SpriteTilesItem:
             if test_huffman:
                 compression, file_size = self.__test_compression(grit, compression, 'huffman', file_size)
 
+            compression, file_size = self.__test_compression(grit, compression, 'fast_lz', file_size)
+
         self.__execute_command(grit, compression)
         return self.__write_header(compression, False)
 
@@ -399,7 +1010,11 @@ class SpriteTilesItem:
         self.__execute_command(grit, new_compression)
         new_file_size = self.__write_header(new_compression, True)
 
-        if best_file_size is None or new_file_size < best_file_size:
+        if new_compression == 'none':
+            self.__uncompressed_file_size = new_file_size
+
+        if better_compression(best_compression, best_file_size, new_compression, new_file_size,
+                              self.__uncompressed_file_size):
             return new_compression, new_file_size
 
         return best_compression, best_file_size
@@ -411,6 +1026,8 @@ class SpriteTilesItem:
 
         with open(grit_file_path, 'r') as grit_file:
             grit_data = grit_file.read()
+            grit_data = fast_lz_compress_grit_arrays(grit_data, name, [('Tiles', compression)],
+                                                     not skip_write)
             grit_data = grit_data.replace('unsigned int', 'bn::tile')
 
             for grit_line in grit_data.splitlines():
@@ -512,6 +1129,8 @@ class SpritePaletteItem:
             if test_huffman:
                 compression, file_size = self.__test_compression(grit, compression, 'huffman', file_size)
 
+            compression, file_size = self.__test_compression(grit, compression, 'fast_lz', file_size)
+
         self.__execute_command(grit, compression)
         return self.__write_header(compression, False)
 
@@ -519,7 +1138,11 @@ class SpritePaletteItem:
         self.__execute_command(grit, new_compression)
         new_file_size = self.__write_header(new_compression, True)
 
-        if best_file_size is None or new_file_size < best_file_size:
+        if new_compression == 'none':
+            self.__uncompressed_file_size = new_file_size
+
+        if better_compression(best_compression, best_file_size, new_compression, new_file_size,
+                              self.__uncompressed_file_size):
             return new_compression, new_file_size
 
         return best_compression, best_file_size
@@ -531,6 +1154,8 @@ class SpritePaletteItem:
 
         with open(grit_file_path, 'r') as grit_file:
             grit_data = grit_file.read()
+            grit_data = fast_lz_compress_grit_arrays(grit_data, name, [('Pal', compression)],
+                                                     not skip_write)
             grit_data = grit_data.replace('unsigned short', 'bn::color')
 
             for grit_line in grit_data.splitlines():
@@ -711,7 +1336,78 @@ class RegularBgItem:
             except KeyError:
                 self.__map_compression = 'none'
 
+        try:
+            self.__streaming_region_size = int(info['streaming_region_size'])
+            streaming_region_size = self.__streaming_region_size
+
+            if streaming_region_size <= 0 or streaming_region_size % 256 != 0:
+                raise ValueError('Streaming region size must be divisible by 256: ' + str(streaming_region_size))
+
+            if width % streaming_region_size != 0 or height % streaming_region_size != 0:
+                raise ValueError('Regular BGs size must be divisible by streaming region size: ' + str(width) +
+                                 ' - ' + str(height) + ' - ' + str(streaming_region_size))
+
+            regions_columns = int(width / streaming_region_size)
+            regions_rows = int(height / streaming_region_size)
+
+            if (regions_columns > 1 and regions_columns % 2 != 0) or (regions_rows > 1 and regions_rows % 2 != 0):
+                raise ValueError('Invalid streaming regions count: ' + str(regions_columns) + ' - ' +
+                                 str(regions_rows))
+
+            if self.__maps > 1:
+                raise ValueError('Streaming regions with more than one map not supported: ' + str(self.__maps))
+
+            if not self.__big:
+                if 'big' in info:
+                    raise ValueError('Streaming regions are only supported in big maps')
+
+                if width == 256 and height == 256:
+                    raise ValueError('Too small size for a big regular BG: ' + str(width) + ' - ' + str(height))
+
+                self.__big = True
+                self.__sbb = False
+
+            if self.__tiles_compression != 'none' and not self.__tiles_compression.startswith('auto'):
+                raise ValueError('Streaming regions tiles compression not supported: ' + self.__tiles_compression)
+
+            self.__tiles_compression = 'none'
+        except KeyError:
+            self.__streaming_region_size = None
+
+        try:
+            self.__tiles_group = str(info['tiles_group'])
+            validate_tiles_group(self.__tiles_group)
+
+            if self.__streaming_region_size is not None:
+                raise ValueError('Tiles groups with streaming regions not supported')
+
+            if not self.__repeated_tiles_reduction:
+                raise ValueError('Tiles groups without repeated tiles reduction not supported')
+
+            if self.__tiles_compression != 'none' and not self.__tiles_compression.startswith('auto'):
+                raise ValueError('Tiles groups tiles compression not supported: ' + self.__tiles_compression)
+
+            if self.__map_compression == 'huffman':
+                raise ValueError('Huffman compression not supported in tiles groups')
+
+            self.__tiles_compression = 'none'
+        except KeyError:
+            self.__tiles_group = None
+
+        # Compressed big maps are split in chunks which can be decompressed independently:
+        self.__map_chunks = self.__big and self.__map_compression != 'none'
+
+        if self.__map_chunks:
+            if self.__map_compression == 'huffman':
+                raise ValueError('Huffman compression not supported in big maps')
+
+            if self.__maps > 1:
+                raise ValueError('Compressed big maps with more than one map not supported: ' + str(self.__maps))
+
     def process(self, grit):
+        if self.__streaming_region_size is not None:
+            return self.__process_streaming(grit)
+
         tiles_compression = self.__tiles_compression
         palette_compression = self.__palette_compression
         map_compression = self.__map_compression
@@ -727,6 +1423,110 @@ class RegularBgItem:
                 tiles_compression, file_size = self.__test_tiles_compression(grit, tiles_compression, 'huffman',
                                                                              file_size)
 
+            tiles_compression, file_size = self.__test_tiles_compression(grit, tiles_compression, 'fast_lz', file_size)
+
+        palette_compression = self.__select_palette_compression(grit, palette_compression)
+
+        if map_compression.startswith('auto') and not self.__map_chunks:
+            test_huffman = map_compression == 'auto'
+            map_compression, file_size = self.__test_map_compression(grit, map_compression, 'none', None)
+            map_compression, file_size = self.__test_map_compression(grit, map_compression, 'run_length', file_size)
+            map_compression, file_size = self.__test_map_compression(grit, map_compression, 'lz77', file_size)
+
+            if test_huffman:
+                map_compression, file_size = self.__test_map_compression(grit, map_compression, 'huffman', file_size)
+
+            map_compression, file_size = self.__test_map_compression(grit, map_compression, 'fast_lz', file_size)
+
+        self.__execute_command(grit, tiles_compression, palette_compression, map_compression)
+        return self.__write_header(tiles_compression, palette_compression, map_compression, False)
+
+    def tiles_group(self):
+        return self.__tiles_group
+
+    def bpp_8(self):
+        return self.__bpp_8
+
+    def process_tiles_group_member(self, grit):
+        # Tiles and map are not compressed, since they are rewritten when the tiles group is reduced:
+        palette_compression = self.__select_palette_compression(grit, self.__palette_compression)
+        self.__execute_command(grit, 'none', palette_compression, 'none')
+
+        name = self.__file_name_no_ext
+        grit_file_path = self.__build_folder_path + '/' + name + '_bn_gfx.h'
+
+        with open(grit_file_path, 'r') as grit_file:
+            grit_data = grit_file.read()
+
+        remove_file(grit_file_path)
+        self.__tiles_group_grit_data = grit_data
+        self.__tiles_group_palette_compression = palette_compression
+
+        tiles_data = parse_grit_array(grit_data, name + '_bn_gfxTiles')
+        tile_words = 16 if self.__bpp_8 else 8
+        tiles = [tuple(tiles_data[index:index + tile_words]) for index in range(0, len(tiles_data), tile_words)]
+        cells = parse_grit_array(grit_data, name + '_bn_gfxMap')
+        return tiles, cells, self.__flipped_tiles_reduction
+
+    def write_tiles_group_member_header(self, cells):
+        name = self.__file_name_no_ext
+        header_file_path = self.__build_folder_path + '/bn_regular_bg_items_' + name + '.h'
+        grit_data = self.__tiles_group_grit_data
+        palette_compression = self.__tiles_group_palette_compression
+        map_compression = self.__map_compression
+
+        # Tiles are stored in the tiles group header:
+        tiles_size = len(parse_grit_array(grit_data, name + '_bn_gfxTiles')) * 4
+        grit_data = re.sub(r'^.*' + name + r'_bn_gfxTiles\[[0-9]+][^{]*\{[^}]*}\s*;[ \t]*\n', '', grit_data,
+                           flags=re.MULTILINE)
+        grit_data = re.sub(r'^#define ' + name + r'_bn_gfxTilesLen .*\n', '', grit_data, flags=re.MULTILINE)
+        grit_data = replace_grit_array_values(grit_data, name + '_bn_gfxMap', cells, 4)
+
+        if not self.__map_chunks:
+            if map_compression.startswith('auto'):
+                map_data = bytearray()
+
+                for cell in cells:
+                    map_data.extend(cell.to_bytes(2, 'little'))
+
+                map_compression = 'none'
+                file_size = len(map_data)
+
+                for new_compression in ['run_length', 'lz77', 'fast_lz']:
+                    new_file_size = len(compress_data(map_data, new_compression))
+
+                    if better_compression(map_compression, file_size, new_compression, new_file_size, len(map_data)):
+                        map_compression = new_compression
+                        file_size = new_file_size
+
+            grit_data = compress_grit_arrays(grit_data, name, [('Map', map_compression)])
+
+        grit_data = fast_lz_compress_grit_arrays(grit_data, name, [('Pal', palette_compression)])
+        grit_data = grit_data.replace('unsigned short', 'bn::regular_bg_map_cell', 1)
+
+        if self.__palette_item is None:
+            grit_data = grit_data.replace('unsigned short', 'bn::color', 1)
+
+        total_size = None
+
+        for grit_line in grit_data.splitlines():
+            if 'Total size:' in grit_line:
+                total_size = int(grit_line.split()[-1]) - tiles_size
+                break
+
+        if total_size is None:
+            raise ValueError('Total size not found in grit output: ' + name)
+
+        grit_data = re.sub(r'Pal\[([0-9]+)]', 'Pal[' + str(self.__colors_count) + ']', grit_data)
+
+        if self.__map_chunks:
+            grit_data, map_compression = self.__write_map_chunks(grit_data, map_compression)
+
+        tiles_item = 'bn::regular_bg_tiles_items::' + self.__tiles_group
+        self.__write_item_header(header_file_path, grit_data, tiles_item, palette_compression, map_compression)
+        return total_size, header_file_path
+
+    def __select_palette_compression(self, grit, palette_compression):
         if palette_compression.startswith('auto'):
             test_huffman = palette_compression == 'auto'
             palette_compression, file_size = self.__test_palette_compression(grit, palette_compression, 'none', None)
@@ -739,23 +1539,20 @@ class RegularBgItem:
                 palette_compression, file_size = self.__test_palette_compression(grit, palette_compression, 'huffman',
                                                                                  file_size)
 
-        if map_compression.startswith('auto'):
-            test_huffman = map_compression == 'auto'
-            map_compression, file_size = self.__test_map_compression(grit, map_compression, 'none', None)
-            map_compression, file_size = self.__test_map_compression(grit, map_compression, 'run_length', file_size)
-            map_compression, file_size = self.__test_map_compression(grit, map_compression, 'lz77', file_size)
-
-            if test_huffman:
-                map_compression, file_size = self.__test_map_compression(grit, map_compression, 'huffman', file_size)
+            palette_compression, file_size = self.__test_palette_compression(grit, palette_compression, 'fast_lz',
+                                                                             file_size)
 
-        self.__execute_command(grit, tiles_compression, palette_compression, map_compression)
-        return self.__write_header(tiles_compression, palette_compression, map_compression, False)
+        return palette_compression
 
     def __test_tiles_compression(self, grit, best_tiles_compression, new_tiles_compression, best_file_size):
         self.__execute_command(grit, new_tiles_compression, 'none', 'none')
         new_file_size = self.__write_header(new_tiles_compression, 'none', 'none', True)
 
-        if best_file_size is None or new_file_size < best_file_size:
+        if new_tiles_compression == 'none':
+            self.__uncompressed_file_size = new_file_size
+
+        if better_compression(best_tiles_compression, best_file_size, new_tiles_compression, new_file_size,
+                              self.__uncompressed_file_size):
             return new_tiles_compression, new_file_size
 
         return best_tiles_compression, best_file_size
@@ -764,7 +1561,11 @@ class RegularBgItem:
         self.__execute_command(grit, 'none', new_palette_compression, 'none')
         new_file_size = self.__write_header('none', new_palette_compression, 'none', True)
 
-        if best_file_size is None or new_file_size < best_file_size:
+        if new_palette_compression == 'none':
+            self.__uncompressed_file_size = new_file_size
+
+        if better_compression(best_palette_compression, best_file_size, new_palette_compression, new_file_size,
+                              self.__uncompressed_file_size):
             return new_palette_compression, new_file_size
 
         return best_palette_compression, best_file_size
@@ -773,7 +1574,11 @@ class RegularBgItem:
         self.__execute_command(grit, 'none', 'none', new_map_compression)
         new_file_size = self.__write_header('none', 'none', new_map_compression, True)
 
-        if best_file_size is None or new_file_size < best_file_size:
+        if new_map_compression == 'none':
+            self.__uncompressed_file_size = new_file_size
+
+        if better_compression(best_map_compression, best_file_size, new_map_compression, new_file_size,
+                              self.__uncompressed_file_size):
             return new_map_compression, new_file_size
 
         return best_map_compression, best_file_size
@@ -785,6 +1590,11 @@ class RegularBgItem:
 
         with open(grit_file_path, 'r') as grit_file:
             grit_data = grit_file.read()
+            map_array_compression = 'none' if self.__map_chunks else map_compression
+            grit_data = fast_lz_compress_grit_arrays(grit_data, name, [('Tiles', tiles_compression),
+                                                                       ('Pal', palette_compression),
+                                                                       ('Map', map_array_compression)],
+                                                     not skip_write)
             grit_data = grit_data.replace('unsigned int', 'bn::tile', 1)
             grit_data = grit_data.replace('unsigned short', 'bn::regular_bg_map_cell', 1)
 
@@ -822,12 +1632,28 @@ class RegularBgItem:
         grit_data = re.sub(r'Tiles\[([0-9]+)]', 'Tiles[' + str(tiles_count) + ']', grit_data)
         grit_data = re.sub(r'Pal\[([0-9]+)]', 'Pal[' + str(self.__colors_count) + ']', grit_data)
 
+        if self.__map_chunks:
+            grit_data, map_compression = self.__write_map_chunks(grit_data, map_compression)
+
+        tiles_item = 'regular_bg_tiles_item(span<const tile>(' + name + '_bn_gfxTiles, ' + str(tiles_count) + '), ' + \
+            bpp_mode_label + ', ' + compression_label(tiles_compression) + ')'
+        self.__write_item_header(header_file_path, grit_data, tiles_item, palette_compression, map_compression)
+        return total_size, header_file_path
+
+    def __write_item_header(self, header_file_path, grit_data, tiles_item, palette_compression, map_compression):
+        name = self.__file_name_no_ext
+        bpp_mode_label = 'bpp_mode::BPP_8' if self.__bpp_8 else 'bpp_mode::BPP_4'
+
         with open(header_file_path, 'w') as header_file:
             include_guard = 'BN_REGULAR_BG_ITEMS_' + name.upper() + '_H'
             header_file.write('#ifndef ' + include_guard + '\n')
             header_file.write('#define ' + include_guard + '\n')
             header_file.write('\n')
             header_file.write('#include "bn_regular_bg_item.h"' + '\n')
+
+            if self.__tiles_group is not None:
+                header_file.write('#include "bn_regular_bg_tiles_items_' + self.__tiles_group + '.h"' + '\n')
+
             header_file.write(grit_data)
             header_file.write('\n')
 
@@ -838,9 +1664,7 @@ class RegularBgItem:
             header_file.write('namespace bn::regular_bg_items' + '\n')
             header_file.write('{' + '\n')
             header_file.write('    constexpr inline regular_bg_item ' + name + '(' + '\n            ' +
-                              'regular_bg_tiles_item(span<const tile>(' + name + '_bn_gfxTiles, ' +
-                              str(tiles_count) + '), ' + bpp_mode_label + ', ' + compression_label(tiles_compression) +
-                              '), ' + '\n            ')
+                              tiles_item + ', ' + '\n            ')
 
             if self.__palette_item is None:
                 header_file.write('bg_palette_item(span<const color>(' + name + '_bn_gfxPal, ' +
@@ -858,10 +1682,177 @@ class RegularBgItem:
             header_file.write('#endif' + '\n')
             header_file.write('\n')
 
+    def __process_streaming(self, grit):
+        name = self.__file_name_no_ext
+        grit_file_path = self.__build_folder_path + '/' + name + '_bn_gfx.h'
+        region_file_path = self.__build_folder_path + '/' + name + '.bn_region.bmp'
+        header_file_path = self.__build_folder_path + '/bn_regular_bg_items_' + name + '.h'
+        region_size = self.__streaming_region_size
+        region_cells = int(region_size / 8)
+        regions_columns = int(self.__width / region_cells)
+        regions_rows = int(self.__height / region_cells)
+        palette_compression = self.__palette_compression
+        map_compression = self.__map_compression
+        bmp = BMP(self.__file_path)
+        tiles = []
+        regions_first_tile = []
+        cells = [0] * (self.__width * self.__height)
+        palette_data = None
+        bank_tiles_count = 0
+
+        if palette_compression.startswith('auto'):
+            palette_compression = 'none'
+
+        # Each region is converted separately, so its cells reference its own tiles only:
+        for region_y in range(regions_rows):
+            for region_x in range(regions_columns):
+                bmp.crop(region_x * region_size, region_y * region_size, region_size, region_size, region_file_path)
+                self.__execute_command(grit, 'none', palette_compression, 'none', region_file_path)
+
+                with open(grit_file_path, 'r') as grit_file:
+                    grit_data = grit_file.read()
+
+                remove_file(grit_file_path)
+
+                if palette_data is None and self.__palette_item is None:
+                    palette_match = re.search(r'const unsigned short ' + name + r'_bn_gfxPal\[[0-9]+][^;]*;', grit_data)
+
+                    if palette_match is None:
+                        raise ValueError('Palette not found in grit output: ' + name)
+
+                    palette_data = palette_match.group(0).replace('unsigned short', 'bn::color', 1)
+                    palette_data = re.sub(r'Pal\[([0-9]+)]', 'Pal[' + str(self.__colors_count) + ']', palette_data)
+
+                region_tiles = parse_grit_array(grit_data, name + '_bn_gfxTiles')
+                region_tiles_count = int(len(region_tiles) / 8)
+                regions_first_tile.append(int(len(tiles) / 8))
+                tiles.extend(region_tiles)
+                bank_tiles_count = max(bank_tiles_count, region_tiles_count)
+
+                region_map = parse_grit_array(grit_data, name + '_bn_gfxMap')
+
+                for region_row in range(region_cells):
+                    map_index = (((region_y * region_cells) + region_row) * self.__width) + (region_x * region_cells)
+                    region_map_index = region_row * region_cells
+                    cells[map_index:map_index + region_cells] = region_map[region_map_index:region_map_index +
+                                                                           region_cells]
+
+        remove_file(region_file_path)
+        regions_first_tile.append(int(len(tiles) / 8))
+
+        if self.__bpp_8:
+            bpp_mode_label = 'bpp_mode::BPP_8'
+            max_bank_tiles_count = 512
+        else:
+            bpp_mode_label = 'bpp_mode::BPP_4'
+            max_bank_tiles_count = 256
+
+        if bank_tiles_count > max_bank_tiles_count:
+            raise ValueError('Streaming regions with more than ' + str(max_bank_tiles_count) +
+                             ' tiles not supported: ' + str(bank_tiles_count))
+
+        # Tiles used to create the VRAM banks:
+        vram_tiles_count = bank_tiles_count * 4
+
+        while len(tiles) < vram_tiles_count * 8:
+            tiles.append(0)
+
+        tiles_count = int(len(tiles) / 8)
+
+        if map_compression != 'none':
+            cells = big_map_chunks_compress(cells, self.__width, self.__height, map_compression)
+
+            if map_compression != 'run_length' and map_compression != 'fast_lz':
+                map_compression = 'lz77'
+
+        total_size = (len(tiles) * 4) + (len(regions_first_tile) * 4) + (len(cells) * 2)
+
+        if self.__palette_item is None:
+            total_size += self.__colors_count * 2
+
+        with open(header_file_path, 'w') as header_file:
+            include_guard = 'BN_REGULAR_BG_ITEMS_' + name.upper() + '_H'
+            header_file.write('#ifndef ' + include_guard + '\n')
+            header_file.write('#define ' + include_guard + '\n')
+            header_file.write('\n')
+            header_file.write('#include "bn_regular_bg_item.h"' + '\n')
+            header_file.write('\n')
+            header_file.write(write_array('bn::tile', name + '_bn_gfxTiles', tiles_count, tiles, 8))
+            header_file.write('\n')
+            header_file.write(write_array('uint32_t', name + '_bn_gfxRegions', len(regions_first_tile),
+                                          regions_first_tile, 8))
+            header_file.write('\n')
+            header_file.write(write_array('bn::regular_bg_map_cell', name + '_bn_gfxMap', len(cells), cells, 4))
+            header_file.write('\n')
+
+            if self.__palette_item is None:
+                header_file.write(palette_data + '\n')
+                header_file.write('\n')
+            else:
+                header_file.write('#include "bn_bg_palette_items_' + self.__palette_item + '.h"' + '\n')
+                header_file.write('\n')
+
+            header_file.write('namespace bn::regular_bg_items' + '\n')
+            header_file.write('{' + '\n')
+            header_file.write('    constexpr inline regular_bg_streaming_tiles_item ' + name + '_streaming_tiles(' +
+                              '\n            ' +
+                              'span<const tile>(' + name + '_bn_gfxTiles, ' + str(tiles_count) + '), ' +
+                              'span<const uint32_t>(' + name + '_bn_gfxRegions, ' + str(len(regions_first_tile)) +
+                              '), ' + '\n            ' +
+                              'size(' + str(region_cells) + ', ' + str(region_cells) + '), ' +
+                              str(bank_tiles_count) + ');' + '\n')
+            header_file.write('\n')
+            header_file.write('    constexpr inline regular_bg_item ' + name + '(' + '\n            ' +
+                              'regular_bg_tiles_item(span<const tile>(' + name + '_bn_gfxTiles, ' +
+                              str(vram_tiles_count) + '), ' + bpp_mode_label + ', ' + compression_label('none') +
+                              '), ' + '\n            ')
+
+            if self.__palette_item is None:
+                header_file.write('bg_palette_item(span<const color>(' + name + '_bn_gfxPal, ' +
+                                  str(self.__colors_count) + '), ' + bpp_mode_label + ', ' +
+                                  compression_label(palette_compression) + '),' + '\n            ')
+            else:
+                header_file.write('bn::bg_palette_items::' + self.__palette_item + ',' + '\n            ')
+
+            header_file.write('regular_bg_map_item(' + name + '_bn_gfxMap[0], ' +
+                              'size(' + str(self.__width) + ', ' + str(self.__height) + '), ' +
+                              compression_label(map_compression) + ', ' + name + '_streaming_tiles));' + '\n')
+            header_file.write('}' + '\n')
+            header_file.write('\n')
+            header_file.write('#endif' + '\n')
+            header_file.write('\n')
+
         return total_size, header_file_path
 
-    def __execute_command(self, grit, tiles_compression, palette_compression, map_compression):
-        command = [grit, self.__file_path]
+    def __write_map_chunks(self, grit_data, map_compression):
+        map_pattern = re.compile(r'(' + self.__file_name_no_ext + r'_bn_gfxMap\[)([0-9]+)(\][^{]*\{)([^}]*)(})')
+        map_match = map_pattern.search(grit_data)
+
+        if map_match is None:
+            raise ValueError('Map data not found in grit output: ' + self.__file_name_no_ext)
+
+        cells = [int(cell, 16) for cell in map_match.group(4).replace(',', ' ').split()]
+        chunks = big_map_chunks_compress(cells, self.__width, self.__height, map_compression)
+        chunks_lines = []
+
+        for line_index in range(0, len(chunks), 8):
+            line_chunks = chunks[line_index:line_index + 8]
+            chunks_lines.append('\t' + ','.join('0x{:04X}'.format(half_word) for half_word in line_chunks) + ',')
+
+        chunks_data = '\n' + '\n'.join(chunks_lines) + '\n'
+        grit_data = grit_data[:map_match.start()] + map_match.group(1) + str(len(chunks)) + map_match.group(3) + \
+            chunks_data + map_match.group(5) + grit_data[map_match.end():]
+
+        if map_compression == 'run_length' or map_compression == 'fast_lz':
+            return grit_data, map_compression
+
+        return grit_data, 'lz77'
+
+    def __execute_command(self, grit, tiles_compression, palette_compression, map_compression, file_path=None):
+        if file_path is None:
+            file_path = self.__file_path
+
+        command = [grit, file_path]
 
         if self.__colors_count > 0:
             command.append('-pe' + str(self.__colors_count))
@@ -896,7 +1887,10 @@ class RegularBgItem:
 
         append_compression_command('g', tiles_compression, command)
         append_compression_command('p', palette_compression, command)
-        append_compression_command('m', map_compression, command)
+
+        if not self.__map_chunks:
+            append_compression_command('m', map_compression, command)
+
         command.append('-o' + self.__build_folder_path + '/' + self.__file_name_no_ext + '_bn_gfx')
         command = ' '.join(command)
 
@@ -953,6 +1947,8 @@ class RegularBgTilesItem:
                 tiles_compression, file_size = self.__test_tiles_compression(grit, tiles_compression, 'huffman',
                                                                              file_size)
 
+            tiles_compression, file_size = self.__test_tiles_compression(grit, tiles_compression, 'fast_lz', file_size)
+
         if palette_compression.startswith('auto'):
             test_huffman = palette_compression == 'auto'
             palette_compression, file_size = self.__test_palette_compression(grit, palette_compression, 'none', None)
@@ -965,6 +1961,9 @@ class RegularBgTilesItem:
                 palette_compression, file_size = self.__test_palette_compression(grit, palette_compression, 'huffman',
                                                                                  file_size)
 
+            palette_compression, file_size = self.__test_palette_compression(grit, palette_compression, 'fast_lz',
+                                                                             file_size)
+
         self.__execute_command(grit, tiles_compression, palette_compression)
         return self.__write_header(tiles_compression, palette_compression, False)
 
@@ -972,7 +1971,11 @@ class RegularBgTilesItem:
         self.__execute_command(grit, new_compression, 'none')
         new_file_size = self.__write_header(new_compression, 'none', True)
 
-        if best_file_size is None or new_file_size < best_file_size:
+        if new_compression == 'none':
+            self.__uncompressed_file_size = new_file_size
+
+        if better_compression(best_compression, best_file_size, new_compression, new_file_size,
+                              self.__uncompressed_file_size):
             return new_compression, new_file_size
 
         return best_compression, best_file_size
@@ -981,7 +1984,11 @@ class RegularBgTilesItem:
         self.__execute_command(grit, 'none', new_compression)
         new_file_size = self.__write_header('none', new_compression, True)
 
-        if best_file_size is None or new_file_size < best_file_size:
+        if new_compression == 'none':
+            self.__uncompressed_file_size = new_file_size
+
+        if better_compression(best_compression, best_file_size, new_compression, new_file_size,
+                              self.__uncompressed_file_size):
             return new_compression, new_file_size
 
         return best_compression, best_file_size
@@ -993,6 +2000,9 @@ class RegularBgTilesItem:
 
         with open(grit_file_path, 'r') as grit_file:
             grit_data = grit_file.read()
+            grit_data = fast_lz_compress_grit_arrays(grit_data, name, [('Tiles', tiles_compression),
+                                                                       ('Pal', palette_compression)],
+                                                     not skip_write)
             grit_data = grit_data.replace('unsigned int', 'bn::tile', 1)
 
             if self.__generate_palette:
@@ -1090,6 +2100,73 @@ class RegularBgTilesItem:
             raise ValueError(grit + ' call failed (return code ' + str(e.returncode) + '): ' + str(e.output))
 
 
+class RegularBgTilesGroup:
+
+    def __init__(self, name, build_folder_path, items):
+        self.__name = name
+        self.__build_folder_path = build_folder_path
+        self.__items = items
+        self.__bpp_8 = items[0].bpp_8()
+
+        for item in items:
+            if item.bpp_8() != self.__bpp_8:
+                raise ValueError('Tiles groups with different BPP modes not supported: ' + name)
+
+    def process(self, grit):
+        members_tiles = []
+        members_cells = []
+        members_flipped_tiles_reduction = []
+
+        for item in self.__items:
+            tiles, cells, flipped_tiles_reduction = item.process_tiles_group_member(grit)
+            members_tiles.append(tiles)
+            members_cells.append(cells)
+            members_flipped_tiles_reduction.append(flipped_tiles_reduction)
+
+        shared_tiles, members_shared_cells = tiles_group_reduce(members_tiles, members_cells,
+                                                                members_flipped_tiles_reduction)
+        results = [self.__write_header(shared_tiles)]
+
+        for item, shared_cells in zip(self.__items, members_shared_cells):
+            results.append(item.write_tiles_group_member_header(shared_cells))
+
+        return results
+
+    def __write_header(self, shared_tiles):
+        name = self.__name
+        header_file_path = self.__build_folder_path + '/bn_regular_bg_tiles_items_' + name + '.h'
+        tiles_data = [word for tile in shared_tiles for word in tile]
+        tiles_count = int(len(tiles_data) / 8)
+
+        if self.__bpp_8:
+            bpp_mode_label = 'bpp_mode::BPP_8'
+        else:
+            bpp_mode_label = 'bpp_mode::BPP_4'
+
+        with open(header_file_path, 'w') as header_file:
+            include_guard = 'BN_REGULAR_BG_TILES_ITEMS_' + name.upper() + '_H'
+            header_file.write('#ifndef ' + include_guard + '\n')
+            header_file.write('#define ' + include_guard + '\n')
+            header_file.write('\n')
+            header_file.write('#include "bn_regular_bg_tiles_item.h"' + '\n')
+            header_file.write('\n')
+
+            # The tiles array is inline, so all BGs of the group reference the same tiles in VRAM:
+            header_file.write(write_array('bn::tile', name + '_bn_gfxTiles', tiles_count, tiles_data, 8, True))
+            header_file.write('\n')
+            header_file.write('namespace bn::regular_bg_tiles_items' + '\n')
+            header_file.write('{' + '\n')
+            header_file.write('    constexpr inline regular_bg_tiles_item ' + name + '(' + '\n            ' +
+                              'span<const tile>(' + name + '_bn_gfxTiles, ' + str(tiles_count) + '), ' +
+                              bpp_mode_label + ', ' + compression_label('none') + ');' + '\n')
+            header_file.write('}' + '\n')
+            header_file.write('\n')
+            header_file.write('#endif' + '\n')
+            header_file.write('\n')
+
+        return len(tiles_data) * 4, header_file_path
+
+
 class AffineBgItem:
 
     def __init__(self, file_path, file_name_no_ext, build_folder_path, info):
@@ -1205,6 +2282,8 @@ class AffineBgItem:
                 tiles_compression, file_size = self.__test_tiles_compression(grit, tiles_compression, 'huffman',
                                                                              file_size)
 
+            tiles_compression, file_size = self.__test_tiles_compression(grit, tiles_compression, 'fast_lz', file_size)
+
         if palette_compression.startswith('auto'):
             test_huffman = palette_compression == 'auto'
             palette_compression, file_size = self.__test_palette_compression(grit, palette_compression, 'none', None)
@@ -1217,6 +2296,9 @@ class AffineBgItem:
                 palette_compression, file_size = self.__test_palette_compression(grit, palette_compression, 'huffman',
                                                                                  file_size)
 
+            palette_compression, file_size = self.__test_palette_compression(grit, palette_compression, 'fast_lz',
+                                                                             file_size)
+
         if map_compression.startswith('auto'):
             test_huffman = map_compression == 'auto'
             map_compression, file_size = self.__test_map_compression(grit, map_compression, 'none', None)
@@ -1226,6 +2308,8 @@ class AffineBgItem:
             if test_huffman:
                 map_compression, file_size = self.__test_map_compression(grit, map_compression, 'huffman', file_size)
 
+            map_compression, file_size = self.__test_map_compression(grit, map_compression, 'fast_lz', file_size)
+
         self.__execute_command(grit, tiles_compression, palette_compression, map_compression)
         return self.__write_header(tiles_compression, palette_compression, map_compression, False)
 
@@ -1233,7 +2317,11 @@ class AffineBgItem:
         self.__execute_command(grit, new_tiles_compression, 'none', 'none')
         new_file_size = self.__write_header(new_tiles_compression, 'none', 'none', True)
 
-        if best_file_size is None or new_file_size < best_file_size:
+        if new_tiles_compression == 'none':
+            self.__uncompressed_file_size = new_file_size
+
+        if better_compression(best_tiles_compression, best_file_size, new_tiles_compression, new_file_size,
+                              self.__uncompressed_file_size):
             return new_tiles_compression, new_file_size
 
         return best_tiles_compression, best_file_size
@@ -1242,7 +2330,11 @@ class AffineBgItem:
         self.__execute_command(grit, 'none', new_palette_compression, 'none')
         new_file_size = self.__write_header('none', new_palette_compression, 'none', True)
 
-        if best_file_size is None or new_file_size < best_file_size:
+        if new_palette_compression == 'none':
+            self.__uncompressed_file_size = new_file_size
+
+        if better_compression(best_palette_compression, best_file_size, new_palette_compression, new_file_size,
+                              self.__uncompressed_file_size):
             return new_palette_compression, new_file_size
 
         return best_palette_compression, best_file_size
@@ -1251,7 +2343,11 @@ class AffineBgItem:
         self.__execute_command(grit, 'none', 'none', new_map_compression)
         new_file_size = self.__write_header('none', 'none', new_map_compression, True)
 
-        if best_file_size is None or new_file_size < best_file_size:
+        if new_map_compression == 'none':
+            self.__uncompressed_file_size = new_file_size
+
+        if better_compression(best_map_compression, best_file_size, new_map_compression, new_file_size,
+                              self.__uncompressed_file_size):
             return new_map_compression, new_file_size
 
         return best_map_compression, best_file_size
@@ -1263,6 +2359,10 @@ class AffineBgItem:
 
         with open(grit_file_path, 'r') as grit_file:
             grit_data = grit_file.read()
+            grit_data = fast_lz_compress_grit_arrays(grit_data, name, [('Tiles', tiles_compression),
+                                                                       ('Pal', palette_compression),
+                                                                       ('Map', map_compression)],
+                                                     not skip_write)
             grit_data = grit_data.replace('unsigned int', 'bn::tile', 1)
             grit_data = grit_data.replace('unsigned char', 'bn::affine_bg_map_cell', 1)
 
@@ -1404,6 +2504,8 @@ class AffineBgTilesItem:
                 tiles_compression, file_size = self.__test_tiles_compression(grit, tiles_compression, 'huffman',
                                                                              file_size)
 
+            tiles_compression, file_size = self.__test_tiles_compression(grit, tiles_compression, 'fast_lz', file_size)
+
         if palette_compression.startswith('auto'):
             test_huffman = palette_compression == 'auto'
             palette_compression, file_size = self.__test_palette_compression(grit, palette_compression, 'none', None)
@@ -1416,6 +2518,9 @@ class AffineBgTilesItem:
                 palette_compression, file_size = self.__test_palette_compression(grit, palette_compression, 'huffman',
                                                                                  file_size)
 
+            palette_compression, file_size = self.__test_palette_compression(grit, palette_compression, 'fast_lz',
+                                                                             file_size)
+
         self.__execute_command(grit, tiles_compression, palette_compression)
         return self.__write_header(tiles_compression, palette_compression, False)
 
@@ -1423,7 +2528,11 @@ class AffineBgTilesItem:
         self.__execute_command(grit, new_compression, 'none')
         new_file_size = self.__write_header(new_compression, 'none', True)
 
-        if best_file_size is None or new_file_size < best_file_size:
+        if new_compression == 'none':
+            self.__uncompressed_file_size = new_file_size
+
+        if better_compression(best_compression, best_file_size, new_compression, new_file_size,
+                              self.__uncompressed_file_size):
             return new_compression, new_file_size
 
         return best_compression, best_file_size
@@ -1432,7 +2541,11 @@ class AffineBgTilesItem:
         self.__execute_command(grit, 'none', new_compression)
         new_file_size = self.__write_header('none', new_compression, True)
 
-        if best_file_size is None or new_file_size < best_file_size:
+        if new_compression == 'none':
+            self.__uncompressed_file_size = new_file_size
+
+        if better_compression(best_compression, best_file_size, new_compression, new_file_size,
+                              self.__uncompressed_file_size):
             return new_compression, new_file_size
 
         return best_compression, best_file_size
@@ -1444,6 +2557,9 @@ class AffineBgTilesItem:
 
         with open(grit_file_path, 'r') as grit_file:
             grit_data = grit_file.read()
+            grit_data = fast_lz_compress_grit_arrays(grit_data, name, [('Tiles', tiles_compression),
+                                                                       ('Pal', palette_compression)],
+                                                     not skip_write)
             grit_data = grit_data.replace('unsigned int', 'bn::tile', 1)
 
             if self.__generate_palette:
@@ -1558,6 +2674,8 @@ class BgPaletteItem:
             if test_huffman:
                 compression, file_size = self.__test_compression(grit, compression, 'huffman', file_size)
 
+            compression, file_size = self.__test_compression(grit, compression, 'fast_lz', file_size)
+
         self.__execute_command(grit, compression)
         return self.__write_header(compression, False)
 
@@ -1565,7 +2683,11 @@ class BgPaletteItem:
         self.__execute_command(grit, new_compression)
         new_file_size = self.__write_header(new_compression, True)
 
-        if best_file_size is None or new_file_size < best_file_size:
+        if new_compression == 'none':
+            self.__uncompressed_file_size = new_file_size
+
+        if better_compression(best_compression, best_file_size, new_compression, new_file_size,
+                              self.__uncompressed_file_size):
             return new_compression, new_file_size
 
         return best_compression, best_file_size
@@ -1577,6 +2699,8 @@ class BgPaletteItem:
 
         with open(grit_file_path, 'r') as grit_file:
             grit_data = grit_file.read()
+            grit_data = fast_lz_compress_grit_arrays(grit_data, name, [('Pal', compression)],
+                                                     not skip_write)
             grit_data = grit_data.replace('unsigned short', 'bn::color', 1)
 
             for grit_line in grit_data.splitlines():
@@ -1639,50 +2763,101 @@ class GraphicsFileInfo:
         self.__file_name_no_ext = file_name_no_ext
         self.__file_info_path = file_info_path
 
+    def file_name(self):
+        return self.__file_name
+
     def print_file_name(self):
         print(self.__file_name)
 
-    def process(self, grit, build_folder_path):
+    def create_item(self, build_folder_path):
         try:
-            try:
-                with open(self.__json_file_path) as json_file:
-                    info = json.load(json_file)
-            except Exception as exception:
-                raise ValueError(self.__json_file_path + ' graphics json file parse failed: ' + str(exception))
+            with open(self.__json_file_path) as json_file:
+                info = json.load(json_file)
+        except Exception as exception:
+            raise ValueError(self.__json_file_path + ' graphics json file parse failed: ' + str(exception))
 
-            try:
-                graphics_type = str(info['type'])
-            except KeyError:
-                raise ValueError('type field not found in graphics json file: ' + self.__json_file_path)
-
-            if graphics_type == 'sprite':
-                item = SpriteItem(self.__file_path, self.__file_name_no_ext, build_folder_path, info)
-            elif graphics_type == 'sprite_tiles':
-                item = SpriteTilesItem(self.__file_path, self.__file_name_no_ext, build_folder_path, info)
-            elif graphics_type == 'sprite_palette':
-                item = SpritePaletteItem(self.__file_path, self.__file_name_no_ext, build_folder_path, info)
-            elif graphics_type == 'regular_bg':
-                item = RegularBgItem(self.__file_path, self.__file_name_no_ext, build_folder_path, info)
-            elif graphics_type == 'regular_bg_tiles':
-                item = RegularBgTilesItem(self.__file_path, self.__file_name_no_ext, build_folder_path, info)
-            elif graphics_type == 'affine_bg':
-                item = AffineBgItem(self.__file_path, self.__file_name_no_ext, build_folder_path, info)
-            elif graphics_type == 'affine_bg_tiles':
-                item = AffineBgTilesItem(self.__file_path, self.__file_name_no_ext, build_folder_path, info)
-            elif graphics_type == 'bg_palette':
-                item = BgPaletteItem(self.__file_path, self.__file_name_no_ext, build_folder_path, info)
-            else:
-                raise ValueError('Unknown graphics type "' + graphics_type +
-                                 '" found in graphics json file: ' + self.__json_file_path)
+        try:
+            graphics_type = str(info['type'])
+        except KeyError:
+            raise ValueError('type field not found in graphics json file: ' + self.__json_file_path)
+
+        if graphics_type == 'sprite':
+            return SpriteItem(self.__file_path, self.__file_name_no_ext, build_folder_path, info)
 
+        if graphics_type == 'sprite_tiles':
+            return SpriteTilesItem(self.__file_path, self.__file_name_no_ext, build_folder_path, info)
+
+        if graphics_type == 'sprite_palette':
+            return SpritePaletteItem(self.__file_path, self.__file_name_no_ext, build_folder_path, info)
+
+        if graphics_type == 'regular_bg':
+            return RegularBgItem(self.__file_path, self.__file_name_no_ext, build_folder_path, info)
+
+        if graphics_type == 'regular_bg_tiles':
+            return RegularBgTilesItem(self.__file_path, self.__file_name_no_ext, build_folder_path, info)
+
+        if graphics_type == 'affine_bg':
+            return AffineBgItem(self.__file_path, self.__file_name_no_ext, build_folder_path, info)
+
+        if graphics_type == 'affine_bg_tiles':
+            return AffineBgTilesItem(self.__file_path, self.__file_name_no_ext, build_folder_path, info)
+
+        if graphics_type == 'bg_palette':
+            return BgPaletteItem(self.__file_path, self.__file_name_no_ext, build_folder_path, info)
+
+        raise ValueError('Unknown graphics type "' + graphics_type +
+                         '" found in graphics json file: ' + self.__json_file_path)
+
+    def write_file_info(self):
+        with open(self.__file_info_path, 'w') as file_info:
+            file_info.write('')
+
+    def process(self, grit, build_folder_path):
+        try:
+            item = self.create_item(build_folder_path)
             total_size, header_file_path = item.process(grit)
+            self.write_file_info()
+            return [[self.__file_name, header_file_path, total_size]]
+        except Exception as exc:
+            return [[self.__file_name, exc]]
+
+
+class RegularBgTilesGroupInfo:
+
+    def __init__(self, name, graphics_file_infos, file_info_path):
+        self.__name = name
+        self.__graphics_file_infos = graphics_file_infos
+        self.__file_info_path = file_info_path
+
+    def print_file_name(self):
+        for graphics_file_info in self.__graphics_file_infos:
+            graphics_file_info.print_file_name()
+
+    def process(self, grit, build_folder_path):
+        try:
+            items = []
+
+            for graphics_file_info in self.__graphics_file_infos:
+                item = graphics_file_info.create_item(build_folder_path)
+
+                if not isinstance(item, RegularBgItem) or item.tiles_group() != self.__name:
+                    raise ValueError('Invalid tiles group item: ' + graphics_file_info.file_name())
+
+                items.append(item)
+
+            group_results = RegularBgTilesGroup(self.__name, build_folder_path, items).process(grit)
+            results = [[self.__name + ' tiles group', group_results[0][1], group_results[0][0]]]
+
+            for graphics_file_info, group_result in zip(self.__graphics_file_infos, group_results[1:]):
+                graphics_file_info.write_file_info()
+                results.append([graphics_file_info.file_name(), group_result[1], group_result[0]])
 
             with open(self.__file_info_path, 'w') as file_info:
-                file_info.write('')
+                file_info.write(regular_bg_tiles_group_file_info(self.__graphics_file_infos))
 
-            return [self.__file_name, header_file_path, total_size]
+            return results
         except Exception as exc:
-            return [self.__file_name, exc]
+            return [[self.__name + ' tiles group', exc]]
 
 
 class GraphicsFileInfoProcessor:
@@ -1695,6 +2870,24 @@ class GraphicsFileInfoProcessor:
         return graphics_file_info.process(self.__grit, self.__build_folder_path)
 
 
+def read_tiles_group(json_file_path):
+    # Json parse errors are reported when the graphics file is processed:
+    try:
+        with open(json_file_path) as json_file:
+            info = json.load(json_file)
+
+        if str(info['type']) == 'regular_bg':
+            return str(info['tiles_group'])
+    except Exception:
+        pass
+
+    return None
+
+
+def regular_bg_tiles_group_file_info(graphics_file_infos):
+    return '\n'.join(graphics_file_info.file_name() for graphics_file_info in graphics_file_infos)
+
+
 def list_graphics_file_infos(graphics_paths, build_folder_path):
     graphics_file_paths = []
 
@@ -1711,6 +2904,7 @@ def list_graphics_file_infos(graphics_paths, build_folder_path):
             graphics_file_paths.append(graphics_path)
 
     graphics_file_infos = []
+    tiles_groups = {}
     file_names_set = set()
 
     for graphics_file_path in graphics_file_paths:
@@ -1747,10 +2941,35 @@ def list_graphics_file_infos(graphics_paths, build_folder_path):
                         json_file_mtime = os.path.getmtime(json_file_path)
                         build = file_info_mtime < json_file_mtime
 
-                if build:
-                    graphics_file_infos.append(GraphicsFileInfo(
-                        json_file_path, graphics_file_path, graphics_file_name, graphics_file_name_no_ext,
-                        file_info_path))
+                graphics_file_info = GraphicsFileInfo(json_file_path, graphics_file_path, graphics_file_name,
+                                                      graphics_file_name_no_ext, file_info_path)
+                tiles_group = read_tiles_group(json_file_path)
+
+                if tiles_group is not None:
+                    tiles_groups.setdefault(tiles_group, []).append([graphics_file_info, build])
+                elif build:
+                    graphics_file_infos.append(graphics_file_info)
+
+    for tiles_group, tiles_group_members in sorted(tiles_groups.items()):
+        if tiles_group in file_names_set:
+            raise ValueError('There\'s a tiles group with the same name as a graphics file: ' + tiles_group)
+
+        tiles_group_members.sort(key=lambda tiles_group_member: tiles_group_member[0].file_name())
+        tiles_group_file_infos = [tiles_group_member[0] for tiles_group_member in tiles_group_members]
+        file_info_path = build_folder_path + '/_bn_' + tiles_group + '_tiles_group_file_info.txt'
+
+        # All items of a tiles group are rebuilt if one of them has changed or if the group items have changed:
+        build = any(tiles_group_member[1] for tiles_group_member in tiles_group_members)
+
+        if not build:
+            try:
+                with open(file_info_path) as file_info:
+                    build = file_info.read() != regular_bg_tiles_group_file_info(tiles_group_file_infos)
+            except OSError:
+                build = True
+
+        if build:
+            graphics_file_infos.append(RegularBgTilesGroupInfo(tiles_group, tiles_group_file_infos, file_info_path))
 
     return graphics_file_infos
 
@@ -1768,6 +2987,9 @@ def process_graphics(grit, graphics_paths, build_folder_path):
         process_results = pool.map(GraphicsFileInfoProcessor(grit, build_folder_path), graphics_file_infos)
         pool.close()
 
+        # Tiles groups return one result for each item:
+        process_results = [item_result for process_result in process_results for item_result in process_result]
+
         total_size = 0
         process_excs = []
 
@@ -29,6 +29,8 @@ DMGS3MFILES		:=	$(foreach dir,	$(DMGAUDIO),	$(notdir $(wildcard $(dir)/*.s3m)))
 						
 DMGVGMFILES		:=	$(foreach dir,	$(DMGAUDIO),	$(notdir $(wildcard $(dir)/*.vgm)))
 						
+ADPCMFILES		:=	$(foreach dir,	$(AUDIO),	$(notdir $(wildcard $(dir)/*.json)))
+						
 GRAPHICSFILES	:=	$(foreach dir,	$(GRAPHICS),	$(notdir $(wildcard $(dir)/*.bmp)))
 
 #---------------------------------------------------------------------------------------------------------------------
@@ -49,11 +51,13 @@ export OFILES_BIN       :=  $(addsuffix .o,$(BINFILES))
 
 export OFILES_DMG		:=  $(DMGMODFILES:.mod=_bn_dmg.o) $(DMGS3MFILES:.s3m=_bn_dmg.o) $(DMGVGMFILES:.vgm=_bn_dmg.o)
 
+export OFILES_ADPCM		:=  $(ADPCMFILES:.json=_bn_adpcm.o)
+
 export OFILES_GRAPHICS	:=  $(GRAPHICSFILES:.bmp=_bn_gfx.o)
 
 export OFILES_SOURCES   :=  $(CPPFILES:.cpp=.o) $(CFILES:.c=.o) $(SFILES:.s=.o)
  
-export OFILES           :=  $(OFILES_BIN) $(OFILES_DMG) $(OFILES_GRAPHICS) $(OFILES_SOURCES)
+export OFILES           :=  $(OFILES_BIN) $(OFILES_DMG) $(OFILES_ADPCM) $(OFILES_GRAPHICS) $(OFILES_SOURCES)
 
 #---------------------------------------------------------------------------------------------------------------------
 # Don't generate header files from audio soundbank (avoid rebuilding all sources when audio files are updated):
@@ -66,6 +70,14 @@ export INCLUDE          :=  $(foreach dir,$(INCLUDES),-iquote $(CURDIR)/$(dir))
  
 export LIBPATHS         :=  $(foreach dir,$(LIBDIRS),-L$(dir)/lib)
 
+#---------------------------------------------------------------------------------------------------------------------
+# Audio settings required by the assets tool are read from USERFLAGS:
+#---------------------------------------------------------------------------------------------------------------------
+AUDIOMIXINGRATE         :=  $(patsubst -DBN_CFG_AUDIO_MIXING_RATE=%,%,$(filter -DBN_CFG_AUDIO_MIXING_RATE=%,$(USERFLAGS)))
+
+AUDIOMAXMUSICCHANNELS   :=  $(patsubst -DBN_CFG_AUDIO_MAX_MUSIC_CHANNELS=%,%,\
+                                $(filter -DBN_CFG_AUDIO_MAX_MUSIC_CHANNELS=%,$(USERFLAGS)))
+
 .PHONY: $(BUILD) clean
  
 #---------------------------------------------------------------------------------
@@ -77,7 +89,9 @@ all:
 #---------------------------------------------------------------------------------
 $(BUILD):
 	@$(PYTHON) -B $(BN_TOOLS)/butano_assets_tool.py --grit="$(BN_GRIT)" --mmutil="$(BN_MMUTIL)" \
-			--audio="$(AUDIO)" --dmg_audio="$(DMGAUDIO)" --graphics="$(GRAPHICS)" --build=$(BUILD)
+			--audio="$(AUDIO)" --audio_mixing_rate="$(AUDIOMIXINGRATE)" \
+			--audio_max_music_channels="$(AUDIOMAXMUSICCHANNELS)" --audio_resample="$(AUDIORESAMPLE)" \
+			--dmg_audio="$(DMGAUDIO)" --graphics="$(GRAPHICS)" --build=$(BUILD)
 	@$(MAKE) --no-print-directory -C $(BUILD) -f $(CURDIR)/Makefile
 
 #---------------------------------------------------------------------------------------------------------------------
@@ -55,13 +55,16 @@ class FileInfo:
         return FileInfo(info, read_failed)
 
     @staticmethod
-    def build_from_files(file_paths):
+    def build_from_files(file_paths, extra_info=None):
         info = []
 
         for file_path in file_paths:
             info.append(file_path)
             info.append(str(os.path.getmtime(file_path)))
 
+        if extra_info is not None:
+            info.extend(extra_info)
+
         return FileInfo('\n'.join(info), False)
 
     def __init__(self, info, read_failed):
@@ -224,7 +224,7 @@ int main()
                 --cursor_x;
 
                 bg_map_ptr->dig(cursor_x, cursor_y);
-                bg_map.reload_cells_ref();
+                bg_map.reload_cells_ref(cursor_x - 1, cursor_y - 1, 3, 3);
             }
         }
         else if(bn::keypad::right_pressed())
@@ -234,7 +234,7 @@ int main()
                 ++cursor_x;
 
                 bg_map_ptr->dig(cursor_x, cursor_y);
-                bg_map.reload_cells_ref();
+                bg_map.reload_cells_ref(cursor_x - 1, cursor_y - 1, 3, 3);
             }
         }
 
@@ -245,7 +245,7 @@ int main()
                 --cursor_y;
 
                 bg_map_ptr->dig(cursor_x, cursor_y);
-                bg_map.reload_cells_ref();
+                bg_map.reload_cells_ref(cursor_x - 1, cursor_y - 1, 3, 3);
             }
         }
         else if(bn::keypad::down_pressed())
@@ -255,7 +255,7 @@ int main()
                 ++cursor_y;
 
                 bg_map_ptr->dig(cursor_x, cursor_y);
-                bg_map.reload_cells_ref();
+                bg_map.reload_cells_ref(cursor_x - 1, cursor_y - 1, 3, 3);
             }
         }
 
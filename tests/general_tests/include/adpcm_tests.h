@@ -0,0 +1,108 @@
+/*
+ * Copyright (c) 2020-2023 Gustavo Valiente gustavo.valiente@protonmail.com
+ * zlib License, see LICENSE file.
+ */
+
+#ifndef ADPCM_TESTS_H
+#define ADPCM_TESTS_H
+
+#include "bn_array.h"
+#include "bn_algorithm.h"
+#include "../../butano/hw/include/bn_hw_adpcm.h"
+#include "tests.h"
+
+class adpcm_tests : public tests
+{
+
+private:
+    static constexpr int _samples_count = 16;
+
+    // Two blocks of 8 samples each, with different initial predictors and step indexes:
+    alignas(int) static constexpr uint8_t _data[] = {
+        0x40, 0x1F, 0x00, 0x00, 0x10, 0x00, 0x00, 0x00, 0x08, 0x00, 0x00, 0x00,
+        0x00, 0x00, 0x3C, 0x00, 0x77, 0x13, 0x90, 0xCF,
+        0x00, 0xF0, 0x28, 0x00, 0x54, 0x76, 0xFF, 0x82
+    };
+
+    // Decoded predictors divided by 256, which are the outputs with the test volume:
+    static constexpr bn::array<int8_t, _samples_count> _samples = {
+        16, 52, 87, 101, 106, 94, 42, -25, -15, -13, -9, -1, -18, -54, -28, -33
+    };
+
+    static constexpr int _volume = 256;
+
+    static constexpr int _output_size = _samples_count + 4;
+
+    using output_array = bn::array<int8_t, _output_size>;
+
+    [[nodiscard]] static bn::hw::adpcm::stream _create_stream(bool loop)
+    {
+        bn::hw::adpcm::stream result;
+        result.data = _data;
+        result.volume = _volume;
+        result.step = 65536;
+        result.loop = loop;
+        bn::hw::adpcm::restart(result);
+        return result;
+    }
+
+public:
+    adpcm_tests() :
+        tests("adpcm")
+    {
+        BN_ASSERT(bn::hw::adpcm::sample_rate(_data) == 8000);
+        BN_ASSERT(bn::hw::adpcm::samples_count(_data) == _samples_count);
+        BN_ASSERT(bn::hw::adpcm::samples_per_block(_data) == 8);
+
+        // Streams which don't loop are finished after their last sample, leaving the rest of the output untouched:
+        bn::hw::adpcm::stream stream = _create_stream(false);
+        output_array left_output = {};
+        output_array right_output = {};
+        BN_ASSERT(! bn::hw::adpcm::mix(stream, left_output.data(), right_output.data(), _output_size));
+
+        for(int index = 0; index < _samples_count; ++index)
+        {
+            BN_ASSERT(left_output[index] == _samples[index], "Invalid sample: ", index, " - ", left_output[index]);
+            BN_ASSERT(right_output[index] == _samples[index], "Invalid sample: ", index, " - ", right_output[index]);
+        }
+
+        for(int index = _samples_count; index < _output_size; ++index)
+        {
+            BN_ASSERT(left_output[index] == 0, "Invalid sample: ", index, " - ", left_output[index]);
+            BN_ASSERT(right_output[index] == 0, "Invalid sample: ", index, " - ", right_output[index]);
+        }
+
+        // Mixing can be resumed at any sample, and outputs are added to the given ones:
+        stream = _create_stream(false);
+        left_output.fill(1);
+        right_output.fill(-1);
+
+        for(int index = 0; index < _samples_count; index += 3)
+        {
+            int samples = bn::min(3, _samples_count - index);
+            BN_ASSERT(bn::hw::adpcm::mix(stream, left_output.data() + index, right_output.data() + index, samples));
+        }
+
+        for(int index = 0; index < _samples_count; ++index)
+        {
+            BN_ASSERT(left_output[index] == _samples[index] + 1, "Invalid sample: ", index, " - ", left_output[index]);
+            BN_ASSERT(right_output[index] == _samples[index] - 1, "Invalid sample: ", index, " - ",
+                      right_output[index]);
+        }
+
+        // Looping streams are restarted from the first block:
+        stream = _create_stream(true);
+        left_output.fill(0);
+        right_output.fill(0);
+        BN_ASSERT(bn::hw::adpcm::mix(stream, left_output.data(), right_output.data(), _output_size));
+
+        for(int index = 0; index < _output_size; ++index)
+        {
+            int8_t sample = _samples[index % _samples_count];
+            BN_ASSERT(left_output[index] == sample, "Invalid sample: ", index, " - ", left_output[index]);
+            BN_ASSERT(right_output[index] == sample, "Invalid sample: ", index, " - ", right_output[index]);
+        }
+    }
+};
+
+#endif
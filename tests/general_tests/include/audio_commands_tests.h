@@ -0,0 +1,86 @@
+/*
+ * Copyright (c) 2020-2023 Gustavo Valiente gustavo.valiente@protonmail.com
+ * zlib License, see LICENSE file.
+ */
+
+#ifndef AUDIO_COMMANDS_TESTS_H
+#define AUDIO_COMMANDS_TESTS_H
+
+#include "bn_audio.h"
+#include "bn_sound.h"
+#include "bn_sound_item.h"
+#include "bn_sound_handle.h"
+#include "bn_config_audio.h"
+#include "tests.h"
+
+class audio_commands_tests : public tests
+{
+
+private:
+    // Sound effects play, speed and panning commands can't use the last quarter of the commands ring buffer:
+    static constexpr int _sound_commands_count = BN_CFG_AUDIO_MAX_COMMANDS - (BN_CFG_AUDIO_MAX_COMMANDS / 4);
+
+public:
+    audio_commands_tests() :
+        tests("audio_commands")
+    {
+        // All commands are pushed in the same frame, so none of them is executed while the test is running:
+        bn::audio::reset_commands_counters();
+        BN_ASSERT(bn::audio::coalesced_commands_count() == 0);
+        BN_ASSERT(bn::audio::dropped_commands_count() == 0);
+
+        // Setters are coalesced with the last pending command of the same type:
+        bn::fixed sound_master_volume = bn::sound::master_volume();
+        bn::sound::set_master_volume(0.5);
+        BN_ASSERT(bn::audio::coalesced_commands_count() == 0);
+
+        bn::sound::set_master_volume(0.25);
+        BN_ASSERT(bn::audio::coalesced_commands_count() == 1);
+        BN_ASSERT(bn::sound::master_volume() == 0.25);
+
+        int max_channels = bn::audio::max_channels();
+        bn::audio::set_max_channels(1);
+        BN_ASSERT(bn::audio::coalesced_commands_count() == 1);
+
+        // Coalescable commands don't depend on each other, so they are searched past other coalescable ones:
+        bn::sound::set_master_volume(sound_master_volume);
+        BN_ASSERT(bn::audio::coalesced_commands_count() == 2);
+
+        bn::audio::set_max_channels(max_channels);
+        BN_ASSERT(bn::audio::coalesced_commands_count() == 3);
+        BN_ASSERT(bn::audio::max_channels() == max_channels);
+
+        // Setters are not coalesced with pending commands pushed before a non coalescable one:
+        bn::sound::stop_all();
+        bn::sound::set_master_volume(0.5);
+        bn::sound::set_master_volume(sound_master_volume);
+        BN_ASSERT(bn::audio::coalesced_commands_count() == 4);
+        BN_ASSERT(bn::audio::dropped_commands_count() == 0);
+
+        // Fill the commands ring buffer up to its reserved quarter (four commands are pending):
+        for(int index = 4; index < _sound_commands_count; ++index)
+        {
+            bn::sound::stop_all();
+        }
+
+        // Sound effects commands are dropped instead of using the reserved quarter,
+        // so the sound item is never read:
+        bn::sound_handle sound_handle = bn::sound_item(0).play();
+        BN_ASSERT(! sound_handle.active());
+        BN_ASSERT(bn::sound::active_count() == 0);
+        BN_ASSERT(bn::audio::dropped_commands_count() == 1);
+
+        // Other commands can still use the reserved quarter:
+        bn::sound::stop_all();
+        bn::sound::set_master_volume(0.5);
+        bn::sound::set_master_volume(sound_master_volume);
+        BN_ASSERT(bn::audio::coalesced_commands_count() == 5);
+        BN_ASSERT(bn::audio::dropped_commands_count() == 1);
+
+        bn::audio::reset_commands_counters();
+        BN_ASSERT(bn::audio::coalesced_commands_count() == 0);
+        BN_ASSERT(bn::audio::dropped_commands_count() == 0);
+    }
+};
+
+#endif
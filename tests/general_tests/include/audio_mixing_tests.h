@@ -0,0 +1,62 @@
+/*
+ * Copyright (c) 2020-2023 Gustavo Valiente gustavo.valiente@protonmail.com
+ * zlib License, see LICENSE file.
+ */
+
+#ifndef AUDIO_MIXING_TESTS_H
+#define AUDIO_MIXING_TESTS_H
+
+#include "bn_audio.h"
+#include "bn_sound.h"
+#include "bn_jingle.h"
+#include "bn_config_audio.h"
+#include "tests.h"
+
+class audio_mixing_tests : public tests
+{
+
+public:
+    audio_mixing_tests() :
+        tests("audio_mixing")
+    {
+        BN_ASSERT(bn::audio::mixing_rate() == BN_CFG_AUDIO_MIXING_RATE);
+        BN_ASSERT(bn::audio::max_channels() == BN_CFG_AUDIO_MAX_MUSIC_CHANNELS + BN_CFG_AUDIO_MAX_SOUND_CHANNELS);
+        BN_ASSERT(bn::audio::last_mixing_ticks() >= 0);
+        BN_ASSERT(bn::audio::last_mixing_usage() >= 0);
+
+        // Mixing settings are applied with coalescable commands, so changing them back and forth only pushes one:
+        bn::audio::reset_commands_counters();
+
+        #if BN_CFG_AUDIO_MIXING_RATE != BN_AUDIO_MIXING_RATE_8_KHZ
+            bn::audio::set_mixing_rate(BN_AUDIO_MIXING_RATE_8_KHZ);
+            BN_ASSERT(bn::audio::mixing_rate() == BN_AUDIO_MIXING_RATE_8_KHZ);
+
+            // Changing the mixing rate stops jingles and sound effects:
+            BN_ASSERT(! bn::jingle::playing());
+            BN_ASSERT(bn::sound::active_count() == 0);
+
+            bn::audio::set_mixing_rate(BN_CFG_AUDIO_MIXING_RATE);
+            BN_ASSERT(bn::audio::mixing_rate() == BN_CFG_AUDIO_MIXING_RATE);
+            BN_ASSERT(bn::audio::coalesced_commands_count() == 1);
+        #endif
+
+        // The channels limit is shared by music and sound effects:
+        bn::audio::reset_commands_counters();
+        bn::audio::set_max_channels(BN_CFG_AUDIO_MAX_MUSIC_CHANNELS + 1);
+        BN_ASSERT(bn::audio::max_channels() == BN_CFG_AUDIO_MAX_MUSIC_CHANNELS + 1);
+
+        bn::audio::set_max_channels(BN_CFG_AUDIO_MAX_MUSIC_CHANNELS + BN_CFG_AUDIO_MAX_SOUND_CHANNELS);
+        BN_ASSERT(bn::audio::max_channels() == BN_CFG_AUDIO_MAX_MUSIC_CHANNELS + BN_CFG_AUDIO_MAX_SOUND_CHANNELS);
+        BN_ASSERT(bn::audio::coalesced_commands_count() == 1);
+
+        // Setting the current values doesn't push any command:
+        bn::audio::set_mixing_rate(BN_CFG_AUDIO_MIXING_RATE);
+        bn::audio::set_max_channels(BN_CFG_AUDIO_MAX_MUSIC_CHANNELS + BN_CFG_AUDIO_MAX_SOUND_CHANNELS);
+        BN_ASSERT(bn::audio::coalesced_commands_count() == 1);
+        BN_ASSERT(bn::audio::dropped_commands_count() == 0);
+
+        bn::audio::reset_commands_counters();
+    }
+};
+
+#endif
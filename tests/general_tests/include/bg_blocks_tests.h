@@ -0,0 +1,84 @@
+/*
+ * Copyright (c) 2020-2023 Gustavo Valiente gustavo.valiente@protonmail.com
+ * zlib License, see LICENSE file.
+ */
+
+#ifndef BG_BLOCKS_TESTS_H
+#define BG_BLOCKS_TESTS_H
+
+#include "bn_core.h"
+#include "bn_array.h"
+#include "bn_bg_maps.h"
+#include "bn_bg_tiles.h"
+#include "bn_optional.h"
+#include "bn_config_bg_blocks.h"
+#include "bn_regular_bg_tiles_ptr.h"
+#include "bn_regular_bg_tiles_item.h"
+#include "tests.h"
+
+class bg_blocks_tests : public tests
+{
+
+private:
+    // 64 4BPP tiles fill one background block:
+    static constexpr int _tiles_per_block = 64;
+
+    // Tiles are identified by their address, so each tile set references a different part of the same array:
+    static constexpr bn::array<bn::tile, _tiles_per_block * 3> _tiles = {};
+
+    [[nodiscard]] static bn::regular_bg_tiles_ptr _create_tiles(int index)
+    {
+        bn::span<const bn::tile> tiles_ref(_tiles.data() + (index * _tiles_per_block), _tiles_per_block);
+        return bn::regular_bg_tiles_ptr::create_new(bn::regular_bg_tiles_item(tiles_ref, bn::bpp_mode::BPP_4));
+    }
+
+public:
+    bg_blocks_tests() :
+        tests("bg_blocks")
+    {
+        int total_tiles_count = bn::bg_tiles::used_tiles_count() + bn::bg_tiles::available_tiles_count();
+        int used_tiles_count = bn::bg_tiles::used_tiles_count();
+        BN_ASSERT(bn::bg_tiles::fragmentation() == 0);
+        BN_ASSERT(bn::bg_maps::fragmentation() == 0);
+
+        bn::optional<bn::regular_bg_tiles_ptr> first_tiles = _create_tiles(0);
+        bn::optional<bn::regular_bg_tiles_ptr> second_tiles = _create_tiles(1);
+        bn::optional<bn::regular_bg_tiles_ptr> third_tiles = _create_tiles(2);
+        bn::core::update();
+
+        BN_ASSERT(bn::bg_tiles::used_tiles_count() == used_tiles_count + (_tiles_per_block * 3));
+        BN_ASSERT(bn::bg_tiles::fragmentation() == 0);
+
+        // Releasing the middle tile set leaves a hole between the other ones:
+        second_tiles.reset();
+        bn::core::update();
+
+        BN_ASSERT(bn::bg_tiles::used_tiles_count() == used_tiles_count + (_tiles_per_block * 2));
+        BN_ASSERT(bn::bg_tiles::used_tiles_count() + bn::bg_tiles::available_tiles_count() == total_tiles_count);
+
+        #if BN_CFG_BG_BLOCKS_DEFRAG_MAX_BLOCKS
+            // Holes are closed by moving the following blocks, a few of them per frame:
+            for(int index = 0; index < 4 && bn::bg_tiles::fragmentation() > 0; ++index)
+            {
+                bn::core::update();
+            }
+
+            BN_ASSERT(bn::bg_tiles::fragmentation() == 0);
+        #else
+            BN_ASSERT(bn::bg_tiles::fragmentation() > 0);
+        #endif
+
+        // Moving blocks doesn't change the used and available ones:
+        BN_ASSERT(bn::bg_tiles::used_tiles_count() == used_tiles_count + (_tiles_per_block * 2));
+        BN_ASSERT(bn::bg_tiles::used_tiles_count() + bn::bg_tiles::available_tiles_count() == total_tiles_count);
+
+        first_tiles.reset();
+        third_tiles.reset();
+        bn::core::update();
+
+        BN_ASSERT(bn::bg_tiles::used_tiles_count() == used_tiles_count);
+        BN_ASSERT(bn::bg_tiles::fragmentation() == 0);
+    }
+};
+
+#endif
@@ -0,0 +1,132 @@
+/*
+ * Copyright (c) 2020-2023 Gustavo Valiente gustavo.valiente@protonmail.com
+ * zlib License, see LICENSE file.
+ */
+
+#ifndef DECOMPRESSION_TESTS_H
+#define DECOMPRESSION_TESTS_H
+
+#include "bn_array.h"
+#include "bn_compression_type.h"
+#include "../../butano/hw/include/bn_hw_decompress.h"
+#include "../../butano/src/bn_resumable_decompressor.h"
+#include "tests.h"
+
+class decompression_tests : public tests
+{
+
+private:
+    static constexpr int _bytes_count = 256;
+
+    using bytes_array = bn::array<uint8_t, _bytes_count>;
+
+    static constexpr bytes_array _uncompressed_bytes = {
+        0x00, 0x07, 0x0E, 0x05, 0x0C, 0x03, 0x0A, 0x01, 0x08, 0x0F, 0x06, 0x0D, 0x04, 0x0B, 0x02, 0x09,
+        0x00, 0x07, 0x0E, 0x05, 0x0C, 0x03, 0x0A, 0x01, 0x08, 0x0F, 0x06, 0x0D, 0x04, 0x0B, 0x02, 0x09,
+        0x00, 0x07, 0x0E, 0x05, 0x0C, 0x03, 0x0A, 0x01, 0x08, 0x0F, 0x06, 0x0D, 0x04, 0x0B, 0x02, 0x09,
+        0x00, 0x07, 0x0E, 0x05, 0x0C, 0x03, 0x0A, 0x01, 0x08, 0x0F, 0x06, 0x0D, 0x04, 0x0B, 0x02, 0x09,
+        0x03, 0x03, 0x03, 0x03, 0x03, 0x03, 0x03, 0x03, 0x03, 0x03, 0x03, 0x03, 0x03, 0x03, 0x03, 0x03,
+        0x03, 0x03, 0x03, 0x03, 0x03, 0x03, 0x03, 0x03, 0x03, 0x03, 0x03, 0x03, 0x03, 0x03, 0x03, 0x03,
+        0x03, 0x03, 0x03, 0x03, 0x03, 0x03, 0x03, 0x03, 0x06, 0x0D, 0x04, 0x0B, 0x02, 0x09, 0x00, 0x07,
+        0x0E, 0x05, 0x0C, 0x03, 0x0A, 0x01, 0x08, 0x0F, 0x06, 0x0D, 0x04, 0x0B, 0x02, 0x09, 0x00, 0x07,
+        0x0E, 0x05, 0x0C, 0x03, 0x0A, 0x01, 0x08, 0x0F, 0x06, 0x0D, 0x04, 0x0B, 0x02, 0x09, 0x00, 0x07,
+        0x0E, 0x05, 0x0C, 0x03, 0x0A, 0x01, 0x08, 0x0F, 0x06, 0x0D, 0x00, 0x01, 0x04, 0x01, 0x00, 0x01,
+        0x04, 0x01, 0x00, 0x01, 0x04, 0x01, 0x00, 0x01, 0x04, 0x01, 0x00, 0x01, 0x04, 0x01, 0x00, 0x01,
+        0x04, 0x01, 0x00, 0x01, 0x04, 0x01, 0x00, 0x01, 0x0C, 0x0C, 0x0C, 0x0C, 0x0C, 0x0C, 0x0C, 0x0C,
+        0x0C, 0x0C, 0x0C, 0x0C, 0x0C, 0x0C, 0x0C, 0x0C, 0x0C, 0x0C, 0x0C, 0x0C, 0x00, 0x07, 0x0E, 0x05,
+        0x0C, 0x03, 0x0A, 0x01, 0x08, 0x0F, 0x06, 0x0D, 0x04, 0x0B, 0x02, 0x09, 0x00, 0x07, 0x0E, 0x05,
+        0x0C, 0x03, 0x0A, 0x01, 0x08, 0x0F, 0x06, 0x0D, 0x04, 0x0B, 0x02, 0x09, 0x00, 0x07, 0x0E, 0x05,
+        0x0C, 0x03, 0x0A, 0x01, 0x08, 0x0F, 0x06, 0x0D, 0x04, 0x0B, 0x02, 0x09, 0x00, 0x07, 0x0E, 0x05
+    };
+
+    alignas(int) static constexpr uint8_t _lz77_data[] = {
+        0x10, 0x00, 0x01, 0x00, 0x00, 0x00, 0x07, 0x0E, 0x05, 0x0C, 0x03, 0x0A, 0x01, 0x00, 0x08, 0x0F,
+        0x06, 0x0D, 0x04, 0x0B, 0x02, 0x09, 0xE6, 0xF0, 0x0F, 0xF0, 0x0F, 0x90, 0x0F, 0x03, 0x03, 0xF0,
+        0x01, 0xF0, 0x01, 0x03, 0x70, 0x03, 0xF0, 0x3D, 0xF0, 0x0F, 0xB0, 0x0F, 0x00, 0x01, 0x04, 0x01,
+        0xCF, 0xF0, 0x03, 0x50, 0x03, 0x0C, 0x0C, 0xF0, 0x01, 0xF0, 0x4D, 0xF0, 0x0F, 0xD0, 0x0F, 0x00
+    };
+
+    alignas(int) static constexpr uint8_t _run_length_data[] = {
+        0x30, 0x00, 0x01, 0x00, 0x3F, 0x00, 0x07, 0x0E, 0x05, 0x0C, 0x03, 0x0A, 0x01, 0x08, 0x0F, 0x06,
+        0x0D, 0x04, 0x0B, 0x02, 0x09, 0x00, 0x07, 0x0E, 0x05, 0x0C, 0x03, 0x0A, 0x01, 0x08, 0x0F, 0x06,
+        0x0D, 0x04, 0x0B, 0x02, 0x09, 0x00, 0x07, 0x0E, 0x05, 0x0C, 0x03, 0x0A, 0x01, 0x08, 0x0F, 0x06,
+        0x0D, 0x04, 0x0B, 0x02, 0x09, 0x00, 0x07, 0x0E, 0x05, 0x0C, 0x03, 0x0A, 0x01, 0x08, 0x0F, 0x06,
+        0x0D, 0x04, 0x0B, 0x02, 0x09, 0xA5, 0x03, 0x4F, 0x06, 0x0D, 0x04, 0x0B, 0x02, 0x09, 0x00, 0x07,
+        0x0E, 0x05, 0x0C, 0x03, 0x0A, 0x01, 0x08, 0x0F, 0x06, 0x0D, 0x04, 0x0B, 0x02, 0x09, 0x00, 0x07,
+        0x0E, 0x05, 0x0C, 0x03, 0x0A, 0x01, 0x08, 0x0F, 0x06, 0x0D, 0x04, 0x0B, 0x02, 0x09, 0x00, 0x07,
+        0x0E, 0x05, 0x0C, 0x03, 0x0A, 0x01, 0x08, 0x0F, 0x06, 0x0D, 0x00, 0x01, 0x04, 0x01, 0x00, 0x01,
+        0x04, 0x01, 0x00, 0x01, 0x04, 0x01, 0x00, 0x01, 0x04, 0x01, 0x00, 0x01, 0x04, 0x01, 0x00, 0x01,
+        0x04, 0x01, 0x00, 0x01, 0x04, 0x01, 0x00, 0x01, 0x91, 0x0C, 0x33, 0x00, 0x07, 0x0E, 0x05, 0x0C,
+        0x03, 0x0A, 0x01, 0x08, 0x0F, 0x06, 0x0D, 0x04, 0x0B, 0x02, 0x09, 0x00, 0x07, 0x0E, 0x05, 0x0C,
+        0x03, 0x0A, 0x01, 0x08, 0x0F, 0x06, 0x0D, 0x04, 0x0B, 0x02, 0x09, 0x00, 0x07, 0x0E, 0x05, 0x0C,
+        0x03, 0x0A, 0x01, 0x08, 0x0F, 0x06, 0x0D, 0x04, 0x0B, 0x02, 0x09, 0x00, 0x07, 0x0E, 0x05, 0x00
+    };
+
+    alignas(int) static constexpr uint8_t _huffman_data[] = {
+        0x28, 0x00, 0x01, 0x00, 0x0F, 0x00, 0x80, 0x01, 0x03, 0x81, 0x81, 0x02, 0x01, 0xC2, 0x0C, 0x82,
+        0x02, 0x03, 0x0E, 0x04, 0x00, 0xC2, 0xC2, 0xC3, 0xC3, 0xC4, 0x02, 0x08, 0x09, 0x0A, 0x0B, 0x0F,
+        0x05, 0x06, 0x07, 0x0D, 0x95, 0x21, 0x37, 0xAF, 0xAB, 0xEF, 0xF7, 0x7D, 0x86, 0xDC, 0xBC, 0x62,
+        0xBE, 0xDF, 0xF7, 0x55, 0x72, 0xF3, 0x8A, 0xAD, 0x7E, 0xDF, 0x57, 0x19, 0xCD, 0x2B, 0xB6, 0xFA,
+        0x7D, 0x5F, 0x65, 0xC8, 0x00, 0xD8, 0xEA, 0xFB, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00,
+        0x56, 0xDF, 0xEF, 0x00, 0x0C, 0xB9, 0x79, 0xC5, 0x7D, 0xBF, 0xEF, 0xAB, 0xE4, 0xE6, 0x15, 0x5B,
+        0xFD, 0xBE, 0xAF, 0x32, 0x9B, 0x57, 0x6C, 0xF5, 0xFB, 0xBE, 0xCA, 0x90, 0x3A, 0xA9, 0x4E, 0xFA,
+        0xAA, 0x93, 0xEA, 0xA4, 0xA4, 0x3A, 0xA9, 0x4E, 0x49, 0x92, 0x94, 0xEA, 0x24, 0x49, 0x92, 0x24,
+        0x90, 0x9B, 0x57, 0x92, 0xF7, 0xFB, 0xBE, 0xCA, 0x6E, 0x5E, 0xB1, 0xD5, 0xEF, 0xFB, 0x2A, 0x43,
+        0x79, 0xC5, 0x56, 0xDF, 0xEF, 0xAB, 0x0C, 0xB9, 0x15, 0x5B, 0x7D, 0xBF, 0x00, 0x00, 0xE0, 0xE6
+    };
+
+    alignas(int) static constexpr uint8_t _fast_lz_data[] = {
+        0x40, 0x00, 0x01, 0x00, 0x08, 0x15, 0x00, 0x07, 0x0E, 0x05, 0x0C, 0x03, 0x0A, 0x01, 0x08, 0x0F,
+        0x06, 0x0D, 0x04, 0x0B, 0x02, 0x09, 0x08, 0x00, 0x01, 0x10, 0x03, 0x03, 0x01, 0x00, 0x00, 0x16,
+        0x2F, 0x00, 0x02, 0x0A, 0x00, 0x01, 0x04, 0x01, 0x02, 0x00, 0x01, 0x06, 0x0C, 0x0C, 0x01, 0x00,
+        0x00, 0x17, 0x66, 0x00
+    };
+
+    static void _test(const uint8_t* compressed_data, bn::compression_type compression,
+                      void (*hw_decompress)(const void*, void*))
+    {
+        alignas(int) bytes_array hw_bytes = {};
+        hw_decompress(compressed_data, hw_bytes.data());
+        BN_ASSERT(hw_bytes == _uncompressed_bytes, "Invalid hw output: ", int(compression));
+
+        // Odd chunk sizes leave a pending byte between calls, since output is written with 16-bit stores:
+        constexpr bn::array<int, 4> max_bytes_list = { 1, 3, 64, _bytes_count };
+
+        for(int max_bytes : max_bytes_list)
+        {
+            alignas(int) bytes_array resumable_bytes = {};
+            bn::resumable_decompressor decompressor;
+            decompressor.start(compressed_data, compression);
+            BN_ASSERT(decompressor.remaining_bytes() == _bytes_count);
+
+            // Fast LZ data is made of half words, so it can write one more byte than requested:
+            int max_written_bytes = compression == bn::compression_type::FAST_LZ ? max_bytes + 1 : max_bytes;
+            int output_bytes = 0;
+
+            while(! decompressor.finished())
+            {
+                int written_bytes = decompressor.decompress(resumable_bytes.data(), max_bytes);
+                BN_ASSERT(written_bytes > 0 && written_bytes <= max_written_bytes,
+                          "Invalid written bytes: ", int(compression), " - ", written_bytes, " - ", max_bytes);
+
+                output_bytes += written_bytes;
+                BN_ASSERT(decompressor.remaining_bytes() == _bytes_count - output_bytes);
+            }
+
+            BN_ASSERT(output_bytes == _bytes_count);
+            BN_ASSERT(resumable_bytes == hw_bytes, "Invalid resumable output: ", int(compression), " - ", max_bytes);
+        }
+    }
+
+public:
+    decompression_tests() :
+        tests("decompression")
+    {
+        _test(_lz77_data, bn::compression_type::LZ77, bn::hw::decompress::lz77);
+        _test(_run_length_data, bn::compression_type::RUN_LENGTH, bn::hw::decompress::rl_wram);
+        _test(_huffman_data, bn::compression_type::HUFFMAN, bn::hw::decompress::huff);
+        _test(_fast_lz_data, bn::compression_type::FAST_LZ, bn::hw::decompress::fast_lz);
+    }
+};
+
+#endif
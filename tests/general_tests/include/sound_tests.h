@@ -0,0 +1,55 @@
+/*
+ * Copyright (c) 2020-2023 Gustavo Valiente gustavo.valiente@protonmail.com
+ * zlib License, see LICENSE file.
+ */
+
+#ifndef SOUND_TESTS_H
+#define SOUND_TESTS_H
+
+#include "bn_audio.h"
+#include "bn_sound.h"
+#include "bn_display.h"
+#include "bn_camera_ptr.h"
+#include "bn_sound_item.h"
+#include "bn_sound_handle.h"
+#include "tests.h"
+
+class sound_tests : public tests
+{
+
+public:
+    sound_tests() :
+        tests("sound")
+    {
+        BN_ASSERT(bn::sound::deduplication_frames() == 0);
+        BN_ASSERT(bn::sound::attenuation_distance() == bn::display::width());
+
+        bn::sound::set_deduplication_frames(4);
+        BN_ASSERT(bn::sound::deduplication_frames() == 4);
+
+        bn::sound::set_attenuation_distance(64);
+        BN_ASSERT(bn::sound::attenuation_distance() == 64);
+
+        // Sound effects which can't be heard are not played, so the sound item is never read
+        // and they are not counted as dropped:
+        bn::audio::reset_commands_counters();
+
+        int active_count = bn::sound::active_count();
+        bn::sound_item item(0);
+        BN_ASSERT(! item.play(0).active());
+
+        bn::camera_ptr camera = bn::camera_ptr::create(16, 16);
+        BN_ASSERT(! item.play(1, bn::fixed_point(16 + 64, 16), camera).active());
+        BN_ASSERT(! item.play(1, bn::fixed_point(16, 16 - 64), camera).active());
+        BN_ASSERT(! item.play_with_priority(1, 1, bn::fixed_point(16 - 100, 16 + 100), camera).active());
+
+        BN_ASSERT(bn::sound::active_count() == active_count);
+        BN_ASSERT(bn::audio::coalesced_commands_count() == 0);
+        BN_ASSERT(bn::audio::dropped_commands_count() == 0);
+
+        bn::sound::set_deduplication_frames(0);
+        bn::sound::set_attenuation_distance(bn::display::width());
+    }
+};
+
+#endif
@@ -0,0 +1,111 @@
+/*
+ * Copyright (c) 2020-2023 Gustavo Valiente gustavo.valiente@protonmail.com
+ * zlib License, see LICENSE file.
+ */
+
+#ifndef SPRITE_TILES_DELTA_TESTS_H
+#define SPRITE_TILES_DELTA_TESTS_H
+
+#include "bn_core.h"
+#include "bn_array.h"
+#include "bn_optional.h"
+#include "bn_sprite_tiles_ptr.h"
+#include "bn_config_sprite_tiles.h"
+#include "bn_sprite_tiles_delta_item.h"
+#include "tests.h"
+
+class sprite_tiles_delta_tests : public tests
+{
+
+private:
+    static constexpr int _tiles_count = 4;
+
+    // Every word of each tile is set to its index plus one, so tiles can be told apart:
+    static constexpr bn::array<bn::tile, 7> _tiles = []{
+        bn::array<bn::tile, 7> result = {};
+
+        for(int tile_index = 0; tile_index < 7; ++tile_index)
+        {
+            for(uint32_t& word : result[tile_index].data)
+            {
+                word = uint32_t(tile_index + 1);
+            }
+        }
+
+        return result;
+    }();
+
+    // Tile sets: [0, 1, 2, 3], [0, 4, 5, 3] and [6, 4, 5, 3].
+    // The runs of the first tile set are relative to the last one, so animations can be looped:
+    static constexpr bn::array<uint32_t, 3> _runs = {
+        0x00000300,     // 3 tiles starting at tile 0 from tiles_ref tile 0.
+        0x00040201,     // 2 tiles starting at tile 1 from tiles_ref tile 4.
+        0x00060100      // 1 tile starting at tile 0 from tiles_ref tile 6.
+    };
+
+    static constexpr bn::array<uint16_t, 4> _runs_indexes = { 0, 1, 2, 3 };
+
+    static constexpr bn::array<bn::array<int, _tiles_count>, 3> _graphics_tiles = {{
+        { 0, 1, 2, 3 },
+        { 0, 4, 5, 3 },
+        { 6, 4, 5, 3 }
+    }};
+
+    static constexpr bn::sprite_tiles_delta_item _delta_item = bn::sprite_tiles_delta_item(
+            _tiles, _runs, _runs_indexes, bn::bpp_mode::BPP_4, _tiles_count, 1);
+
+    static void _check_vram(bn::sprite_tiles_ptr& tiles, int graphics_index)
+    {
+        bn::optional<bn::span<bn::tile>> vram = tiles.vram();
+        BN_ASSERT(vram.has_value());
+        BN_ASSERT(vram->size() == _tiles_count, "Invalid VRAM tiles count: ", vram->size());
+
+        for(int tile_index = 0; tile_index < _tiles_count; ++tile_index)
+        {
+            const bn::tile& expected_tile = _tiles[_graphics_tiles[graphics_index][tile_index]];
+            const bn::tile& vram_tile = (*vram)[tile_index];
+
+            for(int word_index = 0; word_index < 8; ++word_index)
+            {
+                BN_ASSERT(vram_tile.data[word_index] == expected_tile.data[word_index],
+                          "Invalid tile: ", graphics_index, " - ", tile_index, " - ", word_index);
+            }
+        }
+    }
+
+public:
+    sprite_tiles_delta_tests() :
+        tests("sprite_tiles_delta")
+    {
+        BN_ASSERT(_delta_item.graphics_count() == 3);
+        BN_ASSERT(_delta_item.max_graphics_runs_count() == 1);
+        BN_ASSERT(_delta_item.graphics_runs_ref(1).size() == 1);
+
+        bn::sprite_tiles_ptr tiles = _delta_item.create_tiles();
+        bn::core::update();
+        _check_vram(tiles, 0);
+
+        // Only the changed tiles are uploaded:
+        int graphics_index = 0;
+
+        for(int index = 0; index < 3; ++index)
+        {
+            graphics_index = (graphics_index + 1) % 3;
+            tiles.apply_tiles_delta(_delta_item, graphics_index);
+            bn::core::update();
+            _check_vram(tiles, graphics_index);
+        }
+
+        // Pending runs are flushed in order instead of overflowing when too many of them are applied in one frame:
+        for(int index = 0; index <= BN_CFG_SPRITE_TILES_MAX_DELTA_RUNS; ++index)
+        {
+            graphics_index = (graphics_index + 1) % 3;
+            tiles.apply_tiles_delta(_delta_item, graphics_index);
+        }
+
+        bn::core::update();
+        _check_vram(tiles, graphics_index);
+    }
+};
+
+#endif
@@ -20,6 +20,13 @@
 #include "optional_tests.h"
 #include "any_tests.h"
 #include "format_tests.h"
+#include "decompression_tests.h"
+#include "bg_blocks_tests.h"
+#include "audio_commands_tests.h"
+#include "audio_mixing_tests.h"
+#include "sound_tests.h"
+#include "adpcm_tests.h"
+#include "sprite_tiles_delta_tests.h"
 #include "memory_tests.h"
 #include "sram_tests.h"
 
@@ -48,6 +55,13 @@ int main()
     optional_tests();
     any_tests();
     format_tests();
+    decompression_tests();
+    bg_blocks_tests();
+    audio_commands_tests();
+    audio_mixing_tests();
+    sound_tests();
+    adpcm_tests();
+    sprite_tiles_delta_tests();
     memory_tests memory_tests(used_stack_iwram);
     sram_tests sram_tests;
 
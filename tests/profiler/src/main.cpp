@@ -14,6 +14,7 @@
 #include "../../butano/hw/include/bn_hw_dma.h"
 #include "../../butano/hw/include/bn_hw_memory.h"
 #include "../../butano/hw/include/bn_hw_decompress.h"
+#include "../../butano/hw/3rd_party/cult-of-gba-bios/include/cult-of-gba-bios.h"
 
 #include "bn_regular_bg_items_butano_huge_rl.h"
 #include "bn_regular_bg_items_butano_huge_huff.h"
@@ -401,6 +402,12 @@ void rl_decomp_test()
 
     BN_PROFILER_STOP();
 
+    BN_PROFILER_START("rl_wram_cult");
+
+    swi_RLUnCompReadNormalWrite8bit(tiles, buffer);
+
+    BN_PROFILER_STOP();
+
     if(check_bios)
     {
         BN_PROFILER_START("rl_wram_bios");
@@ -416,6 +423,12 @@ void rl_decomp_test()
 
     BN_PROFILER_STOP();
 
+    BN_PROFILER_START("rl_vram_cult");
+
+    swi_RLUnCompReadNormalWrite16bit(tiles, buffer);
+
+    BN_PROFILER_STOP();
+
     if(check_bios)
     {
         BN_PROFILER_START("rl_vram_bios");